@@ -404,6 +404,11 @@ if ObjectList.is_kvm_cpu(TestCPUClass) or ObjectList.is_kvm_cpu(FutureClass):
     # Note: The simulator is quite picky about this number!
     root.sim_quantum = int(1e9)  # 1 ms
 
+if args.ruby and test_sys.ruby._lookahead is not None:
+    # Synchronize the partitions once per lookahead, so that messages
+    # between them are always delivered on time.
+    root.sim_quantum = test_sys.ruby._lookahead
+
 if args.timesync:
     root.time_sync_enable = True
 
@@ -0,0 +1,150 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""
+A microbenchmark of the host-side cost of a replacement policy.
+
+A random traffic generator hammers a single cache whose working set is a
+few times its size, so that almost every access either touches a block or
+evicts one. The script reports the host time spent per cache access, which
+should stay flat as the associativity grows if the policy's operations are
+constant time, e.g.:
+
+    for assoc in 8 16 32 64; do
+        build/X86/gem5.opt configs/example/repl_bench.py \\
+            --repl ARCRP --assoc $assoc
+    done
+"""
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, convert
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--repl",
+    default="ARCRP",
+    choices=ObjectList.repl_list.get_names(),
+    help="replacement policy of the cache",
+)
+parser.add_argument(
+    "--assoc", type=int, default=16, help="associativity of the cache"
+)
+parser.add_argument("--size", default="1MB", help="size of the cache")
+parser.add_argument(
+    "--footprint",
+    type=int,
+    default=4,
+    help="size of the working set, as a multiple of the cache size",
+)
+parser.add_argument(
+    "--accesses",
+    type=int,
+    default=1000000,
+    help="number of requests issued by the traffic generator",
+)
+
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+
+block_size = 64
+footprint = args.footprint * convert.toMemorySize(args.size)
+system.mem_ranges = [AddrRange(footprint)]
+system.cache_line_size = block_size
+
+# keep the cache and memory as cheap as possible, so that the host time is
+# dominated by the tags and the replacement policy
+system.tgen = PyTrafficGen()
+system.cache = Cache(
+    size=args.size,
+    assoc=args.assoc,
+    tag_latency=1,
+    data_latency=1,
+    response_latency=1,
+    mshrs=64,
+    tgts_per_mshr=8,
+    replacement_policy=ObjectList.repl_list.get(args.repl)(),
+)
+system.membus = SystemXBar()
+system.mem = SimpleMemory(
+    range=system.mem_ranges[0],
+    latency="1ns",
+    bandwidth="1000GiB/s",
+    null=True,
+)
+
+system.tgen.port = system.cache.cpu_side
+system.cache.mem_side = system.membus.cpu_side_ports
+system.mem.port = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+# one request per nanosecond
+period = 1000
+duration = args.accesses * period
+
+
+def trace():
+    yield system.tgen.createRandom(
+        duration, 0, footprint - 1, block_size, period, period, 100, 0
+    )
+    yield system.tgen.createExit(0)
+
+
+system.tgen.start(trace())
+
+start = time.time()
+m5.simulate()
+host_seconds = time.time() - start
+
+accesses = system.cache.resolveStat("demandAccesses").total
+print(
+    "%s, assoc %d: %d accesses in %.3f s, %.1f ns per access"
+    % (
+        args.repl,
+        args.assoc,
+        accesses,
+        host_seconds,
+        host_seconds * 1e9 / accesses,
+    )
+)
@@ -41,7 +41,7 @@ import math
 import m5
 from m5.objects import *
 from m5.defines import buildEnv
-from m5.util import addToPath, fatal
+from m5.util import addToPath, convert, fatal
 from gem5.isas import ISA
 from gem5.runtime import get_runtime_isa
 
@@ -119,6 +119,15 @@ def define_options(parser):
         help="Recycle latency for ruby controller input buffers",
     )
 
+    parser.add_argument(
+        "--ruby-partitions",
+        type=int,
+        default=1,
+        help="Number of event queues (host threads) to spread the CPUs "
+        "and their private caches over in full-system mode. The network, "
+        "shared caches, directories and devices stay on queue 0.",
+    )
+
     protocol = buildEnv["PROTOCOL"]
     exec("from . import %s" % protocol)
     eval("%s.define_options(parser)" % protocol)
@@ -281,10 +290,19 @@ def create_system(
 
     setup_memory_controllers(system, ruby, dir_cntrls, options)
 
+    ruby._lookahead = None
+    if getattr(options, "ruby_partitions", 1) > 1:
+        if not full_system:
+            fatal("--ruby-partitions requires full-system mode")
+        ruby._lookahead = partition_cpus(options, ruby, cpus, cpu_sequencers)
+
     # Connect the cpu sequencers and the piobus
     if piobus != None:
         for cpu_seq in cpu_sequencers:
-            cpu_seq.connectIOPorts(piobus)
+            if ruby._lookahead is None:
+                cpu_seq.connectIOPorts(piobus)
+            else:
+                connect_io_ports_across(cpu_seq, piobus, ruby._lookahead)
 
     ruby.number_of_virtual_networks = ruby.network.number_of_virtual_networks
     ruby._cpu_ports = cpu_sequencers
@@ -298,6 +316,73 @@ def create_system(
         )
 
 
+def partition_cpus(options, ruby, cpus, cpu_sequencers):
+    """Spread the CPUs over event queues 1 to N, one host thread each,
+    together with the controller that owns their sequencer. Everything else
+    stays on queue 0. Messages between the partitions go through message
+    buffers and are delivered deterministically at the end of each quantum,
+    so the quantum must not exceed the shortest latency between partitions.
+    Returns that lookahead in ticks.
+    """
+    local_cntrls = []
+    for i, (cpu, cpu_seq) in enumerate(zip(cpus, cpu_sequencers)):
+        cntrl = cpu_seq.get_parent()
+        if not isinstance(cntrl, RubyController):
+            fatal(
+                "Cannot partition %s: its sequencer does not belong to a "
+                "controller" % buildEnv["PROTOCOL"]
+            )
+        index = i % options.ruby_partitions + 1
+        cpu.eventq_index = index
+        cntrl.eventq_index = index
+        local_cntrls.append(cntrl)
+
+    # Messages from the network arrive after the latency of the external
+    # link (a single cycle through Garnet's network interfaces). Shorter
+    # latencies from the controllers to the network are caught when the
+    # messages are sent.
+    if options.network == "garnet":
+        cycles = 1
+    else:
+        cycles = min(
+            int(link.latency)
+            for link in ruby.network.ext_links
+            if any(link.ext_node is cntrl for cntrl in local_cntrls)
+        )
+
+    # Root.sim_quantum is in ticks. Like the KVM quantum in
+    # example/fs.py, this assumes the default 1 THz tick rate.
+    period = 1e12 / convert.toFrequency(options.ruby_clock)
+    return int(round(cycles * period))
+
+
+def connect_io_ports_across(cpu_seq, piobus, lookahead):
+    """Equivalent of RubySequencer.connectIOPorts() for a sequencer that
+    runs on another event queue than the piobus. Timing accesses cross over
+    through thread bridges, after one lookahead.
+    """
+    index = cpu_seq.get_parent().eventq_index
+    delay = "%dps" % lookahead
+
+    cpu_seq.pio_request_bridge = ThreadBridge(
+        eventq_index=0, in_eventq_index=index, delay=delay
+    )
+    cpu_seq.pio_request_port = cpu_seq.pio_request_bridge.in_port
+    cpu_seq.pio_request_bridge.out_port = piobus.cpu_side_ports
+
+    cpu_seq.mem_request_bridge = ThreadBridge(
+        eventq_index=0, in_eventq_index=index, delay=delay
+    )
+    cpu_seq.mem_request_port = cpu_seq.mem_request_bridge.in_port
+    cpu_seq.mem_request_bridge.out_port = piobus.cpu_side_ports
+
+    cpu_seq.pio_response_bridge = ThreadBridge(
+        eventq_index=index, in_eventq_index=0, delay=delay
+    )
+    piobus.mem_side_ports = cpu_seq.pio_response_bridge.in_port
+    cpu_seq.pio_response_bridge.out_port = cpu_seq.pio_response_port
+
+
 def create_directories(options, bootmem, ruby_system, system):
     dir_cntrl_nodes = []
     for i in range(options.num_dirs):
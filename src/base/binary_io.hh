@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Helpers to write and read plain values to and from binary streams, for
+ * state that is too large to be serialized as checkpoint ini entries.
+ *
+ * Values are stored with the representation of the host, so the data is
+ * only meant to be read back by a simulator built for the same host.
+ */
+
+#ifndef __BASE_BINARY_IO_HH__
+#define __BASE_BINARY_IO_HH__
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * Write an array of values to a binary stream.
+ *
+ * @param os The stream to write to.
+ * @param values The values to be written.
+ * @param count The number of values.
+ */
+template <typename T>
+void
+binaryOut(std::ostream &os, const T *values, std::size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only plain values can be written as binary data");
+    os.write(reinterpret_cast<const char *>(values), count * sizeof(T));
+}
+
+/**
+ * Write a value to a binary stream.
+ *
+ * @param os The stream to write to.
+ * @param value The value to be written.
+ */
+template <typename T>
+void
+binaryOut(std::ostream &os, const T &value)
+{
+    binaryOut(os, &value, 1);
+}
+
+/**
+ * Read an array of values from a binary stream. Running out of data is a
+ * fatal error, as it means that the data does not match its reader.
+ *
+ * @param is The stream to read from.
+ * @param values Where to store the values read.
+ * @param count The number of values.
+ */
+template <typename T>
+void
+binaryIn(std::istream &is, T *values, std::size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only plain values can be read as binary data");
+    is.read(reinterpret_cast<char *>(values), count * sizeof(T));
+    fatal_if(!is, "Unexpected end of binary data.");
+}
+
+/**
+ * Read a value from a binary stream.
+ *
+ * @param is The stream to read from.
+ * @param value Where to store the value read.
+ */
+template <typename T>
+void
+binaryIn(std::istream &is, T &value)
+{
+    binaryIn(is, &value, 1);
+}
+
+/**
+ * Read a value from a binary stream.
+ *
+ * @param is The stream to read from.
+ * @return The value read.
+ */
+template <typename T>
+T
+binaryIn(std::istream &is)
+{
+    T value;
+    binaryIn(is, value);
+    return value;
+}
+
+} // namespace gem5
+
+#endif // __BASE_BINARY_IO_HH__
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest-spi.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+
+#include "base/binary_io.hh"
+#include "base/gtest/logging.hh"
+
+using namespace gem5;
+
+/** Values of different sizes are read back in the order they were written. */
+TEST(BinaryIOTest, RoundTrip)
+{
+    struct Pair
+    {
+        uint32_t first;
+        uint16_t second;
+    };
+
+    std::ostringstream os;
+    binaryOut(os, uint8_t(0xAB));
+    binaryOut(os, uint64_t(0x0123456789ABCDEFULL));
+    binaryOut(os, Pair{7, 11});
+    binaryOut(os, true);
+
+    std::istringstream is(os.str());
+    ASSERT_EQ(binaryIn<uint8_t>(is), 0xAB);
+    ASSERT_EQ(binaryIn<uint64_t>(is), 0x0123456789ABCDEFULL);
+    const Pair pair = binaryIn<Pair>(is);
+    ASSERT_EQ(pair.first, 7);
+    ASSERT_EQ(pair.second, 11);
+    ASSERT_TRUE(binaryIn<bool>(is));
+    ASSERT_EQ(is.peek(), std::istringstream::traits_type::eof());
+}
+
+/** Arrays are written contiguously, and read back as a whole. */
+TEST(BinaryIOTest, Arrays)
+{
+    const uint16_t values[] = {1, 2, 3, 5, 8};
+
+    std::ostringstream os;
+    binaryOut(os, values, 5);
+    ASSERT_EQ(os.str().size(), sizeof(values));
+
+    uint16_t read[5];
+    std::istringstream is(os.str());
+    binaryIn(is, read, 5);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(read[i], values[i]);
+    }
+}
+
+/** Reading past the end of the data is an error. */
+TEST(BinaryIOTest, Truncated)
+{
+    std::ostringstream os;
+    binaryOut(os, uint16_t(1));
+
+    std::istringstream is(os.str());
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(binaryIn<uint32_t>(is));
+    ASSERT_NE(gtestLogOutput.str().find("Unexpected end of binary data"),
+              std::string::npos);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/block_pool.hh"
+
+#include <new>
+
+namespace gem5
+{
+
+namespace
+{
+
+constexpr std::size_t NumClasses =
+    BlockPool::MaxSize / BlockPool::Granularity;
+
+/** A free block, linked to the next free block of its class. */
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+/** The free lists of a thread, returned to the heap when it exits. */
+struct FreeLists
+{
+    FreeBlock *heads[NumClasses] = {};
+    std::size_t sizes[NumClasses] = {};
+
+    ~FreeLists();
+};
+
+thread_local FreeLists freeLists;
+
+/**
+ * Whether the free lists of this thread are gone. Blocks released after
+ * that, by the destructors of other thread-local or static objects, go
+ * straight back to the heap.
+ */
+thread_local bool freeListsDestroyed = false;
+
+FreeLists::~FreeLists()
+{
+    for (FreeBlock *&head : heads) {
+        while (head) {
+            FreeBlock *block = head;
+            head = block->next;
+            ::operator delete(block);
+        }
+    }
+    freeListsDestroyed = true;
+}
+
+/** Size class of a block; classes start at 1. */
+inline std::size_t
+sizeClass(std::size_t size)
+{
+    return (size + BlockPool::Granularity - 1) / BlockPool::Granularity;
+}
+
+} // anonymous namespace
+
+void *
+BlockPool::allocate(std::size_t size)
+{
+    const std::size_t size_class = sizeClass(size ? size : 1);
+    if (size_class > NumClasses) {
+        return ::operator new(size);
+    }
+    // Blocks may be released to another thread's lists, so even those
+    // allocated after this thread's lists are gone span the whole class.
+    if (freeListsDestroyed) {
+        return ::operator new(size_class * Granularity);
+    }
+
+    FreeBlock *&head = freeLists.heads[size_class - 1];
+    if (head) {
+        FreeBlock *block = head;
+        head = block->next;
+        freeLists.sizes[size_class - 1]--;
+        return block;
+    }
+    return ::operator new(size_class * Granularity);
+}
+
+void
+BlockPool::release(void *ptr, std::size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+    const std::size_t size_class = sizeClass(size ? size : 1);
+    if (size_class > NumClasses || freeListsDestroyed ||
+        freeLists.sizes[size_class - 1] >= MaxFree) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock *block = static_cast<FreeBlock*>(ptr);
+    FreeBlock *&head = freeLists.heads[size_class - 1];
+    block->next = head;
+    head = block;
+    freeLists.sizes[size_class - 1]++;
+}
+
+std::size_t
+BlockPool::numFree(std::size_t size)
+{
+    const std::size_t size_class = sizeClass(size ? size : 1);
+    if (size_class > NumClasses || freeListsDestroyed) {
+        return 0;
+    }
+    return freeLists.sizes[size_class - 1];
+}
+
+} // namespace gem5
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Recycling of small, short-lived objects, such as the events created
+ * once per instruction or message and the data of the compressors.
+ */
+
+#ifndef __BASE_BLOCK_POOL_HH__
+#define __BASE_BLOCK_POOL_HH__
+
+#include <cstddef>
+
+namespace gem5
+{
+
+/**
+ * Free lists of small memory blocks, grouped by size class.
+ *
+ * Released blocks are kept in a free list and handed out again, last in
+ * first out, to the next object of the same size class, instead of going
+ * through the heap each time. Larger objects bypass the pool.
+ *
+ * The free lists are per thread, so they need no locking. A block
+ * released by another thread than the one that allocated it, such as an
+ * event scheduled on the queue of another thread, joins the free lists
+ * of the releasing thread. As a thread that only releases blocks would
+ * then gather them without bound, every free list is capped, and the
+ * blocks released past the cap go back to the heap.
+ */
+class BlockPool
+{
+  public:
+    /** Granularity of the size classes, in bytes. */
+    static constexpr std::size_t Granularity = 16;
+
+    /** Size of the largest blocks pooled, in bytes. */
+    static constexpr std::size_t MaxSize = 256;
+
+    /** Number of free blocks a thread keeps in each size class. */
+    static constexpr std::size_t MaxFree = 1024;
+
+    /**
+     * Allocate a block.
+     *
+     * @param size Size of the block, in bytes.
+     * @return The block, suitably aligned for any object of its size.
+     */
+    static void *allocate(std::size_t size);
+
+    /**
+     * Release a block allocated by allocate(), on any thread.
+     *
+     * @param ptr The block; nothing is done if it is null.
+     * @param size The size the block was allocated with.
+     */
+    static void release(void *ptr, std::size_t size);
+
+    /**
+     * Number of free blocks the calling thread keeps for a size.
+     *
+     * @param size Size of the blocks, in bytes.
+     * @return The number of free blocks of its size class.
+     */
+    static std::size_t numFree(std::size_t size);
+};
+
+/**
+ * Base class of the objects allocated from the block pool. Derived
+ * classes must have a virtual destructor if they are deleted through a
+ * pointer to a base, so that the size of the block is known on release.
+ */
+class Pooled
+{
+  public:
+    static void *
+    operator new(std::size_t size)
+    {
+        return BlockPool::allocate(size);
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t size)
+    {
+        BlockPool::release(ptr, size);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_BLOCK_POOL_HH__
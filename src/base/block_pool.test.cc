@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "base/block_pool.hh"
+
+using namespace gem5;
+
+/** A released block is the next one handed out for its size class. */
+TEST(BlockPoolTest, ReusesLastReleased)
+{
+    void *first = BlockPool::allocate(40);
+    BlockPool::release(first, 40);
+    // 33 to 48 bytes share a size class
+    void *second = BlockPool::allocate(33);
+    EXPECT_EQ(second, first);
+    BlockPool::release(second, 33);
+}
+
+/** Blocks of different size classes are kept apart. */
+TEST(BlockPoolTest, SizeClasses)
+{
+    void *small = BlockPool::allocate(16);
+    const std::size_t free_small = BlockPool::numFree(16);
+    const std::size_t free_large = BlockPool::numFree(64);
+    BlockPool::release(small, 16);
+    EXPECT_EQ(BlockPool::numFree(16), free_small + 1);
+    EXPECT_EQ(BlockPool::numFree(64), free_large);
+
+    void *large = BlockPool::allocate(64);
+    EXPECT_NE(large, small);
+    BlockPool::release(large, 64);
+}
+
+/** Blocks larger than the largest size class are not kept. */
+TEST(BlockPoolTest, LargeBlocksBypass)
+{
+    const std::size_t size = BlockPool::MaxSize + 1;
+    void *block = BlockPool::allocate(size);
+    ASSERT_NE(block, nullptr);
+    BlockPool::release(block, size);
+    EXPECT_EQ(BlockPool::numFree(size), 0u);
+}
+
+/**
+ * A thread that only releases the blocks allocated by another thread
+ * keeps no more than the cap of free blocks.
+ */
+TEST(BlockPoolTest, CrossThreadReleaseIsCapped)
+{
+    const std::size_t size = 96;
+    const std::size_t num_blocks = 4 * BlockPool::MaxFree;
+
+    std::vector<void *> blocks;
+    std::thread producer([&]() {
+        for (std::size_t i = 0; i < num_blocks; i++) {
+            blocks.push_back(BlockPool::allocate(size));
+        }
+    });
+    producer.join();
+
+    std::size_t free_blocks = 0;
+    std::thread consumer([&]() {
+        for (void *block : blocks) {
+            BlockPool::release(block, size);
+        }
+        free_blocks = BlockPool::numFree(size);
+    });
+    consumer.join();
+
+    EXPECT_EQ(free_blocks, BlockPool::MaxFree);
+}
+
+namespace
+{
+
+/** Allocates from the pool while its thread exits. */
+struct LateAllocator
+{
+    void **block;
+    ~LateAllocator() { *block = BlockPool::allocate(20); }
+};
+
+} // anonymous namespace
+
+/** Blocks allocated during thread teardown still span their size class. */
+TEST(BlockPoolTest, LateBlocksSpanTheirClass)
+{
+    void *late_block = nullptr;
+    std::thread worker([&]() {
+        // Constructed before the free lists, so destroyed after them
+        thread_local LateAllocator late_allocator;
+        late_allocator.block = &late_block;
+        BlockPool::release(BlockPool::allocate(20), 20);
+    });
+    worker.join();
+    ASSERT_NE(late_block, nullptr);
+
+    // Once released here, the block is handed out for the whole class
+    BlockPool::release(late_block, 20);
+    void *block = BlockPool::allocate(BlockPool::Granularity * 2);
+    EXPECT_EQ(block, late_block);
+    std::memset(block, 0xff, BlockPool::Granularity * 2);
+    BlockPool::release(block, BlockPool::Granularity * 2);
+}
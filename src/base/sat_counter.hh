@@ -41,6 +41,7 @@
 #ifndef __BASE_SAT_COUNTER_HH__
 #define __BASE_SAT_COUNTER_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
@@ -291,6 +292,15 @@ class GenericSatCounter
      */
     void reset() { counter = initialVal; }
 
+    /**
+     * Set the counter to the given value, saturating it at the maximum.
+     *
+     * @param value The new value of the counter.
+     *
+     * @ingroup api_sat_counter
+     */
+    void set(T value) { counter = std::min(value, maxVal); }
+
     /**
      * Calculate saturation percentile of the current counter's value
      * with regard to its maximum possible value.
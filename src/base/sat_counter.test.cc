@@ -149,6 +149,26 @@ TEST(SatCounterTest, Saturate)
     ASSERT_TRUE(counter.isSaturated());
 }
 
+/**
+ * Test setting the value directly.
+ */
+TEST(SatCounterTest, Set)
+{
+    const unsigned bits = 3;
+    const unsigned max_value = (1 << bits) - 1;
+    SatCounter8 counter(bits, 1);
+
+    counter.set(5);
+    ASSERT_EQ(counter, 5);
+    counter.set(0);
+    ASSERT_EQ(counter, 0);
+
+    // Values beyond the maximum saturate the counter
+    counter.set(max_value + 3);
+    ASSERT_EQ(counter, max_value);
+    ASSERT_TRUE(counter.isSaturated());
+}
+
 /**
  * Test back and forth against an int.
  */
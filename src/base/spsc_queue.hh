@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_QUEUE_HH__
+#define __BASE_SPSC_QUEUE_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A bounded lock-free queue between exactly one producer thread and
+ * exactly one consumer thread.
+ *
+ * The producer only writes the tail index and the consumer only writes
+ * the head index, so each side needs a single release store to publish
+ * its progress and an acquire load to observe the other side. The
+ * indices increase without wrapping and are reduced to a slot with a
+ * mask, which is why the capacity is rounded up to a power of two. The
+ * two indices live on different cache lines so that the threads do not
+ * keep stealing each other's line.
+ *
+ * @tparam T The type of the elements. It must be default constructible
+ *           and copy assignable.
+ */
+template <typename T>
+class SPSCQueue
+{
+  private:
+    /** Size of a cache line on the host, to keep the indices apart. */
+    static constexpr std::size_t hostLineSize = 64;
+
+    std::vector<T> buffer;
+    const std::size_t mask;
+
+    /** Index of the next element to pop. Written by the consumer. */
+    alignas(hostLineSize) std::atomic<std::size_t> head;
+
+    /** Index of the next element to push. Written by the producer. */
+    alignas(hostLineSize) std::atomic<std::size_t> tail;
+
+  public:
+    /**
+     * @param capacity Minimum number of elements the queue can hold. It is
+     *                 rounded up to the next power of two.
+     */
+    explicit SPSCQueue(std::size_t capacity)
+      : buffer(capacity ? std::size_t(1) << ceilLog2(capacity) : 0),
+        mask(buffer.size() - 1),
+        head(0), tail(0)
+    {
+        fatal_if(capacity == 0, "An SPSCQueue needs at least one slot.");
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    /** Number of elements the queue can hold. */
+    std::size_t capacity() const { return buffer.size(); }
+
+    /**
+     * Append an element. Must only be called by the producer.
+     *
+     * @param item The element to append.
+     * @return Whether the element was appended, i.e. the queue was not full.
+     */
+    bool
+    tryPush(const T &item)
+    {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == buffer.size()) {
+            return false;
+        }
+        buffer[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest element. Must only be called by the consumer.
+     *
+     * @param item Where to copy the element.
+     * @return Whether an element was removed, i.e. the queue was not empty.
+     */
+    bool
+    tryPop(T &item)
+    {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = buffer[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Whether the queue is empty. The answer may be stale by the time it
+     * is used unless the other side is known to be idle.
+     */
+    bool
+    empty() const
+    {
+        return head.load(std::memory_order_acquire) ==
+            tail.load(std::memory_order_acquire);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_SPSC_QUEUE_HH__
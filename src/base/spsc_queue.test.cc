@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "base/gtest/logging.hh"
+#include "base/spsc_queue.hh"
+
+using namespace gem5;
+
+/** The capacity is rounded up to a power of two. */
+TEST(SPSCQueueTest, Capacity)
+{
+    EXPECT_EQ(SPSCQueue<int>(1).capacity(), 1u);
+    EXPECT_EQ(SPSCQueue<int>(8).capacity(), 8u);
+    EXPECT_EQ(SPSCQueue<int>(9).capacity(), 16u);
+}
+
+/** Elements come out in the order they went in, until the queue is full. */
+TEST(SPSCQueueTest, FifoOrder)
+{
+    SPSCQueue<int> queue(4);
+    EXPECT_TRUE(queue.empty());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_FALSE(queue.empty());
+
+    int item = -1;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.tryPop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(queue.tryPop(item));
+    EXPECT_TRUE(queue.empty());
+}
+
+/** The indices keep working once they have gone around the buffer. */
+TEST(SPSCQueueTest, WrapAround)
+{
+    SPSCQueue<int> queue(4);
+    int item = -1;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPush(i + 1000));
+        ASSERT_TRUE(queue.tryPop(item));
+        EXPECT_EQ(item, i);
+        ASSERT_TRUE(queue.tryPop(item));
+        EXPECT_EQ(item, i + 1000);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/** A producer and a consumer thread see the same sequence. */
+TEST(SPSCQueueTest, TwoThreads)
+{
+    constexpr uint64_t count = 1000000;
+    SPSCQueue<uint64_t> queue(64);
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < count; i++) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t item;
+    while (expected < count) {
+        if (queue.tryPop(item)) {
+            ASSERT_EQ(item, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+/** A queue without any slot is a configuration error. */
+TEST(SPSCQueueTest, ZeroCapacity)
+{
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(SPSCQueue<int> queue(0));
+    EXPECT_NE(gtestLogOutput.str().find("at least one slot"),
+              std::string::npos);
+}
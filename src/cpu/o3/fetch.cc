@@ -783,6 +783,12 @@ Fetch::checkStall(ThreadID tid) const
     return ret_val;
 }
 
+bool
+Fetch::backpressuredByDecode(ThreadID tid) const
+{
+    return stalls[tid].decode && fetchQueue[tid].size() >= fetchQueueSize;
+}
+
 Fetch::FetchStatus
 Fetch::updateFetchStatus()
 {
@@ -793,7 +799,12 @@ Fetch::updateFetchStatus()
     while (threads != end) {
         ThreadID tid = *threads++;
 
-        if (fetchStatus[tid] == Running ||
+        // A running thread that is backpressured by decode has no work
+        // of its own. Decode unblocking is activity in the later stages,
+        // which keeps the CPU ticking until fetch sees the signal, so the
+        // thread need not keep the CPU awake while, e.g., the ROB waits on
+        // a cache miss.
+        if ((fetchStatus[tid] == Running && !backpressuredByDecode(tid)) ||
             fetchStatus[tid] == Squashing ||
             fetchStatus[tid] == IcacheAccessComplete) {
 
@@ -926,6 +937,10 @@ Fetch::tick()
             tid_itr = activeThreads->begin();
     }
 
+    // Sending to decode, or decode stalling, may have changed whether
+    // any thread is backpressured.
+    _status = updateFetchStatus();
+
     // If there was activity this cycle, inform the CPU of it.
     if (wroteToTimeBuffer) {
         DPRINTF(Activity, "Activity this cycle.\n");
@@ -319,6 +319,13 @@ class Fetch
     /** Checks if a thread is stalled. */
     bool checkStall(ThreadID tid) const;
 
+    /**
+     * Checks if a thread is held up by decode: its fetch queue is full
+     * and decode has signalled a stall, so fetching cannot make progress
+     * until decode unblocks.
+     */
+    bool backpressuredByDecode(ThreadID tid) const;
+
     /** Updates overall fetch stage status; to be called at the end of each
      * cycle. */
     FetchStatus updateFetchStatus();
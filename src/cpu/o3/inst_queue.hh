@@ -102,7 +102,7 @@ class InstructionQueue
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
     /** FU completion event class. */
-    class FUCompletion : public Event
+    class FUCompletion : public PooledEvent<FUCompletion>
     {
       private:
         /** Executing instruction. */
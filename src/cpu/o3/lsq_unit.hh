@@ -408,7 +408,7 @@ class LSQUnit
     RequestPort *dcachePort;
 
     /** Writeback event, specifically for when stores forward data to loads. */
-    class WritebackEvent : public Event
+    class WritebackEvent : public PooledEvent<WritebackEvent>
     {
       public:
         /** Constructs a writeback event. */
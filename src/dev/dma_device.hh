@@ -313,8 +313,8 @@ class DmaCallback : public Drainable
     getChunkEvent()
     {
         ++count;
-        return new EventFunctionWrapper([this]{ chunkComplete(); }, name(),
-                                        true);
+        return new OneShotEvent([this]{ chunkComplete(); },
+                                "DmaCallback.chunk");
     }
 };
 
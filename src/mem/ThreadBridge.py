@@ -25,6 +25,7 @@
 
 from m5.SimObject import SimObject
 from m5.params import *
+from m5.proxy import *
 
 
 class ThreadBridge(SimObject):
@@ -39,14 +40,17 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses migrate to the receiver's EventQueue,
+    which is fast but not deterministic. Timing accesses are delivered to the
+    other side as events after a fixed delay instead, which keeps a parallel
+    simulation reproducible as long as the delay is at least one simulation
+    quantum. Both sides buffer without limit and handle retries locally.
 
     Example:
 
     sys.initator = Initiator(eventq_index=0)
     sys.target = Target(eventq_index=1)
-    sys.bridge = ThreadBridge(eventq_index=1)
+    sys.bridge = ThreadBridge(eventq_index=1, in_eventq_index=0)
 
     sys.initator.out_port = sys.bridge.in_port
     sys.bridge.out_port = sys.target.in_port
@@ -58,3 +62,12 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency(
+        "0ns",
+        "Delay of timing transactions in either direction, at least "
+        "the simulation quantum if the sides run on different threads",
+    )
+    in_eventq_index = Param.UInt32(
+        Parent.eventq_index, "Event queue of the in_port side"
+    )
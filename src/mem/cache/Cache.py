@@ -136,6 +136,24 @@ class BaseCache(ClockedObject):
         False, "Whether to access tags and data sequentially"
     )
 
+    # Send the responses to hits that do not involve an MSHR or the write
+    # buffer from a ring walked by a single event, bypassing the response
+    # queue while it is empty. This saves events for caches that mostly
+    # hit, such as L1 caches, without changing when each response is ready.
+    hit_fast_path = Param.Bool(
+        False, "Batch the responses to hits, bypassing the response queue"
+    )
+
+    # Save the blocks and the replacement state in checkpoints, and restore
+    # them, so that a restored cache starts warm, and dirty caches can be
+    # checkpointed without being drained with a writeback first. Both the
+    # caches that take and that restore the checkpoint must enable it.
+    serialize_contents = Param.Bool(
+        False,
+        "Save and restore the cache contents and replacement state in "
+        "checkpoints",
+    )
+
     cpu_side = ResponsePort("Upstream port closer to the CPU and/or device")
     mem_side = RequestPort("Downstream port closer to memory")
 
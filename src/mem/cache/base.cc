@@ -45,6 +45,13 @@
 
 #include "mem/cache/base.hh"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <sstream>
+
+#include "base/binary_io.hh"
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -72,6 +79,7 @@ BaseCache::CacheResponsePort::CacheResponsePort(const std::string &_name,
     : QueuedResponsePort(_name, _cache, queue),
       queue(*_cache, *this, true, _label),
       blocked(false), mustSendRetry(false),
+      hitResps(*_cache, *this, queue, _name + ".hitResps"),
       sendRetryEvent([this]{ processSendRetry(); }, _name)
 {
 }
@@ -91,6 +99,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
                                     name(), false,
                                     EventBase::Delayed_Writeback_Pri),
+      warmingUp(false), warmupPeer(nullptr),
       blkSize(blk_size),
       lookupLatency(p.tag_latency),
       dataLatency(p.data_latency),
@@ -98,6 +107,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       fillLatency(p.data_latency),
       responseLatency(p.response_latency),
       sequentialAccess(p.sequential_access),
+      hitFastPath(p.hit_fast_path),
+      checkpointContents(p.serialize_contents),
       numTarget(p.tgts_per_mshr),
       forwardSnoops(true),
       clusivity(p.clusivity),
@@ -195,6 +206,32 @@ BaseCache::init()
         fatal("Cache ports on %s are not connected\n", name());
     cpuSidePort.sendRangeChange();
     forwardSnoops = cpuSidePort.isSnooping();
+    warmingUp = system->warmsUpCaches();
+    warmupPeer = dynamic_cast<TagWarmupResponder*>(&memSidePort.getPeer());
+}
+
+void
+BaseCache::drainResume()
+{
+    if (system->warmsUpCaches() && !warmingUp) {
+        DPRINTF(Cache, "%s: entering warm-up mode\n", __func__);
+
+        // The block data is not kept up to date while warming up, so
+        // make sure memory holds the latest version of every line
+        memWriteback();
+
+        PacketList writebacks;
+        tags->forEachBlk([this, &writebacks](CacheBlk &blk) {
+            warmupEntryVisitor(blk, writebacks); });
+        doWritebacksAtomic(writebacks);
+        warmingUp = true;
+    } else if (!system->warmsUpCaches() && warmingUp) {
+        DPRINTF(Cache, "%s: leaving warm-up mode\n", __func__);
+
+        tags->forEachBlk([this](CacheBlk &blk) {
+            warmupRefillVisitor(blk); });
+        warmingUp = false;
+    }
 }
 
 Port &
@@ -288,7 +325,9 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
         // lat, neglecting responseLatency, modelling hit latency
         // just as the value of lat overriden by access(), which calls
         // the calculateAccessLatency() function.
-        cpuSidePort.schedTimingResp(pkt, request_time);
+        if (!hitFastPath || !tryHitFastPath(pkt, request_time)) {
+            cpuSidePort.schedTimingResp(pkt, request_time);
+        }
     } else {
         DPRINTF(Cache, "%s satisfied %s, no response needed\n", __func__,
                 pkt->print());
@@ -301,6 +340,22 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
     }
 }
 
+bool
+BaseCache::tryHitFastPath(PacketPtr pkt, Tick request_time)
+{
+    // Only responses that cannot be ordered with respect to the ones of
+    // an outstanding MSHR or write for the same block take the fast path
+    if (pkt->isLockedRMW()) {
+        return false;
+    }
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    if (mshrQueue.findMatch(blk_addr, pkt->isSecure()) ||
+        writeBuffer.findMatch(blk_addr, pkt->isSecure())) {
+        return false;
+    }
+    return cpuSidePort.trySchedHitResp(pkt, request_time);
+}
+
 void
 BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
                                Tick forward_time, Tick request_time)
@@ -709,6 +764,125 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+Tick
+BaseCache::recvAtomicWarmup(PacketPtr pkt)
+{
+    const Tick lat = lookupLatency * clockPeriod();
+
+    // Only the tags of the lines backed by the physical memory are
+    // modelled while warming up. Anything else, or anything that needs
+    // the data of the blocks, simply goes through. Memory is
+    // authoritative, so cleaning has nothing to do, but invalidations
+    // must reach the tags. Evictions are only sent when entering the
+    // warm-up, and must reach the snoop filters.
+    if (pkt->req->isUncacheable() || pkt->req->isCacheMaintenance() ||
+        pkt->cmd == MemCmd::InvalidateReq || pkt->cmd == MemCmd::WriteClean ||
+        pkt->isEviction() || !system->isMemAddr(pkt->getAddr())) {
+        if (pkt->isInvalidate()) {
+            CacheBlk *blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
+            if (blk) {
+                invalidateBlock(blk);
+            }
+        }
+        return lat + memSidePort.sendAtomic(pkt);
+    }
+
+    warmupAccess(pkt, pkt->fromCache());
+
+    // The levels below only see the tags of the line, so this is the
+    // one place where the access is performed
+    system->getPhysMem().access(pkt);
+
+    return lat;
+}
+
+void
+BaseCache::warmupAccess(const PacketPtr pkt, bool from_cache)
+{
+    CacheBlk *blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
+
+    if (blk) {
+        tags->touchBlock(blk, pkt);
+        ppHit->notify(pkt);
+
+        // The line moves to the cache above, as on a regular fill
+        if (from_cache && clusivity == enums::mostly_excl) {
+            invalidateBlock(blk);
+        }
+        return;
+    }
+
+    ppMiss->notify(pkt);
+
+    // The line is looked up below before a victim is chosen here, as it
+    // would be on a regular miss
+    if (warmupPeer) {
+        warmupPeer->recvWarmupAccess(pkt);
+    }
+
+    // Misses of the caches above only allocate in inclusive caches
+    if (clusivity == enums::mostly_incl ||
+        (!from_cache && allocOnFill(pkt->cmd))) {
+        warmupAllocate(pkt);
+    }
+}
+
+void
+BaseCache::warmupWriteback(const PacketPtr pkt)
+{
+    CacheBlk *blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
+
+    if (blk) {
+        tags->touchBlock(blk, pkt);
+    } else if (!warmupAllocate(pkt) && warmupPeer) {
+        // No room for the line here, so it goes further down
+        warmupPeer->recvWarmupWriteback(pkt);
+    }
+}
+
+CacheBlk*
+BaseCache::warmupAllocate(const PacketPtr pkt)
+{
+    // Compression is not modelled while warming up, all the blocks are
+    // fully sized
+    std::vector<CacheBlk*> evict_blks;
+    CacheBlk *victim = tags->findVictim(pkt->getAddr(), pkt->isSecure(),
+                                        blkSize * 8, evict_blks);
+    if (!victim)
+        return nullptr;
+
+    for (auto &blk : evict_blks) {
+        if (!blk->isValid())
+            continue;
+
+        if (writebackClean && warmupPeer) {
+            // The tags below only need the address of the line, and take
+            // their context from a packet, which is never sent
+            RequestPtr req = std::make_shared<Request>(
+                regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
+            if (blk->isSecure()) {
+                req->setFlags(Request::SECURE);
+            }
+            req->taskId(blk->getTaskId());
+
+            Packet wb_pkt(req, MemCmd::WritebackClean);
+            warmupPeer->recvWarmupWriteback(&wb_pkt);
+        }
+
+        invalidateBlock(blk);
+    }
+
+    tags->insertBlock(pkt, victim);
+    victim->setCoherenceBits(CacheBlk::ReadableBit);
+
+    if (compressor) {
+        compressor->setSizeBits(victim, blkSize * 8);
+        compressor->setDecompressionLatency(victim, Cycles(0));
+    }
+
+    return victim;
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -726,8 +900,9 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // needs to be found.  As a result we always update the request if
     // we have it, but only declare it satisfied if we are the owner.
 
-    // see if we have data at all (owned or otherwise)
-    bool have_data = blk && blk->isValid()
+    // see if we have data at all (owned or otherwise); while warming
+    // up only memory has the data
+    bool have_data = !warmingUp && blk && blk->isValid()
         && pkt->trySatisfyFunctional(&cbpw, blk_addr, is_secure, blkSize,
                                      blk->data);
 
@@ -1235,6 +1410,12 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                 "Should never see a write in a read-only cache %s\n",
                 name());
 
+    // Lookups to the sets that are not modeled may hit without a block
+    if (serveEstimatedHit(pkt, lat)) {
+        blk = nullptr;
+        return true;
+    }
+
     // Access block in the tags
     Cycles tag_latency(0);
     blk = tags->accessBlock(pkt, tag_latency);
@@ -1493,6 +1674,52 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     return false;
 }
 
+bool
+BaseCache::serveEstimatedHit(PacketPtr pkt, Cycles &lat)
+{
+    if (!tags->samplesSets()) {
+        return false;
+    }
+
+    // Anything that depends on the state of the block, or that must be
+    // ordered with an outstanding access to it, is looked up as usual
+    const bool plain = pkt->isEviction() ||
+        ((pkt->isRead() != pkt->isWrite()) && pkt->needsResponse());
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    if (!plain || pkt->req->isCacheMaintenance() || pkt->isLLSC() ||
+        pkt->isLockedRMW() || pkt->cacheResponding() ||
+        mshrQueue.findMatch(blk_addr, pkt->isSecure()) ||
+        writeBuffer.findMatch(blk_addr, pkt->isSecure()) ||
+        !tags->isEstimatedHit(pkt->getAddr())) {
+        return false;
+    }
+
+    DPRINTF(Cache, "%s for %s\n", __func__, pkt->print());
+
+    // The levels below hold the data of the lines of these sets. Clean
+    // evictions have nothing to write.
+    if (pkt->isRead() ||
+        (pkt->isWrite() && (pkt->cmd != MemCmd::WritebackClean))) {
+        Packet func_pkt(pkt, true, false);
+        func_pkt.cmd = pkt->isRead() ? MemCmd::ReadReq : MemCmd::WriteReq;
+        func_pkt.dataStatic(pkt->getPtr<uint8_t>());
+        memSidePort.sendFunctional(&func_pkt);
+    }
+
+    incHitCount(pkt);
+
+    // As for a hit on a block that is ready
+    if (pkt->isRead()) {
+        lat = ticksToCycles(pkt->headerDelay) + (sequentialAccess ?
+            lookupLatency + dataLatency :
+            std::max(lookupLatency, dataLatency));
+    } else {
+        lat = calculateTagOnlyLatency(pkt->headerDelay, lookupLatency);
+    }
+
+    return true;
+}
+
 void
 BaseCache::maintainClusivity(bool from_cache, CacheBlk *blk)
 {
@@ -1844,6 +2071,45 @@ BaseCache::invalidateVisitor(CacheBlk &blk)
     }
 }
 
+void
+BaseCache::warmupEntryVisitor(CacheBlk &blk, PacketList &writebacks)
+{
+    if (!blk.isValid())
+        return;
+
+    if (system->isMemAddr(regenerateBlkAddr(&blk))) {
+        // Writes do not invalidate the other copies while warming up
+        blk.clearCoherenceBits(CacheBlk::WritableBit);
+    } else {
+        // The line is clean after memWriteback(), and is evicted the
+        // regular way so that the snoop filters below let it go
+        evictBlock(&blk, writebacks);
+    }
+}
+
+void
+BaseCache::warmupRefillVisitor(CacheBlk &blk)
+{
+    if (!blk.isValid())
+        return;
+
+    assert(!blk.isSet(CacheBlk::DirtyBit));
+
+    const Addr addr = regenerateBlkAddr(&blk);
+    assert(system->isMemAddr(addr));
+
+    RequestPtr request = std::make_shared<Request>(
+        addr, blkSize, 0, Request::funcRequestorId);
+    if (blk.isSecure()) {
+        request->setFlags(Request::SECURE);
+    }
+
+    Packet packet(request, MemCmd::ReadReq);
+    packet.dataStatic(blk.data);
+
+    system->getPhysMem().functionalAccess(&packet);
+}
+
 Tick
 BaseCache::nextQueueReadyTime() const
 {
@@ -1988,6 +2254,130 @@ BaseCache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
     }
 }
 
+void
+BaseCache::serializeContents(std::ostream &os) const
+{
+    // The geometry of the cache, so that a checkpoint is only restored in
+    // a cache that can hold its blocks in the same places
+    uint64_t num_blocks = 0;
+    tags->forEachBlk([&num_blocks](CacheBlk &blk) { num_blocks++; });
+    binaryOut(os, num_blocks);
+    binaryOut(os, static_cast<uint32_t>(blkSize));
+    binaryOut(os, compressor != nullptr);
+    binaryOut(os, isDirty());
+
+    // Every block is written in the order of the tags, so that it is
+    // inserted again in the same entry
+    tags->forEachBlk([this, &os](CacheBlk &blk) {
+        binaryOut(os, blk.isValid());
+        if (!blk.isValid()) {
+            return;
+        }
+
+        binaryOut(os, tags->regenerateBlkAddr(&blk));
+        binaryOut(os, blk.isSecure());
+        binaryOut(os, blk.getSrcRequestorId());
+        binaryOut(os, blk.getTaskId());
+        blk.serializeState(os);
+        binaryOut(os, blk.data, blkSize);
+
+        if (compressor) {
+            const CompressionBlk *compression_blk =
+                static_cast<const CompressionBlk*>(&blk);
+            binaryOut(os, static_cast<uint64_t>(
+                compression_blk->getSizeBits()));
+            binaryOut(os, static_cast<uint64_t>(
+                compression_blk->getDecompressionLatency()));
+        }
+    });
+
+    // The replacement state is prefixed with its size, so that a restore
+    // can check that the policy consumed all of it
+    std::ostringstream replacement;
+    tags->serializeReplacement(replacement);
+    const std::string replacement_data = replacement.str();
+    binaryOut(os, static_cast<uint64_t>(replacement_data.size()));
+    os.write(replacement_data.data(), replacement_data.size());
+}
+
+void
+BaseCache::unserializeContents(std::istream &is)
+{
+    const uint64_t num_blocks = binaryIn<uint64_t>(is);
+    const uint32_t blk_size = binaryIn<uint32_t>(is);
+    const bool compressed = binaryIn<bool>(is);
+    const bool dirty = binaryIn<bool>(is);
+
+    uint64_t expected_blocks = 0;
+    tags->forEachBlk([&expected_blocks](CacheBlk &blk) {
+        expected_blocks++;
+    });
+    if ((num_blocks != expected_blocks) || (blk_size != blkSize) ||
+        (compressed != (compressor != nullptr))) {
+        fatal_if(dirty, "The checkpoint of %s holds dirty data, but it was "
+                 "taken with a different cache geometry.", name());
+        warn("The checkpoint of %s was taken with a different cache "
+             "geometry. The cache starts cold.", name());
+        return;
+    }
+
+    tags->forEachBlk([this, &is](CacheBlk &blk) {
+        if (!binaryIn<bool>(is)) {
+            return;
+        }
+
+        const Addr addr = binaryIn<Addr>(is);
+        const bool is_secure = binaryIn<bool>(is);
+        const uint32_t requestor_id = binaryIn<uint32_t>(is);
+        const uint32_t task_id = binaryIn<uint32_t>(is);
+        fatal_if(requestor_id >= system->maxRequestors(), "Checkpointed "
+                 "block %#x of %s belongs to unknown requestor %d.", addr,
+                 name(), requestor_id);
+
+        // Insert the block through the tags, so that they account for it
+        // as they would for a fill
+        RequestPtr req = std::make_shared<Request>(
+            addr, blkSize, 0, requestor_id);
+        if (is_secure) {
+            req->setFlags(Request::SECURE);
+        }
+        req->taskId(task_id);
+        Packet pkt(req, MemCmd::ReadReq);
+        tags->insertBlock(&pkt, &blk);
+        fatal_if(tags->regenerateBlkAddr(&blk) != addr, "Checkpointed "
+                 "block %#x cannot be placed in the same entry of %s.",
+                 addr, name());
+
+        blk.unserializeState(is);
+        binaryIn(is, blk.data, blkSize);
+
+        // This must be done after insertion, as for a fill
+        if (compressor) {
+            compressor->setSizeBits(&blk, binaryIn<uint64_t>(is));
+            compressor->setDecompressionLatency(&blk,
+                Cycles(binaryIn<uint64_t>(is)));
+        }
+    });
+
+    const uint64_t replacement_size = binaryIn<uint64_t>(is);
+    std::string replacement_data(replacement_size, '\0');
+    is.read(replacement_data.data(), replacement_size);
+    fatal_if(!is, "Unexpected end of the checkpoint of %s.", name());
+
+    if (!tags->replacementCheckpointable()) {
+        warn("The replacement policy of %s cannot be checkpointed. The "
+             "blocks are restored as if they had been inserted in order.",
+             name());
+        return;
+    }
+
+    std::istringstream replacement(replacement_data);
+    tags->unserializeReplacement(replacement);
+    fatal_if(replacement.peek() != std::istringstream::traits_type::eof(),
+             "The replacement state in the checkpoint of %s does not match "
+             "its replacement policy.", name());
+}
+
 void
 BaseCache::serialize(CheckpointOut &cp) const
 {
@@ -1996,16 +2386,53 @@ BaseCache::serialize(CheckpointOut &cp) const
     if (dirty) {
         warn("*** The cache still contains dirty data. ***\n");
         warn("    Make sure to drain the system using the correct flags.\n");
-        warn("    This checkpoint will not restore correctly " \
-             "and dirty data in the cache will be lost!\n");
+        if (checkpointContents) {
+            warn("    This checkpoint will only restore correctly in " \
+                 "caches that restore their contents!\n");
+        } else {
+            warn("    This checkpoint will not restore correctly " \
+                 "and dirty data in the cache will be lost!\n");
+        }
     }
 
-    // Since we don't checkpoint the data in the cache, any dirty data
-    // will be lost when restoring from a checkpoint of a system that
-    // wasn't drained properly. Flag the checkpoint as invalid if the
-    // cache contains dirty data.
+    // Any dirty data will be lost when restoring from a checkpoint of a
+    // system that wasn't drained properly, unless the contents of the
+    // cache are restored. Flag the checkpoint as invalid if the cache
+    // contains dirty data, so that it is only accepted along with the
+    // contents.
     bool bad_checkpoint(dirty);
     SERIALIZE_SCALAR(bad_checkpoint);
+
+    if (!checkpointContents) {
+        return;
+    }
+
+    std::ostringstream contents;
+    serializeContents(contents);
+    const std::string contents_data = contents.str();
+
+    std::string contents_file = name() + ".tags";
+    SERIALIZE_SCALAR(contents_file);
+
+    std::string filepath = CheckpointIn::dir() + "/" + contents_file;
+    gzFile compressed_contents = gzopen(filepath.c_str(), "wb");
+    fatal_if(compressed_contents == NULL,
+             "Can't open cache checkpoint file '%s'\n", contents_file);
+
+    // gzwrite fails if (int)len < 0 (gzwrite returns int)
+    uint64_t pass_size = 0;
+    for (uint64_t written = 0; written < contents_data.size();
+         written += pass_size) {
+        pass_size = std::min<uint64_t>(INT_MAX,
+                                       contents_data.size() - written);
+        fatal_if(gzwrite(compressed_contents, contents_data.data() + written,
+                         (unsigned int) pass_size) != (int) pass_size,
+                 "Write failed on cache checkpoint file '%s'\n",
+                 contents_file);
+    }
+
+    fatal_if(gzclose(compressed_contents),
+             "Close failed on cache checkpoint file '%s'\n", contents_file);
 }
 
 void
@@ -2013,11 +2440,45 @@ BaseCache::unserialize(CheckpointIn &cp)
 {
     bool bad_checkpoint;
     UNSERIALIZE_SCALAR(bad_checkpoint);
-    if (bad_checkpoint) {
-        fatal("Restoring from checkpoints with dirty caches is not "
-              "supported in the classic memory system. Please remove any "
-              "caches or drain them properly before taking checkpoints.\n");
+
+    // Checkpoints that do not hold the contents, or whose contents are
+    // not restored, leave the cache cold. That loses any dirty data.
+    std::string contents_file;
+    const bool has_contents = UNSERIALIZE_OPT_SCALAR(contents_file);
+    if (!has_contents || !checkpointContents) {
+        if (bad_checkpoint) {
+            fatal("Restoring from checkpoints with dirty caches is only "
+                  "supported in the classic memory system if the cache "
+                  "contents were saved and are restored (see "
+                  "serialize_contents). Please remove any caches or drain "
+                  "them properly before taking checkpoints.\n");
+        }
+        if (has_contents) {
+            warn("%s does not restore the contents saved in the "
+                 "checkpoint. The cache starts cold.", name());
+        }
+        return;
+    }
+
+    std::string filepath = cp.getCptDir() + "/" + contents_file;
+    gzFile compressed_contents = gzopen(filepath.c_str(), "rb");
+    fatal_if(compressed_contents == NULL,
+             "Can't open cache checkpoint file '%s'\n", contents_file);
+
+    std::string contents_data;
+    char chunk[16384];
+    int bytes_read;
+    while ((bytes_read = gzread(compressed_contents, chunk,
+                                sizeof(chunk))) > 0) {
+        contents_data.append(chunk, bytes_read);
     }
+    fatal_if(bytes_read < 0, "Read failed on cache checkpoint file '%s'\n",
+             contents_file);
+    fatal_if(gzclose(compressed_contents),
+             "Close failed on cache checkpoint file '%s'\n", contents_file);
+
+    std::istringstream contents(contents_data);
+    unserializeContents(contents);
 }
 
 
@@ -2570,6 +3031,8 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
     if (cache->system->bypassCaches()) {
         // Forward the request if the system is in cache bypass mode.
         return cache->memSidePort.sendAtomic(pkt);
+    } else if (cache->warmingUp) {
+        return cache->recvAtomicWarmup(pkt);
     } else {
         return cache->recvAtomic(pkt);
     }
@@ -2595,6 +3058,20 @@ BaseCache::CpuSidePort::getAddrRanges() const
     return cache->getAddrRanges();
 }
 
+void
+BaseCache::CpuSidePort::recvWarmupAccess(const PacketPtr pkt)
+{
+    assert(cache->warmingUp);
+    cache->warmupAccess(pkt, true);
+}
+
+void
+BaseCache::CpuSidePort::recvWarmupWriteback(const PacketPtr pkt)
+{
+    assert(cache->warmingUp);
+    cache->warmupWriteback(pkt);
+}
+
 
 BaseCache::
 CpuSidePort::CpuSidePort(const std::string &_name, BaseCache *_cache,
@@ -2692,6 +3169,23 @@ BaseCache::MemSidePort::MemSidePort(const std::string &_name,
 {
 }
 
+void
+BaseCache::MemSidePort::forEachHeldLine(const HeldLineVisitor &visitor)
+{
+    cache->tags->forEachBlk([this, &visitor](CacheBlk &blk) {
+        if (blk.isValid()) {
+            visitor(cache->regenerateBlkAddr(&blk), blk.isSecure());
+        }
+    });
+
+    // The caches above may hold lines that are not cached here
+    auto *above = dynamic_cast<HeldLinesReporter*>(
+        &cache->cpuSidePort.getPeer());
+    if (above) {
+        above->forEachHeldLine(visitor);
+    }
+}
+
 void
 WriteAllocator::updateMode(Addr write_addr, unsigned write_size,
                            Addr blk_addr)
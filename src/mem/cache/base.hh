@@ -48,7 +48,9 @@
 
 #include <cassert>
 #include <cstdint>
+#include <iosfwd>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/compiler.hh"
@@ -60,6 +62,7 @@
 #include "enums/Clusivity.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/compressors/base.hh"
+#include "mem/cache/hit_resp_batch.hh"
 #include "mem/cache/mshr_queue.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/write_queue.hh"
@@ -68,6 +71,7 @@
 #include "mem/packet_queue.hh"
 #include "mem/qport.hh"
 #include "mem/request.hh"
+#include "mem/tag_warmup.hh"
 #include "params/WriteAllocator.hh"
 #include "sim/clocked_object.hh"
 #include "sim/eventq.hh"
@@ -235,7 +239,7 @@ class BaseCache : public ClockedObject
      * The memory-side port extends the base cache request port with
      * access functions for functional, atomic and timing snoops.
      */
-    class MemSidePort : public CacheRequestPort
+    class MemSidePort : public CacheRequestPort, public HeldLinesReporter
     {
       private:
 
@@ -261,6 +265,8 @@ class BaseCache : public ClockedObject
 
         MemSidePort(const std::string &_name, BaseCache *_cache,
                     const std::string &_label);
+
+        void forEachHeldLine(const HeldLineVisitor &visitor) override;
     };
 
     /**
@@ -284,6 +290,30 @@ class BaseCache : public ClockedObject
 
         bool isBlocked() const { return blocked; }
 
+        /**
+         * Schedule the response to a hit in the batch of hit responses,
+         * bypassing the response queue.
+         *
+         * @sa HitRespBatch
+         * @param pkt The response.
+         * @param when The tick the response is ready.
+         * @return Whether the response was scheduled. If not, it must go
+         *         through the response queue.
+         */
+        bool trySchedHitResp(PacketPtr pkt, Tick when)
+        { return hitResps.trySchedule(pkt, when); }
+
+        /**
+         * Check the queued and the batched responses against the supplied
+         * functional request.
+         */
+        bool
+        trySatisfyFunctional(PacketPtr pkt)
+        {
+            return queue.trySatisfyFunctional(pkt) ||
+                hitResps.trySatisfyFunctional(pkt);
+        }
+
       protected:
 
         CacheResponsePort(const std::string &_name, BaseCache *_cache,
@@ -298,6 +328,9 @@ class BaseCache : public ClockedObject
 
       private:
 
+        /** Responses to hits that bypass the response queue. */
+        HitRespBatch hitResps;
+
         void processSendRetry();
 
         EventFunctionWrapper sendRetryEvent;
@@ -308,7 +341,7 @@ class BaseCache : public ClockedObject
      * The CPU-side port extends the base cache response port with access
      * functions for functional, atomic and timing requests.
      */
-    class CpuSidePort : public CacheResponsePort
+    class CpuSidePort : public CacheResponsePort, public TagWarmupResponder
     {
       private:
 
@@ -333,6 +366,10 @@ class BaseCache : public ClockedObject
         CpuSidePort(const std::string &_name, BaseCache *_cache,
                     const std::string &_label);
 
+        void recvWarmupAccess(const PacketPtr pkt) override;
+
+        void recvWarmupWriteback(const PacketPtr pkt) override;
+
     };
 
     CpuSidePort cpuSidePort;
@@ -491,6 +528,21 @@ class BaseCache : public ClockedObject
     virtual bool access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                         PacketList &writebacks);
 
+    /**
+     * Serve a request to a set that the tags do not model, if the tags
+     * estimate that it hits (see BaseTags::isEstimatedHit()). There is no
+     * block, so the data is read from, or written to, the levels below
+     * with a functional access, and the request takes the latency of a
+     * hit. Only plain reads, writes and evictions, with no outstanding
+     * access to their block, are served, so sampling is meant for the
+     * last-level cache, where nothing below needs to see them.
+     *
+     * @param pkt The memory request to perform.
+     * @param lat The latency of the access.
+     * @return Whether the request was served.
+     */
+    bool serveEstimatedHit(PacketPtr pkt, Cycles &lat);
+
     /*
      * Handle a timing request that hit in the cache
      *
@@ -501,6 +553,17 @@ class BaseCache : public ClockedObject
     virtual void handleTimingReqHit(PacketPtr pkt, CacheBlk *blk,
                                     Tick request_time);
 
+    /**
+     * Try to send the response to a timing request that hit in the cache
+     * through the hit fast path, batched with the other hit responses of
+     * the same tick.
+     *
+     * @param pkt The response packet
+     * @param request_time The tick at which the response is ready
+     * @return Whether the response took the fast path
+     */
+    bool tryHitFastPath(PacketPtr pkt, Tick request_time);
+
     /*
      * Handle a timing request that missed in the cache
      *
@@ -595,6 +658,51 @@ class BaseCache : public ClockedObject
      */
     virtual Tick recvAtomic(PacketPtr pkt);
 
+    /**
+     * Performs the access specified by the request while the caches are
+     * warming up. Only the tags, the replacement state and the
+     * prefetcher training are updated here and in the levels below (see
+     * warmupAccess()). Memory is authoritative in this mode, so the
+     * access itself is performed there directly, and only once.
+     * Requests the warm-up does not model (uncacheable, cache
+     * maintenance, evictions, or outside the physical memory) are
+     * forwarded as they are.
+     *
+     * @param pkt The request to perform.
+     * @return The number of ticks required for the access.
+     */
+    Tick recvAtomicWarmup(PacketPtr pkt);
+
+    /**
+     * Update the tags for an access while warming up. Hits update the
+     * replacement state, and misses are handed to the tags below before
+     * allocating according to the clusivity of the cache. No packet is
+     * sent and no cache statistic is updated, but the Hit/Miss probes
+     * are notified so that the prefetchers keep training.
+     *
+     * @param pkt The original request, only used as context.
+     * @param from_cache Whether the access is a miss of a cache above.
+     */
+    void warmupAccess(const PacketPtr pkt, bool from_cache);
+
+    /**
+     * Update the tags for a clean line evicted by a cache above while
+     * warming up, allocating it as a WritebackClean would.
+     *
+     * @param pkt A WritebackClean for the line, only used as context.
+     */
+    void warmupWriteback(const PacketPtr pkt);
+
+    /**
+     * Allocate a block for a line while warming up. Valid victims are
+     * handed to the level below if clean lines are written back, and
+     * are then dropped.
+     *
+     * @param pkt The packet of the line, only used as context.
+     * @return The allocated block, or nullptr if there is no victim.
+     */
+    CacheBlk *warmupAllocate(const PacketPtr pkt);
+
     /**
      * Snoop for the provided request in the cache and return the estimated
      * time taken.
@@ -702,6 +810,20 @@ class BaseCache : public ClockedObject
      */
     EventFunctionWrapper writebackTempBlockAtomicEvent;
 
+    /**
+     * Whether the cache is warming up, i.e., the system was in the
+     * atomic_warmup memory mode when the cache was last resumed. While
+     * warming up only the tags are kept up to date, and the data of the
+     * blocks is refilled from memory when leaving the mode.
+     */
+    bool warmingUp;
+
+    /**
+     * The tags below the memory-side port, if any, to which the misses
+     * and evictions are handed while warming up.
+     */
+    TagWarmupResponder *warmupPeer;
+
     /**
      * When a block is overwriten, its compression information must be updated,
      * and it may need to be recompressed. If the compression size changes, the
@@ -921,6 +1043,19 @@ class BaseCache : public ClockedObject
      */
     const bool sequentialAccess;
 
+    /**
+     * Whether the responses to hits that do not interact with an MSHR or
+     * the write buffer bypass the response queue while it is empty, and
+     * are batched across ready ticks (see HitRespBatch).
+     */
+    const bool hitFastPath;
+
+    /**
+     * Whether the contents of the cache are saved in checkpoints and
+     * restored from them.
+     */
+    const bool checkpointContents;
+
     /** The number of targets for each MSHR. */
     const int numTarget;
 
@@ -1155,6 +1290,8 @@ class BaseCache : public ClockedObject
 
     void init() override;
 
+    void drainResume() override;
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -1331,6 +1468,22 @@ class BaseCache : public ClockedObject
      */
     void invalidateVisitor(CacheBlk &blk);
 
+    /**
+     * Cache block visitor used when entering the warm-up mode. Only the
+     * lines backed by memory are tracked in that mode, so the others
+     * are evicted, and the rest lose their write permission.
+     *
+     * @param blk The block to visit.
+     * @param writebacks The evictions to send.
+     */
+    void warmupEntryVisitor(CacheBlk &blk, PacketList &writebacks);
+
+    /**
+     * Cache block visitor that reloads the data of a block from memory,
+     * used when leaving the warm-up mode.
+     */
+    void warmupRefillVisitor(CacheBlk &blk);
+
     /**
      * Take an MSHR, turn it into a suitable downstream packet, and
      * send it out. This construct allows a queue entry to choose a suitable
@@ -1351,10 +1504,31 @@ class BaseCache : public ClockedObject
      */
     bool sendWriteQueuePacket(WriteQueueEntry* wq_entry);
 
+    /**
+     * Write the blocks of the cache and the replacement state of its tags
+     * to a binary stream.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeContents(std::ostream &os) const;
+
+    /**
+     * Restore the contents written by serializeContents(), inserting the
+     * valid blocks again. A checkpoint of a cache with a different geometry
+     * is only accepted if it holds no dirty data, and leaves the cache
+     * cold.
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeContents(std::istream &is);
+
     /**
      * Serialize the state of the caches
      *
-     * We currently don't support checkpointing cache state, so this panics.
+     * The contents of the cache are written to a separate, compressed file
+     * of the checkpoint directory, if enabled. A cache that still holds
+     * dirty data flags the checkpoint, which is then only restored along
+     * with the contents.
      */
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
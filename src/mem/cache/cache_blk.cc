@@ -41,7 +41,9 @@
 
 #include "mem/cache/cache_blk.hh"
 
+#include "base/binary_io.hh"
 #include "base/cprintf.hh"
+#include "base/logging.hh"
 
 namespace gem5
 {
@@ -68,6 +70,29 @@ CacheBlk::insert(const Addr tag, const bool is_secure,
     increaseRefCount();
 }
 
+void
+CacheBlk::serializeState(std::ostream &os) const
+{
+    assert(isValid());
+    binaryOut(os, coherence);
+    binaryOut(os, _prefetched);
+    binaryOut(os, _refCount);
+    binaryOut(os, _tickInserted);
+}
+
+void
+CacheBlk::unserializeState(std::istream &is)
+{
+    assert(isValid());
+    binaryIn(is, coherence);
+    binaryIn(is, _prefetched);
+    binaryIn(is, _refCount);
+    binaryIn(is, _tickInserted);
+    fatal_if(_tickInserted > curTick(), "Checkpointed block was inserted "
+             "after the checkpoint was taken.");
+    setWhenReady(curTick());
+}
+
 void
 CacheBlkPrintWrapper::print(std::ostream &os, int verbosity,
                             const std::string &prefix) const
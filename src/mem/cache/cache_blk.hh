@@ -320,6 +320,23 @@ class CacheBlk : public TaggedEntry
         const int src_requestor_ID, const uint32_t task_ID);
     using TaggedEntry::insert;
 
+    /**
+     * Write the state a valid block gathered since its insertion to a
+     * binary stream: its coherence bits, prefetch status, reference count
+     * and insertion tick. The locks of load-locked requests are not kept.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeState(std::ostream &os) const;
+
+    /**
+     * Restore the state written by serializeState(). It is called after
+     * the block has been inserted again, and makes its data ready now.
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeState(std::istream &is);
+
     /**
      * Track the fact that a local locked was issued to the
      * block. Invalidate any previous LL to the same address.
@@ -38,6 +38,7 @@
 
 #include <cstdint>
 
+#include "base/block_pool.hh"
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
@@ -71,6 +72,19 @@ class Base : public SimObject
      */
     class CompressionData;
 
+    /** Outcome of the compression of a line of a batch. */
+    struct LineResult
+    {
+        /** Compressed size, in bits. */
+        std::size_t sizeBits;
+
+        /** Compression latency in number of cycles. */
+        Cycles compLat;
+
+        /** Decompression latency in number of cycles. */
+        Cycles decompLat;
+    };
+
   protected:
     /**
      * A chunk is a basic lexical unit. The data being compressed is received
@@ -129,6 +143,9 @@ class Base : public SimObject
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
+    /** Chunks of the line being compressed, kept to reuse their storage. */
+    std::vector<Chunk> chunkBuffer;
+
     struct BaseStats : public statistics::Group
     {
         const Base& compressor;
@@ -165,6 +182,14 @@ class Base : public SimObject
      */
     std::vector<Chunk> toChunks(const uint64_t* data) const;
 
+    /**
+     * Same as above, but reusing the storage of an existing vector.
+     *
+     * @param data The raw pointer to the data being compressed.
+     * @param chunks The vector to fill with the chunks of the data.
+     */
+    void toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const;
+
     /**
      * This function re-joins the chunks to recreate the original data.
      *
@@ -218,6 +243,20 @@ class Base : public SimObject
     std::unique_ptr<CompressionData>
     compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat);
 
+    /**
+     * Apply the compression process to a batch of consecutive cache lines,
+     * keeping only the outcome of each line. The statistics are updated as
+     * if every line had been compressed on its own, and the compressed data
+     * of a line is released before the next one is compressed, so that its
+     * storage is recycled.
+     *
+     * @param lines The cache lines to be compressed.
+     * @param num_lines Number of cache lines.
+     * @param results Outcome of the compression of every line.
+     */
+    void compressBatch(const uint64_t* lines, std::size_t num_lines,
+                       LineResult* results);
+
     /**
      * Get the decompression latency if the block is compressed. Latency is 0
      * otherwise.
@@ -243,7 +282,7 @@ class Base : public SimObject
     static void setSizeBits(CacheBlk* blk, const std::size_t size_bits);
 };
 
-class Base::CompressionData
+class Base::CompressionData : public Pooled
 {
   private:
     /**
@@ -107,6 +107,15 @@ class BaseDelta : public DictionaryCompressor<BaseType>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSizeBits(bytes, dict_bytes,
+            match_location);
+    }
+
     std::string
     getName(int number) const override
     {
@@ -121,6 +130,11 @@ class BaseDelta : public DictionaryCompressor<BaseType>
 
     void addToDictionary(DictionaryEntry data) override;
 
+    using CompData = typename DictionaryCompressor<BaseType>::CompData;
+
+    std::unique_ptr<CompData>
+    compressLine(const std::vector<Base::Chunk>& chunks) override;
+
     std::unique_ptr<Base::CompressionData> compress(
         const std::vector<Base::Chunk>& chunks,
         Cycles& comp_lat, Cycles& decomp_lat) override;
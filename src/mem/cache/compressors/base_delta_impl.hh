@@ -33,9 +33,11 @@
 #ifndef __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 #define __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 
+#include "base/bitfield.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/base_delta.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_scan.hh"
 
 namespace gem5
 {
@@ -70,6 +72,57 @@ BaseDelta<BaseType, DeltaSizeBits>::addToDictionary(DictionaryEntry data)
         DictionaryCompressor<BaseType>::numEntries++] = data;
 }
 
+template <class BaseType, std::size_t DeltaSizeBits>
+std::unique_ptr<typename BaseDelta<BaseType, DeltaSizeBits>::CompData>
+BaseDelta<BaseType, DeltaSizeBits>::compressLine(
+    const std::vector<Base::Chunk>& chunks)
+{
+    const std::size_t num_chunks = chunks.size();
+    if (num_chunks > line_scan::MaxChunks) {
+        return nullptr;
+    }
+
+    // A value matches the first base it is close to, and becomes a new base
+    // if there is none. Find the values close to the zero base, and then
+    // the ones close to the first value that is not, which is the only
+    // other base if the line can be compressed with two bases
+    constexpr unsigned value_bits = 8 * sizeof(BaseType);
+    const uint64_t all_chunks = mask(num_chunks);
+    const uint64_t near_zero = line_scan::withinDelta(chunks.data(),
+        num_chunks, 0, value_bits, DeltaSizeBits);
+    std::size_t base_location = num_chunks;
+    if (near_zero != all_chunks) {
+        base_location = findLsbSet(~near_zero & all_chunks);
+        const uint64_t near_base = line_scan::withinDelta(chunks.data(),
+            num_chunks, chunks[base_location], value_bits, DeltaSizeBits);
+
+        // More bases are needed; leave it to the value by value search
+        if ((near_zero | near_base) != all_chunks) {
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<CompData> comp_data =
+        DictionaryCompressor<BaseType>::instantiateDictionaryCompData();
+    comp_data->entries.reserve(num_chunks);
+    for (std::size_t i = 0; i < num_chunks; i++) {
+        const DictionaryEntry bytes =
+            DictionaryCompressor<BaseType>::toDictionaryEntry(chunks[i]);
+        std::unique_ptr<typename DictionaryCompressor<BaseType>::Pattern>
+            pattern;
+        if (bits(near_zero, i)) {
+            pattern.reset(new PatternM(bytes, 0));
+        } else if (i == base_location) {
+            pattern.reset(new PatternX(bytes, -1));
+        } else {
+            pattern.reset(new PatternM(bytes, 1));
+        }
+        DictionaryCompressor<BaseType>::addPattern(comp_data.get(), chunks[i],
+            std::move(pattern));
+    }
+    return comp_data;
+}
+
 template <class BaseType, std::size_t DeltaSizeBits>
 std::unique_ptr<Base::CompressionData>
 BaseDelta<BaseType, DeltaSizeBits>::compress(
@@ -168,6 +168,22 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Get the size of the pattern getPattern() would return, without
+         * allocating it.
+         */
+        static std::size_t getPatternSizeBits(
+            const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
+            const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return Head(bytes, match_location).getSizeBits();
+            } else {
+                return Factory<Tail...>::getPatternSizeBits(bytes, dict_bytes,
+                                                            match_location);
+            }
+        }
     };
 
     /**
@@ -189,6 +205,13 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static std::size_t
+        getPatternSizeBits(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            return Head(bytes, match_location).getSizeBits();
+        }
     };
 
     /** The dictionary. */
@@ -203,6 +226,20 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Get the size of the pattern that getPattern() would return. It is
+     * used to compare the dictionary entries when looking for the best
+     * match, so classes that inherit from this base class should implement
+     * it with their factory's getPatternSizeBits, which does not allocate
+     * the pattern.
+     */
+    virtual std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const
+    {
+        return getPattern(bytes, dict_bytes, match_location)->getSizeBits();
+    }
+
     /**
      * Compress data.
      *
@@ -211,6 +248,35 @@ class DictionaryCompressor : public BaseDictionaryCompressor
      */
     std::unique_ptr<Pattern> compressValue(const T data);
 
+    /**
+     * Choose the patterns of all the values of a line at once, instead of
+     * searching the dictionary value by value. Compressors whose patterns
+     * only depend on a few reference values can decide them from a vector
+     * scan of the line (see line_scan.hh); the patterns must be the same as
+     * the ones compressValue() would choose. The dictionary has been reset
+     * when this is called.
+     *
+     * @param chunks The line to be compressed.
+     * @return The compressed line, or nullptr to compress it value by value.
+     */
+    virtual std::unique_ptr<CompData>
+    compressLine(const std::vector<Chunk>& chunks)
+    {
+        return nullptr;
+    }
+
+    /**
+     * Add the pattern chosen by compressLine() for a value to the
+     * compressed line, updating the stats and the dictionary as
+     * compressValue() does.
+     *
+     * @param comp_data The compressed line.
+     * @param data The value.
+     * @param pattern The pattern chosen for the value.
+     */
+    void addPattern(CompData* comp_data, const T data,
+                    std::unique_ptr<Pattern> pattern);
+
     /**
      * Decompress a pattern into a value that fits in a dictionary entry.
      *
@@ -283,7 +349,7 @@ class DictionaryCompressor : public BaseDictionaryCompressor
  * declaration in crescent order of size (in the DictionaryCompressor class).
  */
 template <class T>
-class DictionaryCompressor<T>::Pattern
+class DictionaryCompressor<T>::Pattern : public Pooled
 {
   protected:
     /** Pattern enum number. */
@@ -97,24 +97,32 @@ DictionaryCompressor<T>::compressValue(const T data)
 {
     // Split data in bytes
     const DictionaryEntry bytes = toDictionaryEntry(data);
+    const DictionaryEntry zero = toDictionaryEntry(0);
 
     // Start as a no-match pattern. A negative match location is used so that
-    // patterns that depend on the dictionary entry don't match
-    std::unique_ptr<Pattern> pattern =
-        getPattern(bytes, toDictionaryEntry(0), -1);
+    // patterns that depend on the dictionary entry don't match. Only the
+    // sizes of the candidates are needed to find the best one, so the
+    // pattern is only built once the search is over
+    int match_location = -1;
+    std::size_t size_bits = getPatternSizeBits(bytes, zero, -1);
 
     // Search for word on dictionary
     for (std::size_t i = 0; i < numEntries; i++) {
         // Try matching input with possible patterns
-        std::unique_ptr<Pattern> temp_pattern =
-            getPattern(bytes, dictionary[i], i);
+        const std::size_t temp_size_bits =
+            getPatternSizeBits(bytes, dictionary[i], i);
 
         // Check if found pattern is better than previous
-        if (temp_pattern->getSizeBits() < pattern->getSizeBits()) {
-            pattern = std::move(temp_pattern);
+        if (temp_size_bits < size_bits) {
+            size_bits = temp_size_bits;
+            match_location = i;
         }
     }
 
+    std::unique_ptr<Pattern> pattern = getPattern(bytes,
+        (match_location < 0) ? zero : dictionary[match_location],
+        match_location);
+
     // Update stats
     dictionaryStats.patterns[pattern->getPatternNumber()]++;
 
@@ -126,18 +134,42 @@ DictionaryCompressor<T>::compressValue(const T data)
     return pattern;
 }
 
+template <class T>
+void
+DictionaryCompressor<T>::addPattern(CompData* comp_data, const T data,
+    std::unique_ptr<Pattern> pattern)
+{
+    // Update stats
+    dictionaryStats.patterns[pattern->getPatternNumber()]++;
+
+    // Push into dictionary
+    if (pattern->shouldAllocate()) {
+        addToDictionary(toDictionaryEntry(data));
+    }
+
+    DPRINTF(CacheComp, "Compressed %016x to %s\n", data, pattern->print());
+    comp_data->addEntry(std::move(pattern));
+}
+
 template <class T>
 std::unique_ptr<Base::CompressionData>
 DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks)
 {
-    std::unique_ptr<Base::CompressionData> comp_data =
-        instantiateDictionaryCompData();
-
     // Reset dictionary
     resetDictionary();
 
+    // Let the compressor choose all the patterns at once if it can
+    std::unique_ptr<CompData> line_comp_data = compressLine(chunks);
+    if (line_comp_data) {
+        return line_comp_data;
+    }
+
+    std::unique_ptr<Base::CompressionData> comp_data =
+        instantiateDictionaryCompData();
+
     // Compress every value sequentially
     CompData* const comp_data_ptr = static_cast<CompData*>(comp_data.get());
+    comp_data_ptr->entries.reserve(chunks.size());
     for (const auto& value : chunks) {
         std::unique_ptr<Pattern> pattern = compressValue(value);
         DPRINTF(CacheComp, "Compressed %016x to %s\n", value,
@@ -0,0 +1,877 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Offline compressibility profile of memory images, such as the backing
+ * stores of a checkpoint (the .pmem files written by PhysicalMemory).
+ *
+ * Every line of the images is compressed by each of the given cache
+ * compressors, using the same compressor classes as the simulator, and
+ * the distributions of compressed sizes, of compression factors as seen
+ * by CompressedTags, and of decompression latencies are reported. Lines
+ * are compressed in parallel.
+ *
+ * Usage:
+ *   compression_image_profile [options] <image file>...
+ *
+ *   --compressors=C1,C2,...  Compressors to evaluate, by SimObject name.
+ *                            Parameters are given as FPC:zero_run_bits=4.
+ *   --block-size=N           Block size in bytes (64).
+ *   --max-compression-ratio=N
+ *                            Maximum compression factor of a superblock,
+ *                            as in CompressedTags (2).
+ *   --size-bins=N            Number of compressed size bins (8).
+ *   --skip-zero              Do not count lines that are all zeros.
+ *   --threads=N              Number of worker threads.
+ *   --csv                    Print the results as CSV.
+ */
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/str.hh"
+#include "base/types.hh"
+#include "mem/cache/compressors/base.hh"
+#include "mem/cache/compressors/base_delta.hh"
+#include "mem/cache/compressors/cpack.hh"
+#include "mem/cache/compressors/fpc.hh"
+#include "mem/cache/compressors/fpcd.hh"
+#include "mem/cache/compressors/multi.hh"
+#include "mem/cache/compressors/perfect.hh"
+#include "mem/cache/compressors/repeated_qwords.hh"
+#include "mem/cache/compressors/zero.hh"
+#include "params/Base16Delta8.hh"
+#include "params/Base32Delta16.hh"
+#include "params/Base32Delta8.hh"
+#include "params/Base64Delta16.hh"
+#include "params/Base64Delta32.hh"
+#include "params/Base64Delta8.hh"
+#include "params/CPack.hh"
+#include "params/FPC.hh"
+#include "params/FPCD.hh"
+#include "params/MultiCompressor.hh"
+#include "params/PerfectCompressor.hh"
+#include "params/RepeatedQwordsCompressor.hh"
+#include "params/ZeroCompressor.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Parameters of a compressor, as given on the command line. */
+typedef std::map<std::string, std::string> CompressorArgs;
+
+/** Number of lines compressed by a worker at a time. */
+constexpr std::size_t BatchLines = 4096;
+
+/** Number of lines of an image read at a time. */
+constexpr std::size_t WindowLines = 1 << 20;
+
+/** Get a numeric compressor parameter, or its default value. */
+template <class T>
+T
+getArg(const CompressorArgs &args, const std::string &key, T default_value)
+{
+    auto it = args.find(key);
+    if (it == args.end()) {
+        return default_value;
+    }
+    T value;
+    if (!to_number(it->second, value)) {
+        fprintf(stderr, "Invalid value '%s' for parameter '%s'.\n",
+                it->second.c_str(), key.c_str());
+        std::exit(1);
+    }
+    return value;
+}
+
+/**
+ * Default values of the parameters shared by all compressors, as set in
+ * Compressors.py.
+ */
+struct Defaults
+{
+    /** Stands for a whole line of chunks processed per cycle. */
+    static constexpr unsigned WholeLine = UINT_MAX;
+
+    unsigned chunkSizeBits;
+    unsigned compChunksPerCycle;
+    unsigned compExtraLatency;
+    unsigned decompChunksPerCycle;
+    unsigned decompExtraLatency;
+    int sizeThresholdPercentage = 50;
+};
+
+/** The base-delta, zero and repeated values compressors' defaults. */
+Defaults
+oneCycleDefaults(unsigned chunk_size_bits)
+{
+    return Defaults{chunk_size_bits, Defaults::WholeLine, 0,
+                    Defaults::WholeLine, 0};
+}
+
+/** Set the parameters shared by all compressors. */
+void
+setBaseParams(BaseCacheCompressorParams &p, const std::string &name,
+              const Defaults &defaults, const CompressorArgs &args,
+              unsigned block_size)
+{
+    p.name = name;
+    p.eventq_index = 0;
+    p.block_size = block_size;
+    p.chunk_size_bits = getArg(args, "chunk_size_bits",
+                               defaults.chunkSizeBits);
+    p.size_threshold_percentage = getArg(args, "size_threshold_percentage",
+        defaults.sizeThresholdPercentage);
+
+    const unsigned chunks_per_line = (block_size * CHAR_BIT) /
+        std::max(1u, p.chunk_size_bits);
+    auto chunks_per_cycle = [chunks_per_line](unsigned value) {
+        return value == Defaults::WholeLine ? chunks_per_line : value;
+    };
+    p.comp_chunks_per_cycle = getArg(args, "comp_chunks_per_cycle",
+        chunks_per_cycle(defaults.compChunksPerCycle));
+    p.comp_extra_latency = Cycles(getArg(args, "comp_extra_latency",
+        uint64_t(defaults.compExtraLatency)));
+    p.decomp_chunks_per_cycle = getArg(args, "decomp_chunks_per_cycle",
+        chunks_per_cycle(defaults.decompChunksPerCycle));
+    p.decomp_extra_latency = Cycles(getArg(args, "decomp_extra_latency",
+        uint64_t(defaults.decompExtraLatency)));
+}
+
+/** Parameters of the compressors of an instance, kept alive with it. */
+typedef std::vector<std::shared_ptr<SimObjectParams>> ParamsList;
+
+/** How to build a compressor. */
+typedef std::function<compression::Base *(const std::string &name,
+    const CompressorArgs &args, unsigned block_size, ParamsList &params)>
+    CompressorFactory;
+
+/**
+ * Build a factory for a compressor whose parameters are set by a
+ * function, on top of the shared ones.
+ *
+ * @tparam Compressor The compressor class.
+ * @tparam Params Its parameter class.
+ */
+template <class Compressor, class Params>
+CompressorFactory
+factory(const Defaults &defaults,
+        std::function<void(Params&, const CompressorArgs&, unsigned,
+                           ParamsList&)> setup = nullptr)
+{
+    return [defaults, setup](const std::string &name,
+                             const CompressorArgs &args, unsigned block_size,
+                             ParamsList &params) {
+        auto p = std::make_shared<Params>();
+        setBaseParams(*p, name, defaults, args, block_size);
+        if (setup) {
+            setup(*p, args, block_size, params);
+        }
+        params.push_back(p);
+        compression::Base *compressor = new Compressor(*p);
+        compressor->regStats();
+        return compressor;
+    };
+}
+
+/** Set the dictionary size, which defaults to the line size. */
+template <class Params>
+std::function<void(Params&, const CompressorArgs&, unsigned, ParamsList&)>
+dictionary(int default_size = 0)
+{
+    return [default_size](Params &p, const CompressorArgs &args,
+                          unsigned block_size, ParamsList&) {
+        p.dictionary_size = getArg(args, "dictionary_size",
+            default_size ? default_size : int(block_size));
+    };
+}
+
+const std::map<std::string, CompressorFactory> &compressorFactories();
+
+/**
+ * Build a factory for a multi-compressor. The parameters given apply to
+ * the multi-compressor itself; its sub-compressors use their defaults,
+ * with the given size threshold.
+ */
+CompressorFactory
+multi(const std::vector<std::string> &sub_compressors,
+      int sub_size_threshold_percentage, unsigned decomp_extra_latency,
+      bool encoding_in_tags)
+{
+    Defaults defaults{32, 0, 1, 0, decomp_extra_latency};
+    return factory<compression::Multi, MultiCompressorParams>(defaults,
+        [=](MultiCompressorParams &p, const CompressorArgs &args,
+            unsigned block_size, ParamsList &params) {
+            p.encoding_in_tags = getArg(args, "encoding_in_tags",
+                                        int(encoding_in_tags)) != 0;
+            CompressorArgs sub_args;
+            if (sub_size_threshold_percentage) {
+                sub_args["size_threshold_percentage"] =
+                    std::to_string(sub_size_threshold_percentage);
+            }
+            for (std::size_t i = 0; i < sub_compressors.size(); i++) {
+                p.compressors.push_back(
+                    compressorFactories().at(sub_compressors[i])(
+                        p.name + ".compressors" + std::to_string(i),
+                        sub_args, block_size, params));
+            }
+        });
+}
+
+/**
+ * The compressors that can be evaluated. Parameters that are not given
+ * take the default values of the SimObjects. FrequentValuesCompressor is
+ * not supported, since it trains on the accesses of a simulation.
+ */
+const std::map<std::string, CompressorFactory> &
+compressorFactories()
+{
+    using namespace compression;
+
+    static const std::map<std::string, CompressorFactory> factories = {
+        {"Base64Delta8", factory<Base64Delta8, Base64Delta8Params>(
+            oneCycleDefaults(64), dictionary<Base64Delta8Params>())},
+        {"Base64Delta16", factory<Base64Delta16, Base64Delta16Params>(
+            oneCycleDefaults(64), dictionary<Base64Delta16Params>())},
+        {"Base64Delta32", factory<Base64Delta32, Base64Delta32Params>(
+            oneCycleDefaults(64), dictionary<Base64Delta32Params>())},
+        {"Base32Delta8", factory<Base32Delta8, Base32Delta8Params>(
+            oneCycleDefaults(32), dictionary<Base32Delta8Params>())},
+        {"Base32Delta16", factory<Base32Delta16, Base32Delta16Params>(
+            oneCycleDefaults(32), dictionary<Base32Delta16Params>())},
+        {"Base16Delta8", factory<Base16Delta8, Base16Delta8Params>(
+            oneCycleDefaults(16), dictionary<Base16Delta8Params>())},
+        {"BDI", multi({"ZeroCompressor", "RepeatedQwordsCompressor",
+                       "Base64Delta8", "Base64Delta16", "Base64Delta32",
+                       "Base32Delta8", "Base32Delta16", "Base16Delta8"},
+                      99, 0, true)},
+        {"CPack", factory<CPack, CPackParams>(Defaults{32, 2, 5, 2, 1},
+            dictionary<CPackParams>())},
+        {"FPC", factory<FPC, FPCParams>(Defaults{32, 8, 1, 4, 1},
+            [](FPCParams &p, const CompressorArgs &args, unsigned,
+               ParamsList&) {
+                p.dictionary_size = getArg(args, "dictionary_size", 1);
+                p.zero_run_bits = getArg(args, "zero_run_bits", 3);
+            })},
+        {"FPCD", factory<FPCD, FPCDParams>(Defaults{32, 4, 1, 4, 0},
+            dictionary<FPCDParams>(2))},
+        {"MultiCompressor", multi({"CPack", "FPCD"}, 0, 1, false)},
+        {"PerfectCompressor", factory<Perfect, PerfectCompressorParams>(
+            oneCycleDefaults(64),
+            [](PerfectCompressorParams &p, const CompressorArgs &args,
+               unsigned, ParamsList&) {
+                p.max_compression_ratio =
+                    getArg(args, "max_compression_ratio", 2);
+            })},
+        {"RepeatedQwordsCompressor",
+            factory<RepeatedQwords, RepeatedQwordsCompressorParams>(
+                oneCycleDefaults(64),
+                dictionary<RepeatedQwordsCompressorParams>())},
+        {"ZeroCompressor", factory<Zero, ZeroCompressorParams>(
+            oneCycleDefaults(64), dictionary<ZeroCompressorParams>())},
+    };
+    return factories;
+}
+
+/** A compressor to evaluate, as given on the command line. */
+struct CompressorSpec
+{
+    std::string label;
+    std::string type;
+    CompressorArgs args;
+};
+
+/** Parse a compressor such as FPC:zero_run_bits=4;dictionary_size=2. */
+CompressorSpec
+parseCompressor(const std::string &str)
+{
+    CompressorSpec spec;
+    spec.label = str;
+    const auto colon = str.find(':');
+    spec.type = str.substr(0, colon);
+    if (!compressorFactories().count(spec.type)) {
+        fprintf(stderr, "Unknown compressor '%s'. Known compressors:",
+                spec.type.c_str());
+        for (const auto &factory : compressorFactories()) {
+            fprintf(stderr, " %s", factory.first.c_str());
+        }
+        fprintf(stderr, "\n");
+        std::exit(1);
+    }
+
+    if (colon != std::string::npos) {
+        std::vector<std::string> args;
+        tokenize(args, str.substr(colon + 1), ';');
+        for (const auto &arg : args) {
+            const auto equal = arg.find('=');
+            if (equal == std::string::npos) {
+                fprintf(stderr, "Invalid compressor parameter '%s'.\n",
+                        arg.c_str());
+                std::exit(1);
+            }
+            spec.args[arg.substr(0, equal)] = arg.substr(equal + 1);
+        }
+    }
+    return spec;
+}
+
+/** A compressor together with the parameters it refers to. */
+struct CompressorInstance
+{
+    ParamsList params;
+    std::unique_ptr<compression::Base> compressor;
+};
+
+/** What the cache would see of the lines compressed by a compressor. */
+struct Profile
+{
+    /** Number of lines compressed. */
+    uint64_t lines = 0;
+
+    /** Sum of the compressed sizes, in bits. */
+    uint64_t sizeBits = 0;
+
+    /** Number of lines per compressed size bin. */
+    std::vector<uint64_t> sizeBins;
+
+    /** Number of lines per log2 of their compression factor. */
+    std::vector<uint64_t> factors;
+
+    /**
+     * Number of lines stored compressed, i.e., with a compression factor
+     * above 1, per decompression latency.
+     */
+    std::vector<uint64_t> decompLats;
+
+    /** Sum of the compression latencies. */
+    uint64_t compLats = 0;
+
+    Profile(unsigned size_bins, unsigned max_compression_ratio)
+      : sizeBins(size_bins, 0), factors(floorLog2(max_compression_ratio) + 1)
+    {
+    }
+
+    /** Account for the lines of a batch. */
+    void
+    add(const compression::Base::LineResult *results, std::size_t num_lines,
+        unsigned block_size, unsigned max_compression_ratio)
+    {
+        const std::size_t blk_size_bits = CHAR_BIT * block_size;
+        for (std::size_t i = 0; i < num_lines; i++) {
+            const auto &result = results[i];
+            lines++;
+            sizeBits += result.sizeBits;
+            compLats += result.compLat;
+            sizeBins[std::min<std::size_t>(sizeBins.size() - 1,
+                result.sizeBits * sizeBins.size() / blk_size_bits)]++;
+
+            // As SuperBlk::calculateCompressionFactor()
+            const std::size_t factor = std::min<std::size_t>(
+                max_compression_ratio,
+                (result.sizeBits > blk_size_bits) ? 1 :
+                ((result.sizeBits == 0) ? blk_size_bits :
+                alignToPowerOfTwo(blk_size_bits / result.sizeBits)));
+            factors[floorLog2(factor)]++;
+
+            // Only compressed blocks are decompressed on an access
+            if (factor != 1) {
+                if (result.decompLat >= decompLats.size()) {
+                    decompLats.resize(result.decompLat + 1, 0);
+                }
+                decompLats[result.decompLat]++;
+            }
+        }
+    }
+
+    void
+    merge(const Profile &other)
+    {
+        lines += other.lines;
+        sizeBits += other.sizeBits;
+        compLats += other.compLats;
+        for (std::size_t i = 0; i < sizeBins.size(); i++) {
+            sizeBins[i] += other.sizeBins[i];
+        }
+        for (std::size_t i = 0; i < factors.size(); i++) {
+            factors[i] += other.factors[i];
+        }
+        if (other.decompLats.size() > decompLats.size()) {
+            decompLats.resize(other.decompLats.size(), 0);
+        }
+        for (std::size_t i = 0; i < other.decompLats.size(); i++) {
+            decompLats[i] += other.decompLats[i];
+        }
+    }
+};
+
+/**
+ * Reads the lines of a memory image a window at a time. Uncompressed
+ * images are mapped, and gzip-compressed ones, as written by
+ * PhysicalMemory::serializeStore(), are inflated into two alternating
+ * buffers, so that a window stays valid while the next one is read.
+ */
+class ImageReader
+{
+  private:
+    const std::string filename;
+    const std::size_t lineSize;
+
+    gzFile gzipFile = nullptr;
+    std::vector<uint64_t> buffers[2];
+    unsigned nextBuffer = 0;
+
+    const uint8_t *mapping = nullptr;
+    std::size_t mappingSize = 0;
+    std::size_t offset = 0;
+
+  public:
+    ImageReader(const std::string &_filename, unsigned block_size)
+      : filename(_filename), lineSize(block_size)
+    {
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "Can't open memory image '%s'.\n",
+                    filename.c_str());
+            std::exit(1);
+        }
+
+        uint8_t magic[2] = {0, 0};
+        const bool gzipped = read(fd, magic, sizeof(magic)) ==
+            sizeof(magic) && magic[0] == 0x1f && magic[1] == 0x8b;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            fprintf(stderr, "Can't stat memory image '%s'.\n",
+                    filename.c_str());
+            std::exit(1);
+        }
+
+        if (gzipped) {
+            lseek(fd, 0, SEEK_SET);
+            gzipFile = gzdopen(fd, "rb");
+            if (!gzipFile) {
+                fprintf(stderr, "Can't read memory image '%s'.\n",
+                        filename.c_str());
+                std::exit(1);
+            }
+            gzbuffer(gzipFile, 1 << 20);
+            for (auto &buffer : buffers) {
+                buffer.resize(WindowLines * lineSize / sizeof(uint64_t));
+            }
+        } else {
+            mappingSize = st.st_size;
+            if (mappingSize) {
+                void *addr = mmap(nullptr, mappingSize, PROT_READ,
+                                  MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) {
+                    fprintf(stderr, "Can't map memory image '%s'.\n",
+                            filename.c_str());
+                    std::exit(1);
+                }
+                madvise(addr, mappingSize, MADV_SEQUENTIAL);
+                mapping = static_cast<const uint8_t *>(addr);
+            }
+            close(fd);
+        }
+    }
+
+    ~ImageReader()
+    {
+        if (gzipFile) {
+            gzclose(gzipFile);
+        }
+        if (mapping) {
+            munmap(const_cast<uint8_t *>(mapping), mappingSize);
+        }
+    }
+
+    /**
+     * Get the next window of lines. A trailing partial line is ignored.
+     *
+     * @param lines The first line of the window.
+     * @return The number of lines of the window, 0 at the end.
+     */
+    std::size_t
+    next(const uint64_t *&lines)
+    {
+        if (!gzipFile) {
+            const std::size_t num_lines = std::min(WindowLines,
+                (mappingSize - offset) / lineSize);
+            lines = reinterpret_cast<const uint64_t *>(mapping + offset);
+            offset += num_lines * lineSize;
+            return num_lines;
+        }
+
+        auto &buffer = buffers[nextBuffer];
+        nextBuffer ^= 1;
+        uint8_t *dest = reinterpret_cast<uint8_t *>(buffer.data());
+        const std::size_t window_size = WindowLines * lineSize;
+        std::size_t bytes = 0;
+        while (bytes < window_size) {
+            const int pass_size = gzread(gzipFile, dest + bytes,
+                std::min<std::size_t>(window_size - bytes, INT_MAX));
+            if (pass_size < 0) {
+                fprintf(stderr, "Read failed on memory image '%s'.\n",
+                        filename.c_str());
+                std::exit(1);
+            } else if (pass_size == 0) {
+                break;
+            }
+            bytes += pass_size;
+        }
+        lines = buffer.data();
+        return bytes / lineSize;
+    }
+};
+
+/** The compressors and results of a worker thread. */
+struct Worker
+{
+    std::vector<CompressorInstance> instances;
+    std::vector<Profile> profiles;
+    std::vector<uint64_t> lineBuffer;
+    std::vector<compression::Base::LineResult> results;
+    uint64_t zeroLines = 0;
+};
+
+/**
+ * Compress a batch of lines with every compressor of a worker.
+ *
+ * @param worker The worker.
+ * @param lines The lines.
+ * @param num_lines The number of lines.
+ * @param block_size Line size in bytes.
+ * @param max_compression_ratio Maximum compression factor.
+ * @param skip_zero Whether lines of zeros are left out.
+ */
+void
+runBatch(Worker &worker, const uint64_t *lines, std::size_t num_lines,
+         unsigned block_size, unsigned max_compression_ratio,
+         bool skip_zero)
+{
+    const std::size_t qwords_per_line = block_size / sizeof(uint64_t);
+    if (skip_zero) {
+        worker.lineBuffer.clear();
+        for (std::size_t i = 0; i < num_lines; i++) {
+            const uint64_t *line = lines + i * qwords_per_line;
+            if (std::all_of(line, line + qwords_per_line,
+                            [](uint64_t qword) { return qword == 0; })) {
+                worker.zeroLines++;
+            } else {
+                worker.lineBuffer.insert(worker.lineBuffer.end(), line,
+                                         line + qwords_per_line);
+            }
+        }
+        lines = worker.lineBuffer.data();
+        num_lines = worker.lineBuffer.size() / qwords_per_line;
+    }
+
+    worker.results.resize(num_lines);
+    for (std::size_t c = 0; c < worker.instances.size(); c++) {
+        worker.instances[c].compressor->compressBatch(lines, num_lines,
+            worker.results.data());
+        worker.profiles[c].add(worker.results.data(), num_lines, block_size,
+                               max_compression_ratio);
+    }
+}
+
+/** Print a histogram bucket. */
+void
+printBucket(bool csv, const std::string &label, const char *metric,
+            const std::string &bucket, uint64_t count, uint64_t total)
+{
+    const double fraction = total ? double(count) / total : 0.0;
+    if (csv) {
+        printf("%s,%s,%s,%llu,%.6f\n", label.c_str(), metric, bucket.c_str(),
+               (unsigned long long)count, fraction);
+    } else {
+        printf("    %-16s %14llu %10.6f\n", bucket.c_str(),
+               (unsigned long long)count, fraction);
+    }
+}
+
+void
+usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <image file>...\n"
+        "  --compressors=C1,C2,...  Compressors to evaluate (all). "
+        "Parameters\n"
+        "                           are given as "
+        "FPC:zero_run_bits=4;dictionary_size=2\n"
+        "  --block-size=N           Block size in bytes (64)\n"
+        "  --max-compression-ratio=N\n"
+        "                           Maximum compression factor of a "
+        "superblock (2)\n"
+        "  --size-bins=N            Number of compressed size bins (8)\n"
+        "  --skip-zero              Do not count lines that are all zeros\n"
+        "  --threads=N              Number of worker threads\n"
+        "  --csv                    Print the results as CSV\n", name);
+    std::exit(1);
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    std::vector<std::string> compressor_strs;
+    for (const auto &factory : compressorFactories()) {
+        compressor_strs.push_back(factory.first);
+    }
+    unsigned block_size = 64;
+    unsigned max_compression_ratio = 2;
+    unsigned size_bins = 8;
+    bool skip_zero = false;
+    unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+    bool csv = false;
+
+    static const struct option long_options[] = {
+        {"compressors", required_argument, nullptr, 'c'},
+        {"block-size", required_argument, nullptr, 'b'},
+        {"max-compression-ratio", required_argument, nullptr, 'm'},
+        {"size-bins", required_argument, nullptr, 's'},
+        {"skip-zero", no_argument, nullptr, 'z'},
+        {"threads", required_argument, nullptr, 't'},
+        {"csv", no_argument, nullptr, 'v'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", long_options, nullptr)) != -1) {
+        switch (opt) {
+          case 'c':
+            compressor_strs.clear();
+            tokenize(compressor_strs, optarg, ',');
+            break;
+          case 'b':
+            if (!to_number(optarg, block_size) || block_size == 0 ||
+                block_size % sizeof(uint64_t))
+                usage(argv[0]);
+            break;
+          case 'm':
+            if (!to_number(optarg, max_compression_ratio) ||
+                !isPowerOf2(max_compression_ratio))
+                usage(argv[0]);
+            break;
+          case 's':
+            if (!to_number(optarg, size_bins) || size_bins == 0)
+                usage(argv[0]);
+            break;
+          case 'z':
+            skip_zero = true;
+            break;
+          case 't':
+            if (!to_number(optarg, num_threads) || num_threads == 0)
+                usage(argv[0]);
+            break;
+          case 'v':
+            csv = true;
+            break;
+          default:
+            usage(argv[0]);
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+    }
+
+    std::vector<CompressorSpec> compressors;
+    for (const auto &str : compressor_strs) {
+        compressors.push_back(parseCompressor(str));
+    }
+
+    // Compressors keep state between lines, so every worker has its own
+    std::vector<Worker> workers(num_threads);
+    for (auto &worker : workers) {
+        for (const auto &spec : compressors) {
+            CompressorInstance instance;
+            instance.compressor.reset(
+                compressorFactories().at(spec.type)(spec.type, spec.args,
+                    block_size, instance.params));
+            worker.instances.push_back(std::move(instance));
+            worker.profiles.emplace_back(size_bins, max_compression_ratio);
+        }
+    }
+
+    const std::size_t qwords_per_line = block_size / sizeof(uint64_t);
+    for (int i = optind; i < argc; i++) {
+        ImageReader reader(argv[i], block_size);
+        const uint64_t *lines;
+        std::size_t num_lines = reader.next(lines);
+        while (num_lines) {
+            // Compress the window while the next one is read
+            const std::size_t num_batches =
+                (num_lines + BatchLines - 1) / BatchLines;
+            std::atomic<std::size_t> next_batch(0);
+            auto work = [&](Worker &worker) {
+                for (std::size_t b = next_batch++; b < num_batches;
+                     b = next_batch++) {
+                    const std::size_t first = b * BatchLines;
+                    runBatch(worker, lines + first * qwords_per_line,
+                             std::min(BatchLines, num_lines - first),
+                             block_size, max_compression_ratio, skip_zero);
+                }
+            };
+            std::vector<std::thread> threads;
+            for (auto &worker : workers) {
+                threads.emplace_back(work, std::ref(worker));
+            }
+
+            const uint64_t *next_lines;
+            const std::size_t next_num_lines = reader.next(next_lines);
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            lines = next_lines;
+            num_lines = next_num_lines;
+        }
+    }
+
+    uint64_t zero_lines = 0;
+    std::vector<Profile> profiles(compressors.size(),
+                                  Profile(size_bins, max_compression_ratio));
+    for (const auto &worker : workers) {
+        zero_lines += worker.zeroLines;
+        for (std::size_t c = 0; c < compressors.size(); c++) {
+            profiles[c].merge(worker.profiles[c]);
+        }
+    }
+
+    const std::size_t blk_size_bits = CHAR_BIT * block_size;
+    if (csv) {
+        printf("compressor,metric,bucket,lines,fraction\n");
+    } else if (skip_zero) {
+        printf("Lines of zeros skipped: %llu\n\n",
+               (unsigned long long)zero_lines);
+    }
+    for (std::size_t c = 0; c < compressors.size(); c++) {
+        const auto &label = compressors[c].label;
+        const Profile &profile = profiles[c];
+        const double mean_size = profile.lines ?
+            double(profile.sizeBits) / profile.lines / CHAR_BIT : 0.0;
+        const double ratio = profile.sizeBits ?
+            double(profile.lines * blk_size_bits) / profile.sizeBits : 0.0;
+        const double mean_comp_lat = profile.lines ?
+            double(profile.compLats) / profile.lines : 0.0;
+
+        uint64_t compressed_lines = 0;
+        double mean_factor = 0.0;
+        for (std::size_t i = 0; i < profile.factors.size(); i++) {
+            if (i) {
+                compressed_lines += profile.factors[i];
+            }
+            mean_factor += double(profile.factors[i]) * (1 << i);
+        }
+        mean_factor = profile.lines ? mean_factor / profile.lines : 0.0;
+
+        uint64_t decomp_lat_sum = 0;
+        for (std::size_t i = 0; i < profile.decompLats.size(); i++) {
+            decomp_lat_sum += i * profile.decompLats[i];
+        }
+        const double mean_decomp_lat = compressed_lines ?
+            double(decomp_lat_sum) / compressed_lines : 0.0;
+
+        if (csv) {
+            printf("%s,lines,,%llu,\n", label.c_str(),
+                   (unsigned long long)profile.lines);
+            printf("%s,compression_ratio,,,%.6f\n", label.c_str(), ratio);
+            printf("%s,mean_compression_factor,,,%.6f\n", label.c_str(),
+                   mean_factor);
+            printf("%s,mean_compression_latency,,,%.6f\n", label.c_str(),
+                   mean_comp_lat);
+            printf("%s,mean_decompression_latency,,,%.6f\n", label.c_str(),
+                   mean_decomp_lat);
+        } else {
+            printf("%s: %llu lines, mean compressed size %.2f B, "
+                   "compression ratio %.4f\n", label.c_str(),
+                   (unsigned long long)profile.lines, mean_size, ratio);
+            printf("  mean compression factor %.4f, mean compression "
+                   "latency %.2f cycles\n", mean_factor, mean_comp_lat);
+            printf("  compressed size (B)\n");
+        }
+        for (std::size_t i = 0; i < size_bins; i++) {
+            const double lo = double(i * block_size) / size_bins;
+            const double hi = double((i + 1) * block_size) / size_bins;
+            const char *format = csv ? "%g-%g" :
+                (i + 1 == size_bins ? "[%g, %g]" : "[%g, %g)");
+            printBucket(csv, label, "compressed_size",
+                        csprintf(format, lo, hi), profile.sizeBins[i],
+                        profile.lines);
+        }
+
+        if (!csv) {
+            printf("  compression factor\n");
+        }
+        for (std::size_t i = 0; i < profile.factors.size(); i++) {
+            printBucket(csv, label, "compression_factor",
+                        std::to_string(1 << i), profile.factors[i],
+                        profile.lines);
+        }
+
+        if (!csv) {
+            printf("  decompression latency (cycles) of the %llu lines "
+                   "stored compressed, mean %.2f\n",
+                   (unsigned long long)compressed_lines, mean_decomp_lat);
+        }
+        for (std::size_t i = 0; i < profile.decompLats.size(); i++) {
+            if (profile.decompLats[i]) {
+                printBucket(csv, label, "decompression_latency",
+                            std::to_string(i), profile.decompLats[i],
+                            compressed_lines);
+            }
+        }
+        if (!csv) {
+            printf("\n");
+        }
+    }
+
+    return 0;
+}
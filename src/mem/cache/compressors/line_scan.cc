@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/compressors/line_scan.hh"
+
+#include <cassert>
+#include <cstdint>
+
+#include "base/logging.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LINE_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define LINE_SCAN_X86 0
+#endif
+
+namespace gem5
+{
+
+namespace compression
+{
+
+namespace line_scan
+{
+
+namespace
+{
+
+/**
+ * All kernels use the same formulation of the delta check: a value v is
+ * within +/-limit of the base if (v - base + limit), wrapped to the width
+ * of the values, is at most 2 * limit. This turns the two signed bounds
+ * into a single unsigned comparison.
+ */
+typedef uint64_t (*Kernel)(const uint64_t *values, std::size_t n,
+                           uint64_t base, uint64_t width_mask,
+                           uint64_t limit);
+
+/** Mask of the lowest n bits of a 64-bit word. */
+inline uint64_t
+lowBits(std::size_t n)
+{
+    return n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+}
+
+uint64_t
+withinDeltaScalar(const uint64_t *values, std::size_t n, uint64_t base,
+                  uint64_t width_mask, uint64_t limit)
+{
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if (((values[i] - base + limit) & width_mask) <= 2 * limit) {
+            found |= uint64_t(1) << i;
+        }
+    }
+    return found;
+}
+
+#if LINE_SCAN_X86
+
+__attribute__((target("avx2")))
+uint64_t
+withinDeltaAVX2(const uint64_t *values, std::size_t n, uint64_t base,
+                uint64_t width_mask, uint64_t limit)
+{
+    // AVX2 has no unsigned 64-bit comparison, so flip the sign bits of
+    // both sides and compare them as signed values instead
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i b = _mm256_set1_epi64x(base);
+    const __m256i w = _mm256_set1_epi64x(width_mask);
+    const __m256i l = _mm256_set1_epi64x(limit);
+    const __m256i t = _mm256_xor_si256(_mm256_set1_epi64x(2 * limit), sign);
+    const __m256i lanes = _mm256_set_epi64x(3, 2, 1, 0);
+
+    uint64_t outside = 0;
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m256i valid =
+            _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - i), lanes);
+        const __m256i v = _mm256_maskload_epi64(
+            reinterpret_cast<const long long*>(values + i), valid);
+        const __m256i d = _mm256_and_si256(
+            _mm256_add_epi64(_mm256_sub_epi64(v, b), l), w);
+        const __m256i gt =
+            _mm256_cmpgt_epi64(_mm256_xor_si256(d, sign), t);
+        outside |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(gt)))
+            << i;
+    }
+    return ~outside & lowBits(n);
+}
+
+__attribute__((target("avx512f")))
+uint64_t
+withinDeltaAVX512(const uint64_t *values, std::size_t n, uint64_t base,
+                  uint64_t width_mask, uint64_t limit)
+{
+    const __m512i b = _mm512_set1_epi64(base);
+    const __m512i w = _mm512_set1_epi64(width_mask);
+    const __m512i l = _mm512_set1_epi64(limit);
+    const __m512i t = _mm512_set1_epi64(2 * limit);
+
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 valid = n - i >= 8 ? 0xff : (1 << (n - i)) - 1;
+        const __m512i v = _mm512_maskz_loadu_epi64(valid, values + i);
+        const __m512i d = _mm512_and_si512(
+            _mm512_add_epi64(_mm512_sub_epi64(v, b), l), w);
+        found |= uint64_t(_mm512_mask_cmple_epu64_mask(valid, d, t)) << i;
+    }
+    return found;
+}
+
+#endif // LINE_SCAN_X86
+
+Kernel
+kernel(Isa isa)
+{
+    switch (isa) {
+#if LINE_SCAN_X86
+      case Isa::AVX2:
+        return withinDeltaAVX2;
+      case Isa::AVX512:
+        return withinDeltaAVX512;
+#endif
+      default:
+        return withinDeltaScalar;
+    }
+}
+
+/** Kernel of the best instruction set, chosen on first use. */
+Kernel
+defaultKernel()
+{
+    static const Kernel best =
+        kernel(replacement_policy::victim_search::bestIsa());
+    return best;
+}
+
+uint64_t
+run(Kernel k, const uint64_t *values, std::size_t n, uint64_t base,
+    unsigned value_bits, unsigned delta_bits)
+{
+    assert(n <= MaxChunks);
+    assert(value_bits >= 1 && value_bits <= 64);
+    assert(delta_bits < value_bits);
+    const uint64_t width_mask = lowBits(value_bits);
+    const uint64_t limit = delta_bits ? lowBits(delta_bits - 1) : 0;
+    return k(values, n, base, width_mask, limit);
+}
+
+} // anonymous namespace
+
+uint64_t
+withinDelta(const uint64_t *values, std::size_t n, uint64_t base,
+            unsigned value_bits, unsigned delta_bits)
+{
+    return run(defaultKernel(), values, n, base, value_bits, delta_bits);
+}
+
+uint64_t
+withinDelta(const uint64_t *values, std::size_t n, uint64_t base,
+            unsigned value_bits, unsigned delta_bits, Isa isa)
+{
+    panic_if(!replacement_policy::victim_search::isaSupported(isa),
+             "Line scan ISA not supported.");
+    return run(kernel(isa), values, n, base, value_bits, delta_bits);
+}
+
+} // namespace line_scan
+} // namespace compression
+} // namespace gem5
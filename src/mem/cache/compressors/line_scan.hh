@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Vector kernels that classify the values of a cache line for the
+ * compressors.
+ *
+ * The compressors split a line into chunks, each held in a 64-bit word
+ * (see Base::toChunks()). Several of them decide how to encode a chunk by
+ * checking whether it is close to some reference value: equal to zero,
+ * equal to the first chunk, or within a small delta of a base. These
+ * kernels perform such a check on all the chunks of a line at once, using
+ * the widest vector instructions supported by the host, and return which
+ * chunks passed as a bitmask.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_LINE_SCAN_HH__
+#define __MEM_CACHE_COMPRESSORS_LINE_SCAN_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mem/cache/replacement_policies/victim_search.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+namespace line_scan
+{
+
+/** The kernels use the instruction sets of the victim search. */
+typedef replacement_policy::victim_search::Isa Isa;
+
+/** Maximum number of chunks that can be checked at once. */
+constexpr std::size_t MaxChunks = 64;
+
+/**
+ * Find the values that are within a delta of a base, with the semantics
+ * of DictionaryCompressor::DeltaPattern: the difference between a value
+ * and the base, computed with value_bits-wide wrap-around arithmetic,
+ * must be within +/-(2^(delta_bits-1) - 1). A delta of 0 bits checks for
+ * equality.
+ *
+ * @param values The values, one per 64-bit word, zero-extended.
+ * @param n Number of values, at most MaxChunks.
+ * @param base The base the values are compared against.
+ * @param value_bits Width of the values, in bits; 1 to 64.
+ * @param delta_bits Size of the delta, in bits; less than value_bits.
+ * @return A bitmask where bit i is set if values[i] is within the delta.
+ */
+uint64_t withinDelta(const uint64_t *values, std::size_t n, uint64_t base,
+                     unsigned value_bits, unsigned delta_bits);
+
+/**
+ * Variant of withinDelta() that uses the kernel of a given instruction
+ * set, which must be supported by the host.
+ */
+uint64_t withinDelta(const uint64_t *values, std::size_t n, uint64_t base,
+                     unsigned value_bits, unsigned delta_bits, Isa isa);
+
+/**
+ * Find the values that are equal to a given value.
+ *
+ * @param values The values.
+ * @param n Number of values, at most MaxChunks.
+ * @param value The value looked for.
+ * @return A bitmask where bit i is set if values[i] == value.
+ */
+inline uint64_t
+equalTo(const uint64_t *values, std::size_t n, uint64_t value)
+{
+    return withinDelta(values, n, value, 64, 0);
+}
+
+} // namespace line_scan
+} // namespace compression
+} // namespace gem5
+
+#endif // __MEM_CACHE_COMPRESSORS_LINE_SCAN_HH__
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "mem/cache/compressors/line_scan.hh"
+
+using namespace gem5;
+using compression::line_scan::Isa;
+using compression::line_scan::MaxChunks;
+using compression::line_scan::withinDelta;
+using replacement_policy::victim_search::isaSupported;
+
+namespace
+{
+
+/** All instruction sets the host can run. */
+std::vector<Isa>
+supportedIsas()
+{
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::Scalar, Isa::AVX2, Isa::AVX512}) {
+        if (isaSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/** The check of DictionaryCompressor::DeltaPattern::isValidDelta(). */
+template <class T>
+bool
+isValidDelta(T value, T base, unsigned delta_bits)
+{
+    const typename std::make_signed<T>::type limit = delta_bits ?
+        (uint64_t(1) << (delta_bits - 1)) - 1 : 0;
+    const typename std::make_signed<T>::type delta = value - base;
+    return (delta >= -limit) && (delta <= limit);
+}
+
+template <class T>
+void
+checkAgainstDeltaPattern(Isa isa, unsigned delta_bits, std::mt19937_64 &rng)
+{
+    for (std::size_t n = 0; n <= MaxChunks; n++) {
+        // Values around the base, and around zero, with some far away
+        std::vector<uint64_t> values(n);
+        const T base = rng();
+        for (auto &value : values) {
+            const T offset = int64_t(rng() % 512) - 256;
+            switch (rng() % 3) {
+              case 0: value = T(base + offset); break;
+              case 1: value = T(offset); break;
+              default: value = T(rng()); break;
+            }
+        }
+
+        uint64_t expected = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            if (isValidDelta<T>(values[i], base, delta_bits)) {
+                expected |= uint64_t(1) << i;
+            }
+        }
+        EXPECT_EQ(withinDelta(values.data(), n, base, 8 * sizeof(T),
+                              delta_bits, isa), expected)
+            << "isa " << int(isa) << " n " << n << " delta " << delta_bits;
+    }
+}
+
+} // anonymous namespace
+
+/** Every kernel agrees with the delta patterns of the BDI compressors. */
+TEST(LineScanTest, MatchesDeltaPattern)
+{
+    std::mt19937_64 rng(0);
+    for (Isa isa : supportedIsas()) {
+        for (unsigned delta_bits : {0, 1, 4, 8}) {
+            checkAgainstDeltaPattern<uint16_t>(isa, delta_bits, rng);
+        }
+        for (unsigned delta_bits : {0, 8, 16}) {
+            checkAgainstDeltaPattern<uint32_t>(isa, delta_bits, rng);
+        }
+        for (unsigned delta_bits : {0, 8, 16, 32}) {
+            checkAgainstDeltaPattern<uint64_t>(isa, delta_bits, rng);
+        }
+    }
+}
+
+/** The extreme deltas wrap around the width of the values. */
+TEST(LineScanTest, DeltaWrapsAround)
+{
+    for (Isa isa : supportedIsas()) {
+        // 0xff is -1 from 0x00 with 8-bit values, but not with 16-bit ones
+        const uint64_t values[] = {0x00, 0xff, 0x07, 0xf8, 0x08};
+        EXPECT_EQ(withinDelta(values, 5, 0x00, 8, 4, isa), 0b00111);
+        EXPECT_EQ(withinDelta(values, 5, 0x00, 16, 4, isa), 0b00101);
+        // Same with 64-bit values
+        const uint64_t wide[] = {0, ~uint64_t(0), uint64_t(1) << 63};
+        EXPECT_EQ(withinDelta(wide, 3, 0, 64, 2, isa), 0b011);
+        EXPECT_EQ(withinDelta(wide, 3, 0, 64, 0, isa), 0b001);
+    }
+}
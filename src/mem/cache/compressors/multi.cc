@@ -33,8 +33,9 @@
 
 #include "mem/cache/compressors/multi.hh"
 
+#include <algorithm>
 #include <cmath>
-#include <queue>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/logging.hh"
@@ -121,17 +122,20 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     };
     struct ResultsComparator
     {
+        const std::vector<Results>& results;
+
         bool
-        operator()(const std::shared_ptr<Results>& lhs,
-            const std::shared_ptr<Results>& rhs) const
+        operator()(unsigned lhs_index, unsigned rhs_index) const
         {
-            const std::size_t lhs_cf = lhs->compressionFactor;
-            const std::size_t rhs_cf = rhs->compressionFactor;
+            const Results& lhs = results[lhs_index];
+            const Results& rhs = results[rhs_index];
+            const std::size_t lhs_cf = lhs.compressionFactor;
+            const std::size_t rhs_cf = rhs.compressionFactor;
 
             if (lhs_cf == rhs_cf) {
                 // When they have similar compressed sizes, give the one
                 // with fastest decompression privilege
-                return lhs->decompLat > rhs->decompLat;
+                return lhs.decompLat > rhs.decompLat;
             }
             return lhs_cf < rhs_cf;
         }
@@ -143,9 +147,14 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     std::memset(data, 0, blkSize);
     fromChunks(chunks, data);
 
-    // Find the ranking of the compressor outputs
-    std::priority_queue<std::shared_ptr<Results>,
-        std::vector<std::shared_ptr<Results>>, ResultsComparator> results;
+    // Find the ranking of the compressor outputs. The results are ranked
+    // in a heap of indices, which orders them as a priority queue of the
+    // results would, without allocating every result on its own
+    std::vector<Results> results;
+    results.reserve(compressors.size());
+    std::vector<unsigned> ranking;
+    ranking.reserve(compressors.size());
+    const ResultsComparator comparator{results};
     Cycles max_comp_lat;
     for (unsigned i = 0; i < compressors.size(); i++) {
         Cycles temp_decomp_lat;
@@ -153,25 +162,29 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
             compressors[i]->compress(data, comp_lat, temp_decomp_lat);
         temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
             numEncodingBits);
-        results.push(std::make_shared<Results>(i, std::move(temp_comp_data),
-            temp_decomp_lat, blkSize));
+        results.emplace_back(i, std::move(temp_comp_data), temp_decomp_lat,
+            blkSize);
+        ranking.push_back(i);
+        std::push_heap(ranking.begin(), ranking.end(), comparator);
         max_comp_lat = std::max(max_comp_lat, comp_lat);
     }
 
     // Assign best compressor to compression data
-    const unsigned best_index = results.top()->index;
+    Results& best = results[ranking.front()];
+    const unsigned best_index = best.index;
     std::unique_ptr<CompressionData> multi_comp_data =
         std::unique_ptr<MultiCompData>(
-            new MultiCompData(best_index, std::move(results.top()->compData)));
+            new MultiCompData(best_index, std::move(best.compData)));
     DPRINTF(CacheComp, "Best compressor: %d\n", best_index);
 
     // Set decompression latency of the best compressor
-    decomp_lat = results.top()->decompLat + decompExtraLatency;
+    decomp_lat = best.decompLat + decompExtraLatency;
 
     // Update compressor ranking stats
     for (int rank = 0; rank < compressors.size(); rank++) {
-        multiStats.ranks[results.top()->index][rank]++;
-        results.pop();
+        multiStats.ranks[results[ranking.front()].index][rank]++;
+        std::pop_heap(ranking.begin(), ranking.end(), comparator);
+        ranking.pop_back();
     }
 
     // Set compression latency (compression latency of the slowest compressor
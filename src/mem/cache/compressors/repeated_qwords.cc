@@ -36,6 +36,7 @@
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_scan.hh"
 #include "params/RepeatedQwordsCompressor.hh"
 
 namespace gem5
@@ -57,6 +58,33 @@ RepeatedQwords::addToDictionary(DictionaryEntry data)
     dictionary[numEntries++] = data;
 }
 
+std::unique_ptr<RepeatedQwords::CompData>
+RepeatedQwords::compressLine(const std::vector<Chunk>& chunks)
+{
+    if (chunks.empty() || chunks.size() > line_scan::MaxChunks) {
+        return nullptr;
+    }
+
+    // The first qword is the only one that can be matched: it is the first
+    // entry of the dictionary, and any other entry is a new value
+    const uint64_t repeats =
+        line_scan::equalTo(chunks.data(), chunks.size(), chunks[0]);
+
+    std::unique_ptr<CompData> comp_data = instantiateDictionaryCompData();
+    comp_data->entries.reserve(chunks.size());
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        const DictionaryEntry bytes = toDictionaryEntry(chunks[i]);
+        std::unique_ptr<Pattern> pattern;
+        if (i > 0 && bits(repeats, i)) {
+            pattern.reset(new PatternM(bytes, 0));
+        } else {
+            pattern.reset(new PatternX(bytes, -1));
+        }
+        addPattern(comp_data.get(), chunks[i], std::move(pattern));
+    }
+    return comp_data;
+}
+
 std::unique_ptr<Base::CompressionData>
 RepeatedQwords::compress(const std::vector<Chunk>& chunks,
     Cycles& comp_lat, Cycles& decomp_lat)
@@ -36,6 +36,7 @@
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_scan.hh"
 #include "params/ZeroCompressor.hh"
 
 namespace gem5
@@ -57,6 +58,32 @@ Zero::addToDictionary(DictionaryEntry data)
     dictionary[numEntries++] = data;
 }
 
+std::unique_ptr<Zero::CompData>
+Zero::compressLine(const std::vector<Chunk>& chunks)
+{
+    if (chunks.size() > line_scan::MaxChunks) {
+        return nullptr;
+    }
+
+    // The patterns do not depend on the dictionary: every chunk is either
+    // zero or left uncompressed
+    const uint64_t zeros = line_scan::equalTo(chunks.data(), chunks.size(), 0);
+
+    std::unique_ptr<CompData> comp_data = instantiateDictionaryCompData();
+    comp_data->entries.reserve(chunks.size());
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        const DictionaryEntry bytes = toDictionaryEntry(chunks[i]);
+        std::unique_ptr<Pattern> pattern;
+        if (bits(zeros, i)) {
+            pattern.reset(new PatternZ(bytes, -1));
+        } else {
+            pattern.reset(new PatternX(bytes, -1));
+        }
+        addPattern(comp_data.get(), chunks[i], std::move(pattern));
+    }
+    return comp_data;
+}
+
 std::unique_ptr<Base::CompressionData>
 Zero::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     Cycles& decomp_lat)
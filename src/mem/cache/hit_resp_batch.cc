@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/hit_resp_batch.hh"
+
+#include <algorithm>
+
+#include "base/trace.hh"
+#include "debug/CachePort.hh"
+#include "debug/Drain.hh"
+#include "mem/packet_queue.hh"
+#include "mem/port.hh"
+
+namespace gem5
+{
+
+HitRespBatch::HitRespBatch(EventManager &_em, ResponsePort &_port,
+                           RespPacketQueue &_queue, const std::string &name)
+    : em(_em), port(_port), queue(_queue), entries(Capacity),
+      sendEvent([this]{ processSendEvent(); }, name)
+{
+}
+
+bool
+HitRespBatch::trySchedule(PacketPtr pkt, Tick when)
+{
+    // Bypassing the queue is only safe if there is nothing in it that the
+    // response could overtake
+    if (queue.size() != 0 || entries.full()) {
+        return false;
+    }
+
+    // As the queue, never send before the next tick, and do not make a
+    // response wait for a batched one that is ready later
+    when = std::max(when, curTick() + 1);
+    if (!entries.empty() && when < entries.back().ready) {
+        return false;
+    }
+
+    DPRINTF(CachePort, "%s: batching hit response for %s at %llu\n",
+            port.name(), pkt->print(), when);
+    entries.push_back(Entry{when, pkt});
+    if (!sendEvent.scheduled()) {
+        em.schedule(sendEvent, entries.front().ready);
+    }
+    return true;
+}
+
+void
+HitRespBatch::processSendEvent()
+{
+    // Sending a response may lead to new hits, which are batched behind
+    // the remaining responses and are never ready on this tick
+    while (!entries.empty() && entries.front().ready <= curTick()) {
+        // If the queue got packets that are due, or that wait for a
+        // retry, the remaining responses are sent after them
+        if (queue.deferredPacketReadyTime() <= curTick()) {
+            flushToQueue();
+            break;
+        }
+
+        PacketPtr pkt = entries.front().pkt;
+        entries.pop_front();
+        if (!port.sendTimingResp(pkt)) {
+            // Let the queue handle the retry the peer owes
+            queue.deferRefusedPacket(pkt);
+            flushToQueue();
+            break;
+        }
+    }
+
+    if (!entries.empty() && !sendEvent.scheduled()) {
+        em.schedule(sendEvent, entries.front().ready);
+    }
+
+    if (drainState() == DrainState::Draining && entries.empty()) {
+        DPRINTF(Drain, "%s: hit responses drained\n", port.name());
+        signalDrainDone();
+    }
+}
+
+void
+HitRespBatch::flushToQueue()
+{
+    for (const auto &entry : entries) {
+        queue.schedSendTiming(entry.pkt, std::max(entry.ready, curTick()));
+    }
+    entries.flush();
+}
+
+bool
+HitRespBatch::trySatisfyFunctional(PacketPtr pkt)
+{
+    for (const auto &entry : entries) {
+        if (pkt->trySatisfyFunctional(entry.pkt)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DrainState
+HitRespBatch::drain()
+{
+    return entries.empty() ? DrainState::Drained : DrainState::Draining;
+}
+
+} // namespace gem5
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a batch of hit responses that bypasses the response
+ * queue of a cache.
+ */
+
+#ifndef __MEM_CACHE_HIT_RESP_BATCH_HH__
+#define __MEM_CACHE_HIT_RESP_BATCH_HH__
+
+#include <cstddef>
+#include <string>
+
+#include "base/circular_queue.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "sim/drain.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+class RespPacketQueue;
+class ResponsePort;
+
+/**
+ * Responses to cache hits that are sent directly through the response
+ * port instead of through its packet queue.
+ *
+ * The responses are kept in a fixed-size ring, ordered by the tick they
+ * become ready, and a single event walks the ring from one ready tick to
+ * the next. Every response ready on the same tick is sent by the same
+ * event, and no list node is allocated per response. As from the packet
+ * queue, no response is sent before the next tick. A response that would
+ * be ready before the last batched one is not batched, so that responses
+ * are sent at the same ticks as from the queue, except that those ready
+ * on the same tick are not spread one tick apart.
+ *
+ * Responses are only batched while the packet queue is empty, so that
+ * they cannot overtake a queued packet. If the queue gets packets that
+ * become due while responses are batched, or if the peer refuses a
+ * response, the remaining responses are handed to the queue behind them.
+ */
+class HitRespBatch : public Drainable
+{
+  public:
+    /** Number of responses that can be batched at the same time. */
+    static constexpr std::size_t Capacity = 32;
+
+    /**
+     * @param em Event manager used to schedule the sends.
+     * @param port Port the responses are sent through.
+     * @param queue Packet queue of the port.
+     * @param name Name of the send event.
+     */
+    HitRespBatch(EventManager &em, ResponsePort &port,
+                 RespPacketQueue &queue, const std::string &name);
+
+    /**
+     * Schedule the response to a hit, bypassing the packet queue.
+     *
+     * @param pkt The response.
+     * @param when The tick the response is ready.
+     * @return Whether the response was batched. If not, it must go
+     *         through the packet queue.
+     */
+    bool trySchedule(PacketPtr pkt, Tick when);
+
+    /**
+     * Check the batched responses against the supplied functional
+     * request.
+     */
+    bool trySatisfyFunctional(PacketPtr pkt);
+
+    DrainState drain() override;
+
+  private:
+    /** A batched response and the tick it can be sent. */
+    struct Entry
+    {
+        Tick ready;
+        PacketPtr pkt;
+    };
+
+    EventManager &em;
+    ResponsePort &port;
+    RespPacketQueue &queue;
+
+    /** Batched responses, in scheduling order. */
+    CircularQueue<Entry> entries;
+
+    /** Send the responses that are ready and move to the next tick. */
+    void processSendEvent();
+
+    /** Hand every batched response over to the packet queue. */
+    void flushToQueue();
+
+    EventFunctionWrapper sendEvent;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_HIT_RESP_BATCH_HH__
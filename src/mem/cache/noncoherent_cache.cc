@@ -82,8 +82,10 @@ NoncoherentCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
 {
     bool success = BaseCache::access(pkt, blk, lat, writebacks);
 
-    if (pkt->isWriteback() || pkt->cmd == MemCmd::WriteClean) {
-        assert(blk && blk->isValid());
+    // Writebacks to the sets that the tags do not model are served
+    // without a block (see serveEstimatedHit())
+    if ((pkt->isWriteback() || pkt->cmd == MemCmd::WriteClean) && blk) {
+        assert(blk->isValid());
         // Writeback and WriteClean can allocate and fill even if the
         // referenced block was not present or it was invalid. If that
         // is the case, make sure that the new block is marked as
@@ -49,7 +49,8 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
     for (unsigned int entry_idx = 0; entry_idx < numEntries; entry_idx += 1) {
         Entry* entry = &entries[entry_idx];
         indexingPolicy->setEntry(entry, entry_idx);
-        entry->replacementData = replacementPolicy->instantiateEntry();
+        entry->replacementData = replacementPolicy->instantiateEntry(
+            entry->getSet(), entry->getWay());
     }
 }
 
@@ -75,7 +76,10 @@ template<class Entry>
 void
 AssociativeSet<Entry>::accessEntry(Entry *entry)
 {
-    replacementPolicy->touch(entry->replacementData);
+    replacementPolicy->touch(entry->replacementData,
+        replacement_policy::AccessContext(
+            indexingPolicy->regenerateAddr(entry->getTag(), entry),
+            entry->getTag(), entry->getSet()));
 }
 
 template<class Entry>
@@ -85,8 +89,10 @@ AssociativeSet<Entry>::findVictim(Addr addr)
     // Get possible entries to be victimized
     const std::vector<ReplaceableEntry*> selected_entries =
         indexingPolicy->getPossibleEntries(addr);
+    const replacement_policy::AccessContext ctx(addr,
+        indexingPolicy->extractTag(addr), selected_entries[0]->getSet());
     Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
-                            selected_entries));
+                            selected_entries, ctx));
     // There is only one eviction for this replacement
     invalidate(victim);
     return victim;
@@ -112,16 +118,22 @@ template<class Entry>
 void
 AssociativeSet<Entry>::insertEntry(Addr addr, bool is_secure, Entry* entry)
 {
-   entry->insert(indexingPolicy->extractTag(addr), is_secure);
-   replacementPolicy->reset(entry->replacementData);
+   const Addr tag = indexingPolicy->extractTag(addr);
+   entry->insert(tag, is_secure);
+   replacementPolicy->reset(entry->replacementData,
+       replacement_policy::AccessContext(addr, tag, entry->getSet()));
 }
 
 template<class Entry>
 void
 AssociativeSet<Entry>::invalidate(Entry* entry)
 {
+    // The entry loses its tag when invalidated
+    const replacement_policy::AccessContext ctx(
+        indexingPolicy->regenerateAddr(entry->getTag(), entry),
+        entry->getTag(), entry->getSet());
     entry->invalidate();
-    replacementPolicy->invalidate(entry->replacementData);
+    replacementPolicy->invalidate(entry->replacementData, ctx);
 }
 
 } // namespace gem5
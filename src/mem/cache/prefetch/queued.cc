@@ -37,9 +37,11 @@
 
 #include "mem/cache/prefetch/queued.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/tlb.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/HWPrefetch.hh"
@@ -55,11 +57,11 @@ GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
 namespace prefetch
 {
 
-void
-Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
-                                            RequestorID requestor_id,
-                                            bool tag_prefetch,
-                                            Tick t) {
+PacketPtr
+Queued::DeferredPacket::createPkt(unsigned blk_size,
+                                  RequestorID requestor_id,
+                                  bool tag_prefetch) const
+{
     /* Create a prefetch memory request */
     RequestPtr req = std::make_shared<Request>(paddr, blk_size,
                                                 0, requestor_id);
@@ -68,13 +70,13 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
         req->setFlags(Request::SECURE);
     }
     req->taskId(context_switch_task_id::Prefetcher);
-    pkt = new Packet(req, MemCmd::HardPFReq);
+    PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
     pkt->allocate();
     if (tag_prefetch && pfInfo.hasPC()) {
         // Tag prefetch packet with  accessing pc
         pkt->req->setPC(pfInfo.getPC());
     }
-    tick = t;
+    return pkt;
 }
 
 void
@@ -98,8 +100,135 @@ Queued::DeferredPacket::finish(const Fault &fault,
     owner->translationComplete(this, failed);
 }
 
+Queued::PrefetchQueue::PrefetchQueue(const std::string &_name,
+                                     unsigned capacity)
+  : ring(capacity, nullptr), head(0), count(0), name(_name)
+{
+}
+
+Queued::DeferredPacket *
+Queued::PrefetchQueue::lowestPriority() const
+{
+    assert(!empty());
+    unsigned pos = count - 1;
+    const int32_t priority = at(pos)->priority;
+    while (pos > 0 && at(pos - 1)->priority == priority) {
+        --pos;
+    }
+    return at(pos);
+}
+
+void
+Queued::PrefetchQueue::insert(DeferredPacket *dp)
+{
+    assert(!full());
+    unsigned pos = count;
+    while (pos > 0 && at(pos - 1)->priority < dp->priority) {
+        place(pos, at(pos - 1));
+        --pos;
+    }
+    place(pos, dp);
+    ++count;
+}
+
+void
+Queued::PrefetchQueue::erase(DeferredPacket *dp)
+{
+    unsigned pos = position(dp);
+    assert(pos < count && at(pos) == dp);
+
+    // Close the gap from whichever end of the ring is closer
+    if (pos < count / 2) {
+        for (; pos > 0; --pos) {
+            place(pos, at(pos - 1));
+        }
+        head = slotOf(1);
+    } else {
+        for (; pos + 1 < count; ++pos) {
+            place(pos, at(pos + 1));
+        }
+    }
+    --count;
+}
+
+void
+Queued::PrefetchQueue::promote(DeferredPacket *dp)
+{
+    unsigned pos = position(dp);
+    assert(pos < count && at(pos) == dp);
+    while (pos > 0 && at(pos - 1)->priority < dp->priority) {
+        place(pos, at(pos - 1));
+        --pos;
+    }
+    place(pos, dp);
+}
+
+Queued::AddressIndex::AddressIndex(unsigned num_entries)
+  : indexBits(ceilLog2(std::max(2 * num_entries, 2u)))
+{
+    buckets.resize(std::size_t(1) << indexBits, nullptr);
+}
+
+void
+Queued::AddressIndex::insert(DeferredPacket *dp)
+{
+    std::size_t bucket = home(dp);
+    while (buckets[bucket]) {
+        bucket = nextBucket(bucket);
+    }
+    buckets[bucket] = dp;
+}
+
+void
+Queued::AddressIndex::erase(DeferredPacket *dp)
+{
+    std::size_t hole = home(dp);
+    while (buckets[hole] != dp) {
+        assert(buckets[hole]);
+        hole = nextBucket(hole);
+    }
+
+    // Move back the following buckets of the probe sequence that cannot
+    // be reached from their home anymore
+    for (std::size_t next = nextBucket(hole); buckets[next];
+         next = nextBucket(next)) {
+        const std::size_t next_home = home(buckets[next]);
+        // The bucket can fill the hole if its home is not in (hole, next]
+        const bool reachable = hole <= next ?
+            (hole < next_home && next_home <= next) :
+            (hole < next_home || next_home <= next);
+        if (!reachable) {
+            buckets[hole] = buckets[next];
+            hole = next;
+        }
+    }
+    buckets[hole] = nullptr;
+}
+
+Queued::DeferredPacket *
+Queued::AddressIndex::find(Addr addr, bool is_secure,
+                           const PrefetchQueue *queue) const
+{
+    for (std::size_t bucket = home(addr, is_secure); buckets[bucket];
+         bucket = nextBucket(bucket)) {
+        DeferredPacket *dp = buckets[bucket];
+        if (dp->pfInfo.getAddr() == addr &&
+            dp->pfInfo.isSecure() == is_secure &&
+            (!queue || dp->queue == queue)) {
+            return dp;
+        }
+    }
+    return nullptr;
+}
+
 Queued::Queued(const QueuedPrefetcherParams &p)
-    : Base(p), queueSize(p.queue_size),
+    : Base(p),
+      pfq("PFQ", p.queue_size),
+      pfqMissingTranslation("PFTransQ",
+        p.max_prefetch_requests_with_pending_translation),
+      pfIndex(p.queue_size +
+        p.max_prefetch_requests_with_pending_translation),
+      queueSize(p.queue_size),
       missingTranslationQueueSize(
         p.max_prefetch_requests_with_pending_translation),
       latency(p.latency), queueSquash(p.queue_squash),
@@ -107,35 +236,64 @@ Queued::Queued(const QueuedPrefetcherParams &p)
       tagPrefetch(p.tag_prefetch),
       throttleControlPct(p.throttle_control_percentage), statsQueued(this)
 {
+    pool.resize(queueSize + missingTranslationQueueSize);
+    freePackets.reserve(pool.size());
+    for (unsigned i = pool.size(); i > 0; --i) {
+        freePackets.push_back(i - 1);
+    }
 }
 
 Queued::~Queued()
 {
-    // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
+}
+
+void
+Queued::printQueue(const PrefetchQueue &queue) const
+{
+    for (unsigned pos = 0; pos < queue.size(); pos++) {
+        const DeferredPacket *dp = queue.at(pos);
+        Addr vaddr = dp->pfInfo.getAddr();
+        /* paddr is 0 if not yet translated */
+        DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
+                "prio: %3d\n", queue.name, pos, vaddr, dp->paddr,
+                dp->priority);
+    }
+}
+
+Queued::DeferredPacket *
+Queued::allocatePacket(const PrefetchInfo &pfi, int32_t priority)
+{
+    if (freePackets.empty()) {
+        // Only packets dropped with a translation in flight are held
+        // outside of the queues, so the pool rarely needs to grow
+        freePackets.push_back(pool.size());
+        pool.emplace_back();
     }
+    const unsigned index = freePackets.back();
+    freePackets.pop_back();
+    return &pool[index].emplace(this, pfi, 0, priority, index);
 }
 
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::unlinkPacket(DeferredPacket *dp)
 {
-    int pos = 0;
-    std::string queue_name = "";
-    if (&queue == &pfq) {
-        queue_name = "PFQ";
-    } else {
-        assert(&queue == &pfqMissingTranslation);
-        queue_name = "PFTransQ";
+    if (dp->queue) {
+        dp->queue->erase(dp);
+        pfIndex.erase(dp);
+        dp->queue = nullptr;
     }
+}
 
-    for (const_iterator it = queue.cbegin(); it != queue.cend();
-                                                            it++, pos++) {
-        Addr vaddr = it->pfInfo.getAddr();
-        /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
-        DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
+void
+Queued::dropPacket(DeferredPacket *dp)
+{
+    unlinkPacket(dp);
+    // The TLB still refers to packets whose translation is in flight;
+    // they are released when it completes
+    if (!dp->ongoingTranslation) {
+        const unsigned index = dp->poolIndex;
+        pool[index].reset();
+        freePackets.push_back(index);
     }
 }
 
@@ -177,33 +335,26 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (itr->pfInfo.getAddr() == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-                statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
+        while (DeferredPacket *dp = pfIndex.find(blk_addr, is_secure, &pfq)) {
+            DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
+                    "(cl: %#x), demand request going to the same addr\n",
+                    dp->pfInfo.getAddr(),
+                    blockAddress(dp->pfInfo.getAddr()));
+            dropPacket(dp);
+            statsQueued.pfRemovedDemand++;
         }
     }
 
     // Calculate prefetches given this access
-    std::vector<AddrPriority> addresses;
-    calculatePrefetch(pfi, addresses);
+    candidates.clear();
+    calculatePrefetch(pfi, candidates);
 
     // Get the maximu number of prefetches that we are allowed to generate
-    size_t max_pfs = getMaxPermittedPrefetches(addresses.size());
+    size_t max_pfs = getMaxPermittedPrefetches(candidates.size());
 
     // Queue up generated prefetches
     size_t num_pfs = 0;
-    for (AddrPriority& addr_prio : addresses) {
+    for (AddrPriority& addr_prio : candidates) {
 
         // Block align prefetch address
         addr_prio.first = blockAddress(addr_prio.first);
@@ -250,8 +401,9 @@ Queued::getPacket()
         return nullptr;
     }
 
-    PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    DeferredPacket *dp = pfq.front();
+    PacketPtr pkt = dp->createPkt(blkSize, requestorId, tagPrefetch);
+    dropPacket(dp);
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -287,13 +439,15 @@ void
 Queued::processMissingTranslations(unsigned max)
 {
     unsigned count = 0;
-    iterator it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end() && count < max) {
-        DeferredPacket &dp = *it;
-        // Increase the iterator first because dp.startTranslation can end up
-        // calling finishTranslation, which will erase "it"
-        it++;
-        dp.startTranslation(tlb);
+    unsigned pos = 0;
+    while (pos < pfqMissingTranslation.size() && count < max) {
+        DeferredPacket *dp = pfqMissingTranslation.at(pos);
+        // dp->startTranslation can end up calling translationComplete,
+        // which removes dp from the queue
+        dp->startTranslation(tlb);
+        if (dp->queue == &pfqMissingTranslation) {
+            pos++;
+        }
         count += 1;
     }
 }
@@ -301,73 +455,62 @@ Queued::processMissingTranslations(unsigned max)
 void
 Queued::translationComplete(DeferredPacket *dp, bool failed)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
+    if (!dp->queue) {
+        // The prefetch was dropped while being translated
+        dropPacket(dp);
+        return;
     }
-    assert(it != pfqMissingTranslation.end());
+    assert(dp->queue == &pfqMissingTranslation);
+    unlinkPacket(dp);
+
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", tlb->name(),
-                it->translationRequest->getVaddr(),
-                it->translationRequest->getPaddr());
-        Addr target_paddr = it->translationRequest->getPaddr();
+                dp->translationRequest->getVaddr(),
+                dp->translationRequest->getPaddr());
+        Addr target_paddr = dp->translationRequest->getPaddr();
         // check if this prefetch is already redundant
-        if (cacheSnoop && (inCache(target_paddr, it->pfInfo.isSecure()) ||
-                    inMissQueue(target_paddr, it->pfInfo.isSecure()))) {
+        if (cacheSnoop && (inCache(target_paddr, dp->pfInfo.isSecure()) ||
+                    inMissQueue(target_paddr, dp->pfInfo.isSecure()))) {
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
-            addToQueue(pfq, *it);
+            dp->setTarget(target_paddr, pf_time);
+            addToQueue(pfq, dp);
+            return;
         }
     } else {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x failed, dropping "
                 "prefetch request %#x \n", tlb->name(),
-                it->translationRequest->getVaddr());
+                dp->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    dropPacket(dp);
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(PrefetchQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    DeferredPacket *dp = pfIndex.find(pfi.getAddr(), pfi.isSecure(), &queue);
+    if (!dp) {
+        return false;
     }
 
-    /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
-        }
+    /* The address is already in the queue, update priority and leave */
+    statsQueued.pfBufferHit++;
+    if (dp->priority < priority) {
+        /* Update priority value and position in the queue */
+        dp->priority = priority;
+        queue.promote(dp);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
@@ -460,71 +603,43 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
         return;
     }
 
-    /* Create the packet and find the spot to insert it */
-    DeferredPacket dpp(this, new_pfi, 0, priority);
+    /* Take a packet from the pool and find the spot to insert it */
+    DeferredPacket *dp = allocatePacket(new_pfi, priority);
     if (has_target_pa) {
         Tick pf_time = curTick() + clockPeriod() * latency;
-        dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                      pf_time);
+        dp->setTarget(target_paddr, pf_time);
         DPRINTF(HWPrefetch, "Prefetch queued. "
                 "addr:%#x priority: %3d tick:%lld.\n",
                 new_pfi.getAddr(), priority, pf_time);
-        addToQueue(pfq, dpp);
+        addToQueue(pfq, dp);
     } else {
         // Add the translation request and try to resolve it later
-        dpp.setTranslationRequest(translation_req);
-        dpp.tc = cache->system->threads[translation_req->contextId()];
+        dp->setTranslationRequest(translation_req);
+        dp->tc = cache->system->threads[translation_req->contextId()];
         DPRINTF(HWPrefetch, "Prefetch queued with no translation. "
                 "addr:%#x priority: %3d\n", new_pfi.getAddr(), priority);
-        addToQueue(pfqMissingTranslation, dpp);
+        addToQueue(pfqMissingTranslation, dp);
     }
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(PrefetchQueue &queue, DeferredPacket *dp)
 {
     /* Verify prefetch buffer space for request */
-    if (queue.size() == queueSize) {
+    if (queue.full()) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
-            "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
-        }
+        panic_if(queue.empty(), "Prefetch queue is both full and empty!");
+        /* Oldest packet of the lowest priority */
+        DeferredPacket *victim = queue.lowestPriority();
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
-                            "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+                            "oldest packet, addr: %#x\n",
+                            victim->pfInfo.getAddr());
+        dropPacket(victim);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.insert(dp);
+    dp->queue = &queue;
+    pfIndex.insert(dp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
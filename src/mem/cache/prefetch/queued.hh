@@ -39,8 +39,11 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
-#include <list>
+#include <deque>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
@@ -60,6 +63,8 @@ namespace prefetch
 class Queued : public Base
 {
   protected:
+    class PrefetchQueue;
+
     struct DeferredPacket : public BaseMMU::Translation
     {
         /** Owner of the packet */
@@ -68,54 +73,62 @@ class Queued : public Base
         PrefetchInfo pfInfo;
         /** Time when this prefetch becomes ready */
         Tick tick;
-        /** The memory packet generated by this prefetch */
-        PacketPtr pkt;
+        /** Physical address to prefetch, valid once translated */
+        Addr paddr;
         /** The priority of this prefetch */
         int32_t priority;
         /** Request used when a translation is needed */
         RequestPtr translationRequest;
         ThreadContext *tc;
         bool ongoingTranslation;
+        /** Queue holding this packet, nullptr if it has been dropped */
+        PrefetchQueue *queue;
+        /** Position of this packet in the ring of its queue */
+        unsigned slot;
+        /** Position of this packet in the pool of its owner */
+        unsigned poolIndex;
 
         /**
          * Constructor
          * @param o QueuedPrefetcher in charge of this request
          * @param pfi PrefechInfo object associated to this packet
          * @param t Time when this prefetch becomes ready
-         * @param p PacketPtr with the memory request of the prefetch
          * @param prio This prefetch priority
+         * @param pool_index Position of this packet in the pool
          */
         DeferredPacket(Queued *o, PrefetchInfo const &pfi, Tick t,
-            int32_t prio) : owner(o), pfInfo(pfi), tick(t), pkt(nullptr),
-            priority(prio), translationRequest(), tc(nullptr),
-            ongoingTranslation(false) {
+            int32_t prio, unsigned pool_index) : owner(o), pfInfo(pfi),
+            tick(t), paddr(0), priority(prio), translationRequest(),
+            tc(nullptr), ongoingTranslation(false), queue(nullptr), slot(0),
+            poolIndex(pool_index) {
         }
 
-        bool operator>(const DeferredPacket& that) const
-        {
-            return priority > that.priority;
-        }
-        bool operator<(const DeferredPacket& that) const
-        {
-            return priority < that.priority;
-        }
-        bool operator<=(const DeferredPacket& that) const
+        /**
+         * Sets the physical address of this prefetch, making it ready
+         * to be issued.
+         * @param pa physical address of this packet
+         * @param t time when the prefetch becomes ready
+         */
+        void
+        setTarget(Addr pa, Tick t)
         {
-            return !(*this > that);
+            paddr = pa;
+            tick = t;
         }
 
         /**
-         * Create the associated memory packet
-         * @param paddr physical address of this packet
+         * Create the associated memory packet. The packet is only built
+         * when the prefetch is issued, so that squashed, evicted and
+         * filtered candidates never allocate one.
          * @param blk_size block size used by the prefetcher
          * @param requestor_id Requestor ID of the access that generated
          * this prefetch
          * @param tag_prefetch flag to indicate if the packet needs to be
          *        tagged
-         * @param t time when the prefetch becomes ready
+         * @return The new packet, owned by the caller
          */
-        void createPkt(Addr paddr, unsigned blk_size, RequestorID requestor_id,
-                       bool tag_prefetch, Tick t);
+        PacketPtr createPkt(unsigned blk_size, RequestorID requestor_id,
+                            bool tag_prefetch) const;
 
         /**
          * Sets the translation request needed to obtain the physical address
@@ -140,11 +153,150 @@ class Queued : public Base
         void startTranslation(BaseTLB *tlb);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /**
+     * Fixed-capacity queue of deferred packets, kept in decreasing order
+     * of priority and in insertion order among equal priorities. The
+     * packets are stored in a ring, and every packet records its slot so
+     * that it can be removed or moved without searching for it.
+     */
+    class PrefetchQueue
+    {
+      private:
+        /** The ring of packets; count packets starting at head are used */
+        std::vector<DeferredPacket *> ring;
+        unsigned head;
+        unsigned count;
+
+        /** Get the ring slot of the packet at the given position. */
+        unsigned
+        slotOf(unsigned pos) const
+        {
+            const unsigned slot = head + pos;
+            return slot >= ring.size() ? slot - ring.size() : slot;
+        }
+
+        /** Store a packet at the given position. */
+        void
+        place(unsigned pos, DeferredPacket *dp)
+        {
+            dp->slot = slotOf(pos);
+            ring[dp->slot] = dp;
+        }
+
+      public:
+        /** Name used in the debug output. */
+        const std::string name;
+
+        PrefetchQueue(const std::string &_name, unsigned capacity);
+
+        unsigned size() const { return count; }
+        bool empty() const { return count == 0; }
+        bool full() const { return count == ring.size(); }
+
+        /**
+         * Get the packet at the given position, 0 being the first one
+         * to be issued.
+         */
+        DeferredPacket *at(unsigned pos) const { return ring[slotOf(pos)]; }
+        DeferredPacket *front() const { return at(0); }
+
+        /** Get the position of a packet of this queue. */
+        unsigned
+        position(const DeferredPacket *dp) const
+        {
+            return dp->slot >= head ? dp->slot - head :
+                dp->slot + ring.size() - head;
+        }
+
+        /**
+         * Get the oldest packet with the lowest priority, which is the
+         * one to be dropped when the queue is full.
+         */
+        DeferredPacket *lowestPriority() const;
+
+        /**
+         * Insert a packet after all the packets whose priority is not
+         * lower than its own. The queue must not be full.
+         */
+        void insert(DeferredPacket *dp);
+
+        /** Remove a packet of this queue. */
+        void erase(DeferredPacket *dp);
+
+        /**
+         * Move a packet of this queue ahead of the packets with a lower
+         * priority, after its priority has been raised.
+         */
+        void promote(DeferredPacket *dp);
+    };
+
+    /**
+     * Open-addressing hash table of the queued packets, keyed by their
+     * prefetch address and security, so that redundant and squashed
+     * prefetches are found without walking the queues. Packets sharing
+     * an address are held in distinct buckets of the same probe sequence,
+     * and deletions shift the following buckets back instead of leaving
+     * tombstones.
+     */
+    class AddressIndex
+    {
+      private:
+        /** The hash table, sized for at most half of it to be used. */
+        std::vector<DeferredPacket *> buckets;
+
+        /** Number of bits of the bucket index. */
+        const unsigned indexBits;
+
+        /** Get the bucket where the search for an address starts. */
+        std::size_t
+        home(Addr addr, bool is_secure) const
+        {
+            return ((addr ^ is_secure) * 0x9e3779b97f4a7c15ULL) >>
+                (64 - indexBits);
+        }
+
+        std::size_t
+        home(const DeferredPacket *dp) const
+        {
+            return home(dp->pfInfo.getAddr(), dp->pfInfo.isSecure());
+        }
+
+        std::size_t
+        nextBucket(std::size_t bucket) const
+        {
+            return (bucket + 1) & (buckets.size() - 1);
+        }
+
+      public:
+        AddressIndex(unsigned num_entries);
+
+        void insert(DeferredPacket *dp);
+        void erase(DeferredPacket *dp);
+
+        /**
+         * Find a packet prefetching the given address.
+         * @param addr The prefetch address, as used to train.
+         * @param is_secure Whether the address is secure.
+         * @param queue If not null, only consider the packets of it.
+         * @return A matching packet, or nullptr if there is none.
+         */
+        DeferredPacket *find(Addr addr, bool is_secure,
+                             const PrefetchQueue *queue = nullptr) const;
+    };
+
+    /**
+     * Storage for all the deferred packets, allocated once. Packets
+     * whose translation is in flight when they are dropped are only
+     * returned to the free list once the TLB is done with them.
+     */
+    std::deque<std::optional<DeferredPacket>> pool;
+    std::vector<unsigned> freePackets;
+
+    PrefetchQueue pfq;
+    PrefetchQueue pfqMissingTranslation;
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    /** Index of the packets of both queues by prefetch address */
+    AddressIndex pfIndex;
 
     // PARAMETERS
 
@@ -203,19 +355,46 @@ class Queued : public Base
 
     Tick nextPrefetchReadyTime() const override
     {
-        return pfq.empty() ? MaxTick : pfq.front().tick;
+        return pfq.empty() ? MaxTick : pfq.front()->tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const PrefetchQueue &queue) const;
 
   private:
+    /**
+     * Candidate buffer handed to calculatePrefetch, kept across calls so
+     * that its storage is reused.
+     */
+    std::vector<AddrPriority> candidates;
+
+    /**
+     * Takes a DeferredPacket from the pool
+     * @param pfi information of the prefetch request
+     * @param priority priority of the prefetch request
+     * @return the new DeferredPacket
+     */
+    DeferredPacket *allocatePacket(const PrefetchInfo &pfi, int32_t priority);
+
+    /**
+     * Removes a DeferredPacket from its queue, if any
+     * @param dp DeferredPacket to remove
+     */
+    void unlinkPacket(DeferredPacket *dp);
+
+    /**
+     * Removes a DeferredPacket from its queue and returns it to the pool,
+     * unless its translation is still in flight
+     * @param dp DeferredPacket to drop
+     */
+    void dropPacket(DeferredPacket *dp);
 
     /**
-     * Adds a DeferredPacket to the specified queue
+     * Adds a DeferredPacket to the specified queue, dropping the oldest
+     * packet of lowest priority if the queue is full
      * @param queue selected queue to use
-     * @param dpp DeferredPacket to add
+     * @param dp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(PrefetchQueue &queue, DeferredPacket *dp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -243,7 +422,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(PrefetchQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
@@ -55,6 +55,7 @@
 #include "base/types.hh"
 #include "debug/Drain.hh"
 #include "mem/cache/queue_entry.hh"
+#include "mem/cache/queue_index.hh"
 #include "mem/packet.hh"
 #include "sim/cur_tick.hh"
 #include "sim/drain.hh"
@@ -100,6 +101,8 @@ class Queue : public Drainable, public Named
     typename Entry::List readyList;
     /** Holds non allocated entries. */
     typename Entry::List freeList;
+    /** Indexes the allocated entries by block address. */
+    QueueIndex index;
 
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
@@ -135,7 +138,7 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
-        _numInService(0), allocated(0)
+        index(numEntries), _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
@@ -168,16 +171,18 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        // The index holds the entries of the address in allocation order
+        for (QueueEntry *entry = index.find(blk_addr, is_secure); entry;
+             entry = entry->nextMatch) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
             // uncacheable entries, and we do not want normal
             // cacheable accesses being added to an WriteQueueEntry
             // serving an uncacheable access
-            if (!(ignore_uncacheable && entry->isUncacheable()) &&
-                entry->matchBlockAddr(blk_addr, is_secure)) {
-                return entry;
+            if (!(ignore_uncacheable && entry->isUncacheable())) {
+                assert(entry->matchBlockAddr(blk_addr, is_secure));
+                return static_cast<Entry*>(entry);
             }
         }
         return nullptr;
@@ -206,12 +211,26 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
-        for (const auto& ready_entry : readyList) {
-            if (ready_entry->conflictAddr(entry)) {
-                return ready_entry;
+        // Find the conflicting entries that are on the ready list
+        QueueEntry *pending = nullptr;
+        for (QueueEntry *match = index.find(entry->blkAddr, entry->isSecure);
+             match; match = match->nextMatch) {
+            if (match->inService) {
+                continue;
+            } else if (!pending) {
+                pending = match;
+            } else {
+                // Several entries conflict, so the earliest one must be
+                // found in the order of the ready list
+                for (const auto& ready_entry : readyList) {
+                    if (ready_entry->conflictAddr(entry)) {
+                        return ready_entry;
+                    }
+                }
             }
         }
-        return nullptr;
+        assert(!pending || pending->conflictAddr(entry));
+        return static_cast<Entry*>(pending);
     }
 
     /**
@@ -241,6 +260,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        index.erase(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
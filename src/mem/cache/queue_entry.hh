@@ -67,6 +67,7 @@ class QueueEntry : public Packet::SenderState, public Named
      */
     template <class Entry>
     friend class Queue;
+    friend class QueueIndex;
 
   protected:
 
@@ -76,6 +77,13 @@ class QueueEntry : public Packet::SenderState, public Named
     /** True if the entry is uncacheable */
     bool _isUncacheable;
 
+    /**
+     * Next entry of the queue allocated for the same block address and
+     * security, in allocation order.
+     * @sa QueueIndex
+     */
+    QueueEntry *nextMatch;
+
   public:
     /**
      * A queue entry is holding packets that will be serviced as soon as
@@ -123,7 +131,7 @@ class QueueEntry : public Packet::SenderState, public Named
 
     QueueEntry(const std::string &name)
         : Named(name),
-          readyTime(0), _isUncacheable(false),
+          readyTime(0), _isUncacheable(false), nextMatch(nullptr),
           inService(false), order(0), blkAddr(0), blkSize(0), isSecure(false)
     {}
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/queue_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "mem/cache/queue_entry.hh"
+
+namespace gem5
+{
+
+QueueIndex::QueueIndex(int num_entries)
+  : indexBits(ceilLog2(std::max(2 * num_entries, 2)))
+{
+    buckets.resize(std::size_t(1) << indexBits);
+}
+
+std::size_t
+QueueIndex::findBucket(Addr blk_addr, bool is_secure) const
+{
+    std::size_t bucket = home(blk_addr, is_secure);
+    while (buckets[bucket].head &&
+           (buckets[bucket].blkAddr != blk_addr ||
+            buckets[bucket].isSecure != is_secure)) {
+        bucket = nextBucket(bucket);
+    }
+    return bucket;
+}
+
+void
+QueueIndex::insert(QueueEntry *entry)
+{
+    Bucket &bucket = buckets[findBucket(entry->blkAddr, entry->isSecure)];
+    entry->nextMatch = nullptr;
+    if (bucket.head) {
+        bucket.tail->nextMatch = entry;
+    } else {
+        bucket.blkAddr = entry->blkAddr;
+        bucket.isSecure = entry->isSecure;
+        bucket.head = entry;
+    }
+    bucket.tail = entry;
+}
+
+void
+QueueIndex::erase(QueueEntry *entry)
+{
+    std::size_t index = findBucket(entry->blkAddr, entry->isSecure);
+    Bucket &bucket = buckets[index];
+    assert(bucket.head);
+
+    // Unlink the entry from the chain of its address
+    QueueEntry *prev = nullptr;
+    QueueEntry *cur = bucket.head;
+    while (cur != entry) {
+        assert(cur);
+        prev = cur;
+        cur = cur->nextMatch;
+    }
+    if (prev) {
+        prev->nextMatch = entry->nextMatch;
+    } else {
+        bucket.head = entry->nextMatch;
+    }
+    if (bucket.tail == entry) {
+        bucket.tail = prev;
+    }
+    entry->nextMatch = nullptr;
+    if (bucket.head) {
+        return;
+    }
+
+    // The bucket is now empty. Move back the following buckets of the
+    // probe sequence that cannot be reached from their home anymore
+    std::size_t hole = index;
+    for (std::size_t next = nextBucket(hole); buckets[next].head;
+         next = nextBucket(next)) {
+        const std::size_t next_home =
+            home(buckets[next].blkAddr, buckets[next].isSecure);
+        // The bucket can fill the hole if its home is not in (hole, next]
+        const bool reachable = hole <= next ?
+            (hole < next_home && next_home <= next) :
+            (hole < next_home || next_home <= next);
+        if (!reachable) {
+            buckets[hole] = buckets[next];
+            hole = next;
+        }
+    }
+    buckets[hole] = Bucket();
+}
+
+QueueEntry *
+QueueIndex::find(Addr blk_addr, bool is_secure) const
+{
+    return buckets[findBucket(blk_addr, is_secure)].head;
+}
+
+} // namespace gem5
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of an index of the entries of a queue by block address.
+ */
+
+#ifndef __MEM_CACHE_QUEUE_INDEX_HH__
+#define __MEM_CACHE_QUEUE_INDEX_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class QueueEntry;
+
+/**
+ * Index of the allocated entries of a queue by block address and security.
+ *
+ * The index is an open-addressing hash table with linear probing, sized
+ * for at most half of its buckets to be used. Every bucket holds the
+ * entries that share an address, chained through QueueEntry::nextMatch in
+ * allocation order, so that a lookup returns the same entry as a scan of
+ * the allocated list would. Deletions shift the following buckets back
+ * instead of leaving tombstones, so lookups never degrade.
+ */
+class QueueIndex
+{
+  private:
+    /** A bucket of the hash table; it is empty if it has no entries. */
+    struct Bucket
+    {
+        /** Block address of the entries. */
+        Addr blkAddr = 0;
+
+        /** First and last entries allocated, in allocation order. */
+        QueueEntry *head = nullptr;
+        QueueEntry *tail = nullptr;
+
+        /** Whether the entries target the secure memory space. */
+        bool isSecure = false;
+    };
+
+    /** The hash table. */
+    std::vector<Bucket> buckets;
+
+    /** Number of bits of the bucket index. */
+    const unsigned indexBits;
+
+    /** Get the bucket where the search for an address starts. */
+    std::size_t
+    home(Addr blk_addr, bool is_secure) const
+    {
+        const uint64_t hash =
+            (blk_addr ^ uint64_t(is_secure)) * 0x9E3779B97F4A7C15ULL;
+        return hash >> (64 - indexBits);
+    }
+
+    /** Get the bucket after a given one, wrapping around. */
+    std::size_t
+    nextBucket(std::size_t bucket) const
+    {
+        return (bucket + 1) & (buckets.size() - 1);
+    }
+
+    /**
+     * Find the bucket of an address.
+     *
+     * @return The bucket holding the address, or the empty bucket where
+     *         it would be inserted.
+     */
+    std::size_t findBucket(Addr blk_addr, bool is_secure) const;
+
+  public:
+    /**
+     * Create an index for a queue.
+     *
+     * @param num_entries Maximum number of entries of the queue.
+     */
+    QueueIndex(int num_entries);
+
+    /**
+     * Add an allocated entry, after all entries with the same address.
+     *
+     * @param entry The entry; its address must be set.
+     */
+    void insert(QueueEntry *entry);
+
+    /**
+     * Remove an entry that is being deallocated.
+     *
+     * @param entry The entry; its address must not have changed.
+     */
+    void erase(QueueEntry *entry);
+
+    /**
+     * Get the first entry allocated for an address. The other entries
+     * for the address follow it through QueueEntry::nextMatch.
+     *
+     * @param blk_addr The block address.
+     * @param is_secure True if the target memory space is secure.
+     * @return The first entry, or nullptr if there is none.
+     */
+    QueueEntry *find(Addr blk_addr, bool is_secure) const;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_QUEUE_INDEX_HH__
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/cache/queue_entry.hh"
+#include "mem/cache/queue_index.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A queue entry that only has an address. */
+class TestEntry : public QueueEntry
+{
+  public:
+    TestEntry() : QueueEntry("entry") {}
+
+    void
+    setAddr(Addr blk_addr, bool is_secure)
+    {
+        blkAddr = blk_addr;
+        isSecure = is_secure;
+    }
+
+    QueueEntry *next() const { return nextMatch; }
+
+    bool
+    matchBlockAddr(const Addr addr, const bool is_secure) const override
+    {
+        return blkAddr == addr && isSecure == is_secure;
+    }
+    bool matchBlockAddr(const PacketPtr pkt) const override { return false; }
+    bool conflictAddr(const QueueEntry* entry) const override { return false; }
+    bool sendPacket(BaseCache &cache) override { return false; }
+    Target* getTarget() override { return nullptr; }
+};
+
+/** Get the entries of an address, in the order of the index. */
+std::vector<QueueEntry*>
+chain(const QueueIndex &index, Addr blk_addr, bool is_secure)
+{
+    std::vector<QueueEntry*> entries;
+    for (QueueEntry *entry = index.find(blk_addr, is_secure); entry;
+         entry = static_cast<TestEntry*>(entry)->next()) {
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+} // anonymous namespace
+
+/** Entries are found by address and security. */
+TEST(QueueIndexTest, FindsByAddressAndSecurity)
+{
+    QueueIndex index(4);
+    TestEntry a, b;
+    a.setAddr(0x40, false);
+    b.setAddr(0x40, true);
+    index.insert(&a);
+    index.insert(&b);
+
+    ASSERT_EQ(index.find(0x40, false), &a);
+    ASSERT_EQ(index.find(0x40, true), &b);
+    ASSERT_EQ(index.find(0x80, false), nullptr);
+
+    index.erase(&a);
+    ASSERT_EQ(index.find(0x40, false), nullptr);
+    ASSERT_EQ(index.find(0x40, true), &b);
+}
+
+/** Entries of the same address are kept in allocation order. */
+TEST(QueueIndexTest, AllocationOrder)
+{
+    QueueIndex index(4);
+    TestEntry a, b, c;
+    for (auto entry : {&a, &b, &c}) {
+        entry->setAddr(0x100, false);
+        index.insert(entry);
+    }
+    ASSERT_EQ(chain(index, 0x100, false),
+              std::vector<QueueEntry*>({&a, &b, &c}));
+
+    index.erase(&b);
+    ASSERT_EQ(chain(index, 0x100, false),
+              std::vector<QueueEntry*>({&a, &c}));
+    index.insert(&b);
+    index.erase(&a);
+    ASSERT_EQ(chain(index, 0x100, false),
+              std::vector<QueueEntry*>({&c, &b}));
+}
+
+/**
+ * Random allocations and deallocations of a full queue agree with a scan
+ * of the allocated list, including after buckets are shifted back.
+ */
+TEST(QueueIndexTest, MatchesAllocatedListScan)
+{
+    const int num_entries = 64;
+    std::mt19937_64 rng(0);
+    QueueIndex index(num_entries);
+    std::vector<TestEntry> entries(num_entries);
+    std::list<TestEntry*> allocated;
+    std::vector<TestEntry*> free_entries;
+    for (auto &entry : entries) {
+        free_entries.push_back(&entry);
+    }
+
+    for (int i = 0; i < 100000; i++) {
+        if (!free_entries.empty() && (allocated.empty() || rng() % 2)) {
+            TestEntry *entry = free_entries.back();
+            free_entries.pop_back();
+            // Few addresses, so that they collide and repeat
+            entry->setAddr((rng() % 96) * 64, rng() % 4 == 0);
+            index.insert(entry);
+            allocated.push_back(entry);
+        } else {
+            auto it = allocated.begin();
+            std::advance(it, rng() % allocated.size());
+            index.erase(*it);
+            free_entries.push_back(*it);
+            allocated.erase(it);
+        }
+
+        const Addr blk_addr = (rng() % 96) * 64;
+        const bool is_secure = rng() % 4 == 0;
+        std::vector<QueueEntry*> expected;
+        for (auto entry : allocated) {
+            if (entry->matchBlockAddr(blk_addr, is_secure)) {
+                expected.push_back(entry);
+            }
+        }
+        ASSERT_EQ(chain(index, blk_addr, is_secure), expected);
+    }
+}
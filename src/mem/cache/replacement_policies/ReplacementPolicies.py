@@ -83,6 +83,11 @@ class LRUKRP(BaseReplacementPolicy):
     cxx_class = "gem5::replacement_policy::LRUK"
     cxx_header = "mem/cache/replacement_policies/lruk_rp.hh"
 
+    k = Param.Unsigned(2, "Number of most recent references tracked (2-4)")
+    correlated_reference_period = Param.Tick(
+        10, "References closer than this to the previous one are correlated"
+    )
+
 
 class BIPRP(LRURP):
     type = "BIPRP"
@@ -141,6 +146,22 @@ class ARCRP(BaseReplacementPolicy):
     cxx_header = "mem/cache/replacement_policies/arc_rp.hh"
 
 
+class CLOCKProRP(BaseReplacementPolicy):
+    type = "CLOCKProRP"
+    cxx_class = "gem5::replacement_policy::CLOCKPro"
+    cxx_header = "mem/cache/replacement_policies/clock_pro_rp.hh"
+
+
+class LIRSRP(BaseReplacementPolicy):
+    type = "LIRSRP"
+    cxx_class = "gem5::replacement_policy::LIRS"
+    cxx_header = "mem/cache/replacement_policies/lirs_rp.hh"
+
+    hir_fraction = Param.Float(
+        0.01, "Fraction of the entries of a set that hold HIR blocks"
+    )
+
+
 class NRURP(BRRIPRP):
     btp = 100
     num_bits = 1
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/access_trace.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "proto/packet.pb.h"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+AccessTraceReader::AccessTraceReader(const std::string &filename,
+                                     unsigned block_size)
+  : stream(filename), blockSize(block_size), nextBlock(0), remaining(0),
+    tick(0)
+{
+    fatal_if(blockSize == 0 || (blockSize & (blockSize - 1)),
+             "The block size of a trace must be a power of 2.");
+
+    ProtoMessage::PacketHeader header;
+    fatal_if(!stream.read(header), "Failed to read the header of the "
+             "packet trace %s.", filename);
+}
+
+bool
+AccessTraceReader::next(Addr &block, Tick &when)
+{
+    ProtoMessage::Packet pkt;
+    while (remaining == 0) {
+        if (!stream.read(pkt)) {
+            return false;
+        }
+
+        const MemCmd cmd(pkt.cmd());
+        if (!(cmd.isRead() || cmd.isWrite()) ||
+            (pkt.has_flags() && (pkt.flags() & Request::UNCACHEABLE))) {
+            continue;
+        }
+
+        const Addr mask = ~Addr(blockSize - 1);
+        nextBlock = pkt.addr() & mask;
+        const Addr last = (pkt.addr() + std::max(pkt.size(), 1u) - 1) & mask;
+        remaining = (last - nextBlock) / blockSize + 1;
+        tick = pkt.tick();
+    }
+
+    block = nextBlock;
+    when = tick;
+    nextBlock += blockSize;
+    remaining--;
+    return true;
+}
+
+} // namespace replacement_policy
+} // namespace gem5
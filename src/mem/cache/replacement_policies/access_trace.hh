@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Reading of the block accesses recorded in a packet trace.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_ACCESS_TRACE_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_ACCESS_TRACE_HH__
+
+#include <string>
+
+#include "base/compiler.hh"
+#include "base/types.hh"
+#include "proto/protoio.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Reads the accesses to a cache recorded by a MemTraceProbe, in the
+ * packet.proto format, as a sequence of block accesses. Only the cacheable
+ * reads and writes are kept, as they are the only requests that update the
+ * replacement state, and accesses that span several blocks are split.
+ */
+class AccessTraceReader
+{
+  private:
+    /** The trace. */
+    ProtoInputStream stream;
+
+    /** Block size in bytes. */
+    const unsigned blockSize;
+
+    /** Next block of the packet being split. */
+    Addr nextBlock;
+
+    /** Number of blocks of the packet being split left to read. */
+    unsigned remaining;
+
+    /** Tick of the packet being split. */
+    Tick tick;
+
+  public:
+    /**
+     * Open a trace and read its header.
+     *
+     * @param filename Path to the trace; it may be compressed.
+     * @param block_size Block size in bytes.
+     */
+    AccessTraceReader(const std::string &filename, unsigned block_size);
+
+    /**
+     * Read the next block access.
+     *
+     * @param block Address of the block accessed.
+     * @param when Tick on which the access was recorded.
+     * @return False if the end of the trace was reached.
+     */
+    bool next(Addr &block, Tick &when);
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_ACCESS_TRACE_HH__
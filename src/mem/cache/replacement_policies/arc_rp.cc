@@ -28,314 +28,367 @@
 
 #include "mem/cache/replacement_policies/arc_rp.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "base/logging.hh"
 #include "params/ARCRP.hh"
-#include "sim/cur_tick.hh"
-// #include "slist.hh"
 
 namespace gem5
 {
 
-    GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
-    namespace replacement_policy
-    {
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
 
-        ARC::ARC(const Params &p)
-            : Base(p)
-        {
-        }
+void
+ARC::ResidentList::pushFront(ARCReplData *data)
+{
+    data->prev = nullptr;
+    data->next = head;
+    if (head) {
+        head->prev = data;
+    } else {
+        tail = data;
+    }
+    head = data;
+    size++;
+}
 
-        // implementing the REPLACE subroutine
-        // This routine invalidates instead of deleting the LRU page as in paper,
-        // The invalid ones can be deleted later
-        bool ARC::REPLACE(BlockPA blockPA) const
-        {
-            assert(current_index < T1_vec.size());
-            Slist *T1 = T1_vec[current_index].get();
-            Slist *B1 = B1_vec[current_index].get();
-            Slist *T2 = T2_vec[current_index].get();
-            Slist *B2 = B2_vec[current_index].get();
-
-            uint32_t T1_len = slist_length(T1);
-            bool remove_L1;
-
-            // invalidate the LRU page in T1 and move to MRU position in B
-            if (T1_len > 0 && (T1_len > p || (slist_lookup(B2, blockPA) != NULL && T1_len == p)))
-                remove_L1 = true;
-            else
-                remove_L1 = false;
-
-            return remove_L1;
-        }
+void
+ARC::ResidentList::remove(ARCReplData *data)
+{
+    assert(size > 0);
+    if (data->prev) {
+        data->prev->next = data->next;
+    } else {
+        head = data->next;
+    }
+    if (data->next) {
+        data->next->prev = data->prev;
+    } else {
+        tail = data->prev;
+    }
+    data->prev = nullptr;
+    data->next = nullptr;
+    size--;
+}
 
-        void
-        ARC::invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
-        {
-            assert(current_index < T1_vec.size());
-            Slist *T1 = T1_vec[current_index].get();
-            Slist *B1 = B1_vec[current_index].get();
-            Slist *T2 = T2_vec[current_index].get();
-            Slist *B2 = B2_vec[current_index].get();
-
-            // Reset last touch timestamp
-            std::static_pointer_cast<ARCReplData>(replacement_data)->lastTouchTick = Tick(0);
-
-            // TODO: remove the corresponding node in L1&L2
-            // I think removing the node should happen in getVictim? .. will think about it more
-            BlockPA blockPA{current_tag, current_index, NULL};
-            if (std::static_pointer_cast<ARCReplData>(replacement_data)->status == EntryStatus::inList1)
-            {
-                assert(slist_lookup(T1, blockPA) != NULL);
-                slist_look_del(T1, blockPA);
-            }
-            else if (std::static_pointer_cast<ARCReplData>(replacement_data)->status == EntryStatus::inList2)
-            {
-                assert(slist_lookup(T2, blockPA) != NULL);
-                slist_look_del(T2, blockPA);
-            }
-            else
-            {
-                assert(slist_lookup(T1, blockPA) == NULL && slist_lookup(T2, blockPA) == NULL);
-            }
-
-            std::static_pointer_cast<ARCReplData>(replacement_data)->status = EntryStatus::Invalid;
-        }
+ARC::ARCStats::ARCStats(ARC &arc)
+  : statistics::Group(&arc),
+    ADD_STAT(b1Hits, statistics::units::Count::get(),
+             "Number of insertions whose tag was in B1"),
+    ADD_STAT(b2Hits, statistics::units::Count::get(),
+             "Number of insertions whose tag was in B2"),
+    ADD_STAT(ghostMisses, statistics::units::Count::get(),
+             "Number of insertions whose tag was in no ghost list")
+{
+    // B2 is only probed when B1 misses
+    b1Hits.functor([&arc]() { return arc.b1.hits(); });
+    b2Hits.functor([&arc]() { return arc.b2.hits(); });
+    ghostMisses.functor([&arc]() { return arc.b2.misses(); });
+}
 
-        void
-        ARC::touch(const std::shared_ptr<ReplacementData> &replacement_data) const
-        {
-            assert(current_index < T1_vec.size());
-            Slist *T1 = T1_vec[current_index].get();
-            Slist *B1 = B1_vec[current_index].get();
-            Slist *T2 = T2_vec[current_index].get();
-            Slist *B2 = B2_vec[current_index].get();
-
-            // touch is always a cache hit
-            // data should always in T1 or T2;
-            EntryStatus data_status = std::static_pointer_cast<ARCReplData>(replacement_data)->status;
-            uint64_t tag = std::static_pointer_cast<ARCReplData>(replacement_data)->tag;
-            unsigned int index = std::static_pointer_cast<ARCReplData>(replacement_data)->index;
-            // block data to touch must be valid!
-            assert(data_status != EntryStatus::Invalid);
-            assert(tag == current_tag && index == current_index);
-
-            BlockPA blockPA{current_tag, current_index, NULL};
-
-            if (data_status == EntryStatus::inList1)
-            {
-                assert(slist_lookup(T1, blockPA) != NULL && slist_lookup(T2, blockPA) == NULL);
-                slist_look_del(T1, blockPA);
-                slist_add_head(T2, blockPA);
-                assert(slist_lookup(T2, blockPA) != NULL && slist_lookup(T1, blockPA) == NULL);
-            }
-            else if (data_status == EntryStatus::inList2)
-            {
-                assert(slist_lookup(T2, blockPA) != NULL && slist_lookup(T1, blockPA) == NULL);
-                Node *node = slist_lookup(T2, blockPA);
-                slist_repl_head(T2, node);
-                assert(slist_lookup(T2, blockPA) != NULL && slist_lookup(T1, blockPA) == NULL);
-            }
-            // Update variables
-            std::static_pointer_cast<ARCReplData>(replacement_data)->status = EntryStatus::inList2;
-            std::static_pointer_cast<ARCReplData>(replacement_data)->lastTouchTick = curTick();
-        }
+ARC::ARC(const Params &p)
+  : Base(p), stats(*this)
+{
+}
+
+unsigned
+ARC::adaptTarget(uint32_t set, Addr tag) const
+{
+    const ARCSet &arc_set = sets[set];
+    if (b1.contains(set, tag)) {
+        // A hit in B1: T1 would have kept the block if it were larger
+        const unsigned delta = std::max(b2.size(set) / b1.size(set), 1u);
+        return std::min(arc_set.target + delta, arc_set.capacity);
+    } else if (b2.contains(set, tag)) {
+        // A hit in B2: T2 would have kept the block if it were larger
+        const unsigned delta = std::max(b1.size(set) / b2.size(set), 1u);
+        return (arc_set.target > delta) ? arc_set.target - delta : 0;
+    }
+    return arc_set.target;
+}
+
+bool
+ARC::replaceFromT1(uint32_t set, Addr tag, unsigned target) const
+{
+    const ARCSet &arc_set = sets[set];
+
+    // Entries may have been invalidated, so either list can be empty
+    if (arc_set.t1.size == 0) {
+        return false;
+    } else if (arc_set.t2.size == 0) {
+        return true;
+    }
+    return (arc_set.t1.size > target) ||
+        (b2.contains(set, tag) && (arc_set.t1.size == target));
+}
 
-        void
-        ARC::reset(const std::shared_ptr<ReplacementData> &replacement_data) const
-        {
-            assert(current_index < T1_vec.size());
-            Slist *T1 = T1_vec[current_index].get();
-            Slist *B1 = B1_vec[current_index].get();
-            Slist *T2 = T2_vec[current_index].get();
-            Slist *B2 = B2_vec[current_index].get();
-            // Set last touch timestamp
-            std::static_pointer_cast<ARCReplData>(replacement_data)->lastTouchTick = curTick();
-            std::static_pointer_cast<ARCReplData>(replacement_data)->tag = current_tag;
-            std::static_pointer_cast<ARCReplData>(replacement_data)->index = current_index;
-
-            BlockPA blockPA{current_tag, current_index, NULL};
-            assert(slist_lookup(T1, blockPA) == NULL && slist_lookup(T2, blockPA) == NULL);
-            if (slist_lookup(B1, blockPA) != NULL)
-            {
-                // case 1: found in B1
-                // move from B1 to MRU in T2
-                slist_look_del(B1, blockPA);
-                slist_add_head(T2, blockPA);
-                std::static_pointer_cast<ARCReplData>(replacement_data)->status = EntryStatus::inList2;
-            }
-            else if (slist_lookup(B2, blockPA) != NULL)
-            {
-                // case 2: found in B2
-                // move from B2 to MRU in T2
-                slist_look_del(B2, blockPA);
-                slist_add_head(T2, blockPA);
-                std::static_pointer_cast<ARCReplData>(replacement_data)->status = EntryStatus::inList2;
-            }
-            else
-            {
-                // case 3: not found in any list
-                // move to MRU in T1
-                assert(slist_lookup(T1, blockPA) == NULL);
-                slist_add_head(T1, blockPA);
-                std::static_pointer_cast<ARCReplData>(replacement_data)->status = EntryStatus::inList1;
-            }
+void
+ARC::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    ARCReplData *data =
+        static_cast<ARCReplData*>(replacement_data.get());
+    ARCSet &arc_set = sets[data->set];
+
+    // Evicted entries are remembered in the ghost list that matches the
+    // resident list they were taken from
+    if (data->status == EntryStatus::InT1) {
+        arc_set.t1.remove(data);
+        b1.insert(data->set, data->tag);
+    } else if (data->status == EntryStatus::InT2) {
+        arc_set.t2.remove(data);
+        b2.insert(data->set, data->tag);
+    } else {
+        return;
+    }
+    arc_set.free.pushFront(data);
+    data->status = EntryStatus::Invalid;
+}
+
+void
+ARC::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    ARCReplData *data =
+        static_cast<ARCReplData*>(replacement_data.get());
+    ARCSet &arc_set = sets[data->set];
+
+    // A hit always moves the entry to the MRU position of T2
+    assert(data->status != EntryStatus::Invalid);
+    if (data->status == EntryStatus::InT1) {
+        arc_set.t1.remove(data);
+    } else {
+        arc_set.t2.remove(data);
+    }
+    arc_set.t2.pushFront(data);
+    data->status = EntryStatus::InT2;
+}
+
+void
+ARC::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    ARCReplData *data =
+        static_cast<ARCReplData*>(replacement_data.get());
+    ARCSet &arc_set = sets[data->set];
+    const Addr tag = ctx.tag;
+
+    if (data->status == EntryStatus::InT1) {
+        arc_set.t1.remove(data);
+    } else if (data->status == EntryStatus::InT2) {
+        arc_set.t2.remove(data);
+    } else {
+        arc_set.free.remove(data);
+    }
+    data->tag = tag;
+
+    // Commit the target adapted when the victim was chosen, or adapt it now
+    // if no victim had to be chosen for this block
+    arc_set.target = (arc_set.adapted && arc_set.adaptedTag == tag) ?
+        arc_set.adaptedTarget : adaptTarget(data->set, tag);
+
+    if (b1.probe(data->set, tag) || b2.probe(data->set, tag)) {
+        // A miss in ARC, but a hit in the ghost lists: insert the block as
+        // frequently used
+        if (!b1.erase(data->set, tag)) {
+            b2.erase(data->set, tag);
         }
+        arc_set.t2.pushFront(data);
+        data->status = EntryStatus::InT2;
+    } else {
+        // A complete miss. The victim, if any, has already been moved to a
+        // ghost list by invalidate(), so trim the ghost lists to keep
+        // |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+        const unsigned l1_size = arc_set.t1.size + b1.size(data->set);
+        const unsigned total_size =
+            l1_size + arc_set.t2.size + b2.size(data->set);
+        if (l1_size >= arc_set.capacity) {
+            b1.evictLRU(data->set);
+        } else if (total_size >= 2 * arc_set.capacity) {
+            b2.evictLRU(data->set);
+        }
+        arc_set.t1.pushFront(data);
+        data->status = EntryStatus::InT1;
+    }
+    arc_set.adapted = false;
+}
+
+void
+ARC::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("ARC cannot insert an entry without access information.");
+}
 
-        ReplaceableEntry *
-        ARC::getVictim(const ReplacementCandidates &candidates) const
-        {
-            // Note: routine of handling conflict miss is
-            // 1. call getVictim to find a position
-            // 2. call reset() to insert new data to the position of victim
-            // I only perform operations for victim blocks in getVictim but leave the rest part for reset
-            assert(current_index < T1_vec.size());
-            // There must be at least one replacement candidate
-            Slist *T1 = T1_vec[current_index].get();
-            Slist *B1 = B1_vec[current_index].get();
-            Slist *T2 = T2_vec[current_index].get();
-            Slist *B2 = B2_vec[current_index].get();
-            assert(candidates.size() > 0);
-            // Visit all candidates to find victim
-            ReplaceableEntry *victim = NULL;
-
-            // search for invalid ones first
-            for (const auto &candidate : candidates)
-            {
-                // Update victim entry if necessary
-                if (std::static_pointer_cast<ARCReplData>(candidate->replacementData)->status == EntryStatus::Invalid)
-                {
-                    victim = candidate;
-                    return victim;
-                }
-            }
-
-            assert(current_index == std::static_pointer_cast<ARCReplData>(candidates[0]->replacementData)->index);
-            assert(slist_length(T1) + slist_length(T2) == c);
-            BlockPA blockPA{current_tag, current_index, NULL};
-            // Adaption
-            // use MRU of L1 or L2 as victim
-            bool remove_L1;
-            if (slist_lookup(B1, blockPA) != NULL)
-            {
-                // x in B1, (a miss in ARC(c), a hit in DBL(2c)
-                p = std::min(c, p + std::max(slist_length(B2) / slist_length(B1), (unsigned int)1));
-                assert(p <= c);
-                remove_L1 = REPLACE(blockPA);
-            }
-            else if (slist_lookup(B2, blockPA) != NULL)
-            {
-                // x in B2 (a miss in ARC(c), a hit in DBL(2c))
-                p = std::max(0, (int)p - std::max((int)(slist_length(B1) / slist_length(B2)), 1));
-                assert(p <= c);
-                remove_L1 = REPLACE(blockPA);
-            }
-            else
-            {
-                // x not found in L1 U L2
-                // Case A: T1 U B1 has c pages
-                if (slist_length(T1) + slist_length(B1) >= c)
-                {
-                    assert(slist_length(T1) + slist_length(B1) == c);
-                    // delete LRU in B1, replace
-                    if (slist_length(T1) < c)
-                    {
-                        slist_delete_tail(B1);
-                        remove_L1 = REPLACE(blockPA);
-                    }
-                    // B1 is empty, invalidate LRU page in T1
-                    else
-                    {
-                        remove_L1 = true;
-                    }
-                }
-                // Case B: T1 U B1 has less than C pages
-                else
-                {
-                    int32_t sum = slist_length(T1) + slist_length(T2) + slist_length(B1) + slist_length(B2);
-                    if (sum >= c)
-                    {
-                        if (sum >= 2 * c)
-                        {
-                            assert(sum == 2 * c);
-                            slist_delete_tail(B2);
-                        }
-                        remove_L1 = REPLACE(blockPA);
-                    }
-                    else
-                    {
-                        assert(false);
-                    }
-                }
-            }
-
-            if (remove_L1)
-            {
-                // Check T1 list for the LRU one
-                assert(slist_length(T1) > 0);
-                for (const auto &candidate : candidates)
-                {
-                    if (std::static_pointer_cast<ARCReplData>(candidate->replacementData)->status == EntryStatus::inList1)
-                    {
-                        if (victim == NULL)
-                        {
-                            victim = candidate;
-                        }
-                        else if (std::static_pointer_cast<ARCReplData>(candidate->replacementData)->lastTouchTick <
-                                 std::static_pointer_cast<ARCReplData>(victim->replacementData)->lastTouchTick)
-                        {
-                            victim = candidate;
-                        }
-                    }
-                }
-
-                slist_add_head(B1, T1->tail->data);
-                slist_delete_tail(T1);
-            }
-            else
-            {
-                // Check T2 list for the LRU one
-                assert(slist_length(T2) > 0);
-                for (const auto &candidate : candidates)
-                {
-                    if (std::static_pointer_cast<ARCReplData>(candidate->replacementData)->status == EntryStatus::inList2)
-                    {
-                        if (victim == NULL)
-                        {
-                            victim = candidate;
-                        }
-                        else if (std::static_pointer_cast<ARCReplData>(candidate->replacementData)->lastTouchTick <
-                                 std::static_pointer_cast<ARCReplData>(victim->replacementData)->lastTouchTick)
-                        {
-                            victim = candidate;
-                        }
-                    }
-                }
-
-                slist_add_head(B2, T2->tail->data);
-                slist_delete_tail(T2);
-            }
-
-            std::static_pointer_cast<ARCReplData>(victim->replacementData)->status = EntryStatus::Invalid;
-            return victim;
+ReplaceableEntry*
+ARC::findCandidate(const ReplacementCandidates& candidates,
+                   const ARCReplData *data) const
+{
+    // Candidates are usually ordered by way
+    if (data->way < candidates.size() &&
+        candidates[data->way]->replacementData.get() == data) {
+        return candidates[data->way];
+    }
+
+    for (const auto& candidate : candidates) {
+        if (candidate->replacementData.get() == data) {
+            return candidate;
         }
+    }
+
+    panic("ARC victim is not among the replacement candidates");
+}
+
+ReplaceableEntry*
+ARC::getVictim(const ReplacementCandidates& candidates,
+    const AccessContext &ctx)
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+    const uint32_t set = static_cast<ARCReplData*>(
+        candidates[0]->replacementData.get())->set;
+    ARCSet &arc_set = sets[set];
+
+    // Use an invalid entry if there is one
+    if (arc_set.free.size > 0) {
+        return findCandidate(candidates, arc_set.free.head);
+    }
+
+    // As in the paper, a ghost hit adapts the target before REPLACE. The
+    // target is adapted from its committed value, so the cache may ask for
+    // a victim any number of times before inserting the block
+    arc_set.adapted = true;
+    arc_set.adaptedTag = ctx.tag;
+    arc_set.adaptedTarget = adaptTarget(set, ctx.tag);
+
+    // The victim is the LRU entry of the list chosen by REPLACE. The lists
+    // are only updated once the victim is actually invalidated, since the
+    // cache may still decide not to evict it
+    return findCandidate(candidates,
+        replaceFromT1(set, ctx.tag, arc_set.adaptedTarget) ?
+        arc_set.t1.tail : arc_set.t2.tail);
+}
+
+ReplaceableEntry*
+ARC::getVictim(const ReplacementCandidates& candidates) const
+{
+    panic("ARC cannot choose a victim without access information.");
+}
+
+std::shared_ptr<ReplacementData>
+ARC::instantiateEntry(uint32_t set, uint32_t way)
+{
+    if (set >= sets.size()) {
+        sets.resize(set + 1);
+    }
+
+    // The capacity of a set is the number of entries that belong to it.
+    // |T1| + |B1| <= c holds at all times, but B2 may temporarily hold the
+    // tag being accessed plus a tag just evicted from T2, so it is only
+    // bounded by |T2| + |B2| <= 2c
+    ARCSet &arc_set = sets[set];
+    arc_set.capacity++;
+    b1.setCapacity(set, arc_set.capacity);
+    b2.setCapacity(set, 2 * arc_set.capacity);
 
-        std::shared_ptr<ReplacementData>
-        ARC::instantiateEntry()
-        {
-            this->block_num++;
-            if (current_index >= T1_vec.size())
-            {
-                T1_vec.push_back(std::make_shared<Slist>());
-                B1_vec.push_back(std::make_shared<Slist>());
-                T2_vec.push_back(std::make_shared<Slist>());
-                B2_vec.push_back(std::make_shared<Slist>());
-            }
-
-            this->c = std::max(c, this->block_num / (unsigned int)T1_vec.size());
-            return std::shared_ptr<ReplacementData>(new ARCReplData());
+    std::shared_ptr<ReplacementData> replacement_data =
+        replDataArena.allocate(set, way);
+    arc_set.free.pushFront(
+        static_cast<ARCReplData*>(replacement_data.get()));
+    return replacement_data;
+}
+
+std::shared_ptr<ReplacementData>
+ARC::instantiateEntry()
+{
+    panic("ARC needs to know the position of its entries.");
+}
+
+void
+ARC::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    std::ostream &os) const
+{
+    const ARCReplData *data =
+        static_cast<const ARCReplData*>(replacement_data.get());
+
+    // The lists are rebuilt from the position of every entry, counted from
+    // the MRU end
+    uint32_t rank = 0;
+    for (const ARCReplData *it = data->prev; it; it = it->prev) {
+        rank++;
+    }
+    binaryOut(os, data->tag);
+    binaryOut(os, data->status);
+    binaryOut(os, rank);
+}
+
+void
+ARC::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    ARCReplData *data = static_cast<ARCReplData*>(replacement_data.get());
+    binaryIn(is, data->tag);
+    binaryIn(is, data->status);
+    restoredEntries.emplace_back(data, binaryIn<uint32_t>(is));
+}
+
+void
+ARC::serializeState(std::ostream &os) const
+{
+    binaryOut(os, static_cast<uint32_t>(sets.size()));
+    for (const auto &arc_set : sets) {
+        binaryOut(os, arc_set.capacity);
+        binaryOut(os, arc_set.target);
+        binaryOut(os, arc_set.adapted);
+        binaryOut(os, arc_set.adaptedTag);
+        binaryOut(os, arc_set.adaptedTarget);
+    }
+    b1.serialize(os);
+    b2.serialize(os);
+}
+
+void
+ARC::unserializeState(std::istream &is)
+{
+    const uint32_t num_sets = binaryIn<uint32_t>(is);
+    fatal_if(num_sets != sets.size(), "Checkpointed ARC state has %d sets, "
+             "but the table has %d.", num_sets, sets.size());
+    for (auto &arc_set : sets) {
+        fatal_if(binaryIn<unsigned>(is) != arc_set.capacity,
+                 "Checkpointed ARC set does not match the table.");
+        binaryIn(is, arc_set.target);
+        binaryIn(is, arc_set.adapted);
+        binaryIn(is, arc_set.adaptedTag);
+        binaryIn(is, arc_set.adaptedTarget);
+        arc_set.t1 = ResidentList();
+        arc_set.t2 = ResidentList();
+        arc_set.free = ResidentList();
+    }
+
+    // Link the entries again, starting from the LRU end of every list
+    std::stable_sort(restoredEntries.begin(), restoredEntries.end(),
+        [](const auto &a, const auto &b) { return a.second > b.second; });
+    for (const auto &[data, rank] : restoredEntries) {
+        ARCSet &arc_set = sets[data->set];
+        switch (data->status) {
+          case EntryStatus::InT1:
+            arc_set.t1.pushFront(data);
+            break;
+          case EntryStatus::InT2:
+            arc_set.t2.pushFront(data);
+            break;
+          default:
+            arc_set.free.pushFront(data);
         }
+    }
+    restoredEntries.clear();
+
+    b1.unserialize(is);
+    b2.unserialize(is);
+}
 
-    } // namespace replacement_policy
+} // namespace replacement_policy
 } // namespace gem5
@@ -28,117 +28,296 @@
 
 /**
  * @file
- * Declaration of a Least Recently Used replacement policy.
- * The victim is chosen using the last touch timestamp.
+ * Declaration of an Adaptive Replacement Cache (ARC) replacement policy, as
+ * described in "ARC: A Self-Tuning, Low Overhead Replacement Cache", by
+ * Megiddo and Modha.
+ *
+ * Every set keeps two lists of resident entries: T1, holding entries that
+ * have been referenced only once since insertion, and T2, holding entries
+ * that have been referenced at least twice. Two ghost lists, B1 and B2,
+ * remember the tags recently evicted from T1 and T2, respectively. A hit on
+ * a ghost tag adapts the target size of T1 (p) towards the list that would
+ * have kept the block.
+ *
+ * The resident lists are intrusive and doubly-linked through the entries'
+ * replacement data, and the ghost lists are kept in ghost directories, so
+ * touching, inserting, invalidating and choosing a victim are all
+ * constant-time operations.
+ *
+ * Insertions and victim selection depend on the tag being accessed, so the
+ * policy must be driven through the AccessContext interface.
  */
 
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_ARC_RP_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_ARC_RP_HH__
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
-#include "slist.hh"
+#include "mem/cache/replacement_policies/ghost_directory.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
 
-  struct ARCRPParams;
+struct ARCRPParams;
 
-  GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
-  namespace replacement_policy
-  {
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
 
-    class ARC : public Base
+class ARC : public Base
+{
+  protected:
+    /** The list an entry currently belongs to. */
+    enum class EntryStatus : uint8_t
     {
-    protected:
-      /** ARC-specific implementation of replacement data. */
-      enum class EntryStatus
-      {
-        Invalid = -1,
-        inList1 = 0,
-        inList2 = 1
-      };
-
-      struct ARCReplData : ReplacementData
-      {
-        /** Tick on which the entry was last touched. */
-        Tick lastTouchTick;
-
-        // True if in first list (either T or B), False if in second
+        Invalid,
+        InT1,
+        InT2
+    };
+
+    /** ARC-specific implementation of replacement data. */
+    struct ARCReplData : ReplacementData
+    {
+        /** Previous (more recently used) entry in the resident list. */
+        ARCReplData *prev;
+
+        /** Next (less recently used) entry in the resident list. */
+        ARCReplData *next;
+
+        /** Tag of the block, used to record it in a ghost list. */
+        Addr tag;
+
+        /** Position of the entry in the table. */
+        uint32_t set;
+        uint32_t way;
+
+        /** Resident list holding this entry, if any. */
         EntryStatus status;
-        // True if in Top list (either first or second), False if in B
-        bool inTop;
-        uint64_t tag;
-        unsigned int index;
 
         /**
          * Default constructor. Invalidate data.
          */
-        ARCReplData() : status(EntryStatus::Invalid), inTop(0), lastTouchTick(0), tag(0), index(0) {}
-      };
-
-      // I think we can remove above lastTouchTick?
-      unsigned int block_num = 0;
-      unsigned int c = 0; // set*way;
-      mutable unsigned int p = 0;
-
-      std::vector<std::shared_ptr<Slist>> T1_vec;
-      std::vector<std::shared_ptr<Slist>> B1_vec;
-      std::vector<std::shared_ptr<Slist>> T2_vec;
-      std::vector<std::shared_ptr<Slist>> B2_vec;
-
-      bool REPLACE(BlockPA blockPA) const;
-
-    public:
-      typedef ARCRPParams Params;
-      ARC(const Params &p);
-      ~ARC() = default;
-
-      // void setCurrentAddr(uint64_t current_tag, unsigned int current_index);
-      /**
-       * Invalidate replacement data to set it as the next probable victim.
-       * Sets its last touch tick as the starting tick.
-       *
-       * @param replacement_data Replacement data to be invalidated.
-       */
-      void invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
-          override;
-
-      /**
-       * Touch an entry to update its replacement data.
-       * Sets its last touch tick as the current tick.
-       *
-       * @param replacement_data Replacement data to be touched.
-       */
-      void touch(const std::shared_ptr<ReplacementData> &replacement_data) const
-          override;
-
-      /**
-       * Reset replacement data. Used when an entry is inserted.
-       * Sets its last touch tick as the current tick.
-       *
-       * @param replacement_data Replacement data to be reset.
-       */
-      void reset(const std::shared_ptr<ReplacementData> &replacement_data) const
-          override;
-
-      /**
-       * Find replacement victim using ARC timestamps.
-       *
-       * @param candidates Replacement candidates, selected by indexing policy.
-       * @return Replacement entry to be replaced.
-       */
-      ReplaceableEntry *getVictim(const ReplacementCandidates &candidates) const
-          override;
-
-      /**
-       * Instantiate a replacement data entry.
-       *
-       * @return A shared pointer to the new replacement data.
-       */
-      std::shared_ptr<ReplacementData> instantiateEntry() override;
+        ARCReplData(uint32_t _set, uint32_t _way)
+          : prev(nullptr), next(nullptr), tag(0), set(_set), way(_way),
+            status(EntryStatus::Invalid)
+        {}
+    };
+
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<ARCReplData> replDataArena;
+
+    /**
+     * An intrusive, doubly-linked list of resident entries. The head is the
+     * MRU entry and the tail is the LRU entry.
+     */
+    struct ResidentList
+    {
+        ARCReplData *head = nullptr;
+        ARCReplData *tail = nullptr;
+        unsigned size = 0;
+
+        /** Insert an entry at the MRU position. */
+        void pushFront(ARCReplData *data);
+
+        /** Remove an entry from anywhere in the list. */
+        void remove(ARCReplData *data);
+    };
+
+    /** Per-set ARC state. */
+    struct ARCSet
+    {
+        /** Resident lists. */
+        ResidentList t1;
+        ResidentList t2;
+
+        /** Entries that are not resident, which are used first. */
+        ResidentList free;
+
+        /** Number of entries in the set (c in the paper). */
+        unsigned capacity = 0;
+
+        /** Target size of T1 (p in the paper). */
+        unsigned target = 0;
+
+        /**
+         * Whether a victim has been chosen for a miss on adaptedTag, and the
+         * target adapted for it then. The adapted target is only committed
+         * when the block is inserted, so that choosing a victim again has
+         * no effect on the set.
+         */
+        bool adapted = false;
+        Addr adaptedTag = 0;
+        unsigned adaptedTarget = 0;
     };
 
-  } // namespace replacement_policy
+    /**
+     * ARC state of every set, indexed by set number. The replacement
+     * interface is const, but every access updates the set's lists.
+     */
+    mutable std::vector<ARCSet> sets;
+
+    /** Ghost lists of every set. */
+    GhostDirectory b1;
+    GhostDirectory b2;
+
+    /**
+     * Entries read by unserializeEntry(), along with their position in
+     * their list, to be linked again by unserializeState().
+     */
+    std::vector<std::pair<ARCReplData*, uint32_t>> restoredEntries;
+
+    struct ARCStats : public statistics::Group
+    {
+        ARCStats(ARC &arc);
+
+        /** Insertions whose tag was found in B1. */
+        statistics::Value b1Hits;
+
+        /** Insertions whose tag was found in B2. */
+        statistics::Value b2Hits;
+
+        /** Insertions whose tag was in neither ghost list. */
+        statistics::Value ghostMisses;
+    } stats;
+
+    /**
+     * Map the replacement data of a victim back to its candidate entry.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param data The replacement data of the victim.
+     * @return The candidate holding the given replacement data.
+     */
+    ReplaceableEntry* findCandidate(const ReplacementCandidates& candidates,
+                                    const ARCReplData *data) const;
+
+    /**
+     * Adapt the target size of T1 if the given tag hits in a ghost list.
+     *
+     * @param set The number of the set being accessed.
+     * @param tag The tag being accessed.
+     * @return The adapted target, which is not stored in the set.
+     */
+    unsigned adaptTarget(uint32_t set, Addr tag) const;
+
+    /**
+     * The REPLACE subroutine: decide whether the victim should come from T1
+     * or from T2.
+     *
+     * @param set The number of the set being accessed.
+     * @param tag The tag being accessed.
+     * @param target The target size of T1 to replace against.
+     * @return True if the LRU entry of T1 is to be replaced.
+     */
+    bool replaceFromT1(uint32_t set, Addr tag, unsigned target) const;
+
+  public:
+    typedef ARCRPParams Params;
+    ARC(const Params &p);
+    ~ARC() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Removes the entry from its resident list and remembers its tag in the
+     * matching ghost list.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Moves the entry to the MRU position of T2.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Inserts the entry in T2 if its tag was in a ghost list, adapting the
+     * target size of T1, or in T1 otherwise.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param ctx The access that caused the insertion.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim using the ARC lists. Invalid entries are
+     * chosen first; otherwise the LRU entry of T1 or T2 is chosen. Asking
+     * again for the same access returns the same victim and leaves the
+     * target untouched.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param ctx The access that needs a victim.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates,
+        const AccessContext &ctx) override;
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its tag, its list and its position in the list.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
+    /**
+     * Write the target size of T1 and the ghost lists of every set.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeState(std::ostream &os) const override;
+
+    /**
+     * Restore the state written by serializeState().
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeState(std::istream &is) override;
+
+    /**
+     * Instantiate a replacement data entry, growing the state of its set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry(uint32_t set,
+        uint32_t way) override;
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
 } // namespace gem5
 
 #endif // __MEM_CACHE_REPLACEMENT_POLICIES_ARC_RP_HH__
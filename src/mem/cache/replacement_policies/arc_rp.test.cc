@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "mem/cache/replacement_policies/arc_rp.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "params/ARCRP.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+/** An ARC policy whose target size of T1 can be inspected. */
+class InspectableARC : public ARC
+{
+  public:
+    using ARC::ARC;
+
+    unsigned target(uint32_t set) const { return sets[set].target; }
+};
+
+/** A single two-way set of an ARC-managed table. */
+class ARCTest : public testing::Test
+{
+  protected:
+    static constexpr unsigned Assoc = 2;
+
+    ARCRPParams params;
+    std::unique_ptr<InspectableARC> arc;
+    std::array<ReplaceableEntry, Assoc> entries;
+    ReplacementCandidates candidates;
+
+    void
+    SetUp() override
+    {
+        params.name = "arc";
+        params.eventq_index = 0;
+        arc.reset(new InspectableARC(params));
+        for (unsigned way = 0; way < Assoc; way++) {
+            entries[way].replacementData = arc->instantiateEntry(0, way);
+            candidates.push_back(&entries[way]);
+        }
+    }
+
+    static AccessContext context(Addr tag) { return {tag << 6, tag, 0}; }
+
+    ReplaceableEntry *
+    victim(Addr tag)
+    {
+        return arc->getVictim(candidates, context(tag));
+    }
+
+    /** Handle a miss the way the caches do. */
+    ReplaceableEntry *
+    miss(Addr tag)
+    {
+        ReplaceableEntry *entry = victim(tag);
+        arc->invalidate(entry->replacementData);
+        arc->reset(entry->replacementData, context(tag));
+        return entry;
+    }
+
+    /** Hold 1 in T2 and 2 in T1, and leave 0 as a ghost in B1. */
+    void
+    evictToB1()
+    {
+        miss(0);
+        arc->touch(miss(1)->replacementData);
+        miss(2);
+        ASSERT_EQ(arc->target(0), 0u);
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * Asking for a victim several times for the same miss, as a cache that
+ * does not evict the victim right away does, adapts the target once.
+ */
+TEST_F(ARCTest, RepeatedVictimQueries)
+{
+    evictToB1();
+
+    ReplaceableEntry *entry = victim(0);
+    EXPECT_EQ(victim(0), entry);
+    EXPECT_EQ(victim(0), entry);
+    EXPECT_EQ(arc->target(0), 0u);
+
+    arc->invalidate(entry->replacementData);
+    arc->reset(entry->replacementData, context(0));
+    EXPECT_EQ(arc->target(0), 1u);
+}
+
+/**
+ * Ruby probes a set again every time a blocked request is retried, while
+ * the victim is being replaced, and other misses to the set may probe it
+ * in between. None of the probes adapts the target.
+ */
+TEST_F(ARCTest, RepeatedRubyProbes)
+{
+    evictToB1();
+
+    ReplaceableEntry *entry = victim(0);
+    victim(3);
+    EXPECT_EQ(victim(0), entry);
+    EXPECT_EQ(arc->target(0), 0u);
+
+    // The line is deallocated once replaced, and then allocated
+    arc->invalidate(entry->replacementData);
+    arc->reset(entry->replacementData, context(0));
+    EXPECT_EQ(arc->target(0), 1u);
+}
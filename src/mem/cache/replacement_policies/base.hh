@@ -29,11 +29,15 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 
+#include <istream>
 #include <memory>
+#include <ostream>
 
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/packet.hh"
+#include "mem/request.hh"
 #include "params/BaseReplacementPolicy.hh"
 #include "sim/sim_object.hh"
 
@@ -49,6 +53,47 @@ GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
 namespace replacement_policy
 {
 
+/**
+ * The access on whose behalf a replacement policy is being called. It is
+ * built by the table that owns the replacement data, with whatever it knows
+ * about the access, so that policies that depend on the address being
+ * accessed do not need to keep any state across calls.
+ */
+struct AccessContext
+{
+    /** Address being accessed, or MaxAddr if unknown. */
+    Addr addr = MaxAddr;
+
+    /** Tag of the address being accessed, or MaxAddr if unknown. */
+    Addr tag = MaxAddr;
+
+    /** Set being accessed. */
+    uint32_t set = 0;
+
+    /** Whether the access is to the secure address space. */
+    bool secure = false;
+
+    /** Packet that generated the access, if any. */
+    PacketPtr pkt = nullptr;
+
+    /** Requestor that generated the access, if known. */
+    RequestorID requestor = Request::invldRequestorId;
+
+    /** PC of the instruction that generated the access, or MaxAddr. */
+    Addr pc = MaxAddr;
+
+    AccessContext() = default;
+
+    AccessContext(Addr _addr, Addr _tag, uint32_t _set,
+                  const PacketPtr _pkt = nullptr)
+      : addr(_addr), tag(_tag), set(_set),
+        secure(_pkt ? _pkt->isSecure() : false), pkt(_pkt),
+        requestor(_pkt ? _pkt->requestorId() :
+                  RequestorID(Request::invldRequestorId)),
+        pc(_pkt && _pkt->req->hasPC() ? _pkt->req->getPC() : MaxAddr)
+    {}
+};
+
 /**
  * A common base class of cache replacement policy objects.
  */
@@ -59,19 +104,17 @@ class Base : public SimObject
     Base(const Params &p) : SimObject(p) {}
     virtual ~Base() = default;
 
-    uint64_t current_tag;
-    unsigned int current_index;
-
-    void setCurrentAddr(uint64_t current_tag, unsigned int current_index)
-    {
-        this->current_tag = current_tag;
-        this->current_index = current_index;
-    }
     /**
      * Invalidate replacement data to set it as the next probable victim.
      *
      * @param replacement_data Replacement data to be invalidated.
+     * @param ctx The access that caused the invalidation.
      */
+    virtual void invalidate(const std::shared_ptr<ReplacementData>&
+        replacement_data, const AccessContext &ctx)
+    {
+        invalidate(replacement_data);
+    }
     virtual void invalidate(const std::shared_ptr<ReplacementData>&
         replacement_data) = 0;
 
@@ -79,10 +122,10 @@ class Base : public SimObject
      * Update replacement data.
      *
      * @param replacement_data Replacement data to be touched.
-     * @param pkt Packet that generated this access.
+     * @param ctx The access that hit on this entry.
      */
     virtual void touch(const std::shared_ptr<ReplacementData>&
-        replacement_data, const PacketPtr pkt)
+        replacement_data, const AccessContext &ctx)
     {
         touch(replacement_data);
     }
@@ -93,10 +136,10 @@ class Base : public SimObject
      * Reset replacement data. Used when it's holder is inserted/validated.
      *
      * @param replacement_data Replacement data to be reset.
-     * @param pkt Packet that generated this access.
+     * @param ctx The access that caused the insertion.
      */
     virtual void reset(const std::shared_ptr<ReplacementData>&
-        replacement_data, const PacketPtr pkt)
+        replacement_data, const AccessContext &ctx)
     {
         reset(replacement_data);
     }
@@ -107,11 +150,90 @@ class Base : public SimObject
      * Find replacement victim among candidates.
      *
      * @param candidates Replacement candidates, selected by indexing policy.
+     * @param ctx The access that needs a victim.
      * @return Replacement entry to be replaced.
      */
+    virtual ReplaceableEntry* getVictim(
+        const ReplacementCandidates& candidates, const AccessContext &ctx)
+    {
+        return getVictim(candidates);
+    }
     virtual ReplaceableEntry* getVictim(
                            const ReplacementCandidates& candidates) const = 0;
 
+    /**
+     * Whether the policy can save its state to a checkpoint. A table
+     * restores the entries of a policy that cannot by inserting them again,
+     * which leaves the policy in the state of a fresh insertion sequence.
+     */
+    virtual bool checkpointable() const { return false; }
+
+    /**
+     * Whether the policy draws from the global random number generator.
+     * The order of its calls must then follow the order of the simulation
+     * for a run to be reproducible, so it cannot be driven from a thread
+     * other than the simulation thread.
+     */
+    virtual bool usesGlobalRandom() const { return false; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream. A table
+     * writes all of its entries, valid or not, in a fixed order, and reads
+     * them back in the same order.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    virtual void
+    serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                   std::ostream &os) const
+    {
+    }
+
+    /**
+     * Restore the replacement data of an entry from a binary stream. It
+     * is called after the entry has been inserted again in the table.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    virtual void
+    unserializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                     std::istream &is)
+    {
+    }
+
+    /**
+     * Write the state of the policy that is not held by the entries. It
+     * is called after all of the entries have been written.
+     *
+     * @param os The stream to write to.
+     */
+    virtual void serializeState(std::ostream &os) const {}
+
+    /**
+     * Restore the state of the policy that is not held by the entries. It
+     * is called after all of the entries have been restored.
+     *
+     * @param is The stream to read from.
+     */
+    virtual void unserializeState(std::istream &is) {}
+
+    /**
+     * Instantiate a replacement data entry for a given position of the
+     * table. Policies that keep per-set state use it to learn about the
+     * geometry of the table.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry.
+     * @return A shared pointer to the new replacement data.
+     */
+    virtual std::shared_ptr<ReplacementData>
+    instantiateEntry(uint32_t set, uint32_t way)
+    {
+        return instantiateEntry();
+    }
+
     /**
      * Instantiate a replacement data entry.
      *
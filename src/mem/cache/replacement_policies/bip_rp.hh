@@ -76,6 +76,8 @@ class BIP : public LRU
      */
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
+
+    bool usesGlobalRandom() const override { return true; }
 };
 
 } // namespace replacement_policy
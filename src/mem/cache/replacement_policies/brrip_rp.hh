@@ -54,6 +54,7 @@
 
 #include "base/sat_counter.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -91,6 +92,9 @@ class BRRIP : public Base
         }
     };
 
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<BRRIPReplData> replDataArena;
+
     /**
      * Number of RRPV bits. An entry that saturates its RRPV has the longest
      * possible re-reference interval, that is, it is likely not to be used
@@ -152,6 +156,30 @@ class BRRIP : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    bool checkpointable() const override { return true; }
+    bool usesGlobalRandom() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its RRPV and valid flag.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry.
      *
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/clock_pro_rp.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+#include "base/binary_io.hh"
+#include "base/logging.hh"
+#include "params/CLOCKProRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+CLOCKPro::CLOCKProStats::CLOCKProStats(CLOCKPro &clock_pro)
+  : statistics::Group(&clock_pro),
+    ADD_STAT(ghostHits, statistics::units::Count::get(),
+             "Number of insertions whose tag was a ghost"),
+    ADD_STAT(ghostMisses, statistics::units::Count::get(),
+             "Number of insertions whose tag was not a ghost")
+{
+    ghostHits.functor([&clock_pro]() { return clock_pro.ghosts.hits(); });
+    ghostMisses.functor(
+        [&clock_pro]() { return clock_pro.ghosts.misses(); });
+}
+
+CLOCKPro::CLOCKPro(const Params &p)
+  : Base(p), stats(*this)
+{
+}
+
+void
+CLOCKPro::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    CLOCKProReplData *data =
+        static_cast<CLOCKProReplData*>(replacement_data.get());
+    CLOCKProSet &clock_set = sets[data->set];
+
+    if (data->status == EntryStatus::Hot) {
+        assert(clock_set.numHot > 0);
+        clock_set.numHot--;
+    } else if (data->status == EntryStatus::Cold && data->inTest) {
+        // The block stays in its test period while it is a ghost. If that
+        // pushes out a ghost that was never referenced again, cold blocks
+        // are not being reused, so fewer cold entries are kept
+        if (ghosts.insert(data->set, data->tag) &&
+            clock_set.coldTarget > 1) {
+            clock_set.coldTarget--;
+        }
+    }
+
+    data->status = EntryStatus::Invalid;
+    data->referenced = false;
+    data->inTest = false;
+}
+
+void
+CLOCKPro::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    static_cast<CLOCKProReplData*>(replacement_data.get())->referenced = true;
+}
+
+void
+CLOCKPro::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    CLOCKProReplData *data =
+        static_cast<CLOCKProReplData*>(replacement_data.get());
+    CLOCKProSet &clock_set = sets[data->set];
+
+    if (data->status == EntryStatus::Hot) {
+        clock_set.numHot--;
+    }
+    data->tag = ctx.tag;
+    data->referenced = false;
+
+    if (ghosts.probe(data->set, ctx.tag)) {
+        // The block was reused within its test period: it has a short
+        // reuse distance, and more cold entries would have kept it
+        ghosts.erase(data->set, ctx.tag);
+        clock_set.coldTarget = std::min(clock_set.coldTarget + 1,
+            std::max(clock_set.capacity, 2u) - 1);
+        data->status = EntryStatus::Hot;
+        data->inTest = false;
+        clock_set.numHot++;
+    } else {
+        data->status = EntryStatus::Cold;
+        data->inTest = true;
+    }
+}
+
+void
+CLOCKPro::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("CLOCK-Pro cannot insert an entry without access information.");
+}
+
+void
+CLOCKPro::runHandHot(const ReplacementCandidates& candidates,
+                     CLOCKProSet &clock_set) const
+{
+    const unsigned num_candidates = candidates.size();
+    while (true) {
+        CLOCKProReplData *data = static_cast<CLOCKProReplData*>(
+            candidates[clock_set.handHot]->replacementData.get());
+        clock_set.handHot = (clock_set.handHot + 1) % num_candidates;
+
+        if (data->status == EntryStatus::Hot) {
+            if (data->referenced) {
+                data->referenced = false;
+            } else {
+                data->status = EntryStatus::Cold;
+                data->inTest = false;
+                clock_set.numHot--;
+                return;
+            }
+        } else if (data->status == EntryStatus::Cold) {
+            // The hot hand ends the test period of the cold blocks it passes
+            data->inTest = false;
+        }
+    }
+}
+
+ReplaceableEntry*
+CLOCKPro::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+    const unsigned num_candidates = candidates.size();
+    CLOCKProSet &clock_set = sets[static_cast<CLOCKProReplData*>(
+        candidates[0]->replacementData.get())->set];
+
+    // Use an invalid entry if there is one
+    for (const auto& candidate : candidates) {
+        if (static_cast<CLOCKProReplData*>(
+                candidate->replacementData.get())->status ==
+            EntryStatus::Invalid) {
+            return candidate;
+        }
+    }
+
+    // Keep at least coldTarget cold entries, so that the cold hand always
+    // finds one
+    const unsigned cold_target =
+        std::min(clock_set.coldTarget, num_candidates);
+    clock_set.handHot %= num_candidates;
+    clock_set.handCold %= num_candidates;
+    while (clock_set.numHot > num_candidates - cold_target) {
+        runHandHot(candidates, clock_set);
+    }
+
+    // The cold hand evicts the first cold block that has not been
+    // referenced since it last passed. Referenced cold blocks are promoted
+    // if they are in their test period, or start a new one otherwise
+    while (true) {
+        ReplaceableEntry *candidate = candidates[clock_set.handCold];
+        CLOCKProReplData *data = static_cast<CLOCKProReplData*>(
+            candidate->replacementData.get());
+        clock_set.handCold = (clock_set.handCold + 1) % num_candidates;
+
+        if (data->status != EntryStatus::Cold) {
+            continue;
+        }
+        if (!data->referenced) {
+            return candidate;
+        }
+
+        data->referenced = false;
+        if (data->inTest) {
+            data->status = EntryStatus::Hot;
+            data->inTest = false;
+            clock_set.numHot++;
+            if (clock_set.numHot > num_candidates - cold_target) {
+                runHandHot(candidates, clock_set);
+            }
+        } else {
+            data->inTest = true;
+        }
+    }
+}
+
+std::shared_ptr<ReplacementData>
+CLOCKPro::instantiateEntry(uint32_t set, uint32_t way)
+{
+    if (set >= sets.size()) {
+        sets.resize(set + 1);
+    }
+
+    // The ghost directory remembers as many blocks as the set holds, as
+    // the non-resident cold pages of the original clock
+    CLOCKProSet &clock_set = sets[set];
+    clock_set.capacity++;
+    ghosts.setCapacity(set, clock_set.capacity);
+
+    return replDataArena.allocate(set);
+}
+
+std::shared_ptr<ReplacementData>
+CLOCKPro::instantiateEntry()
+{
+    panic("CLOCK-Pro needs to know the position of its entries.");
+}
+
+void
+CLOCKPro::serializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::ostream &os) const
+{
+    const CLOCKProReplData *data =
+        static_cast<const CLOCKProReplData*>(replacement_data.get());
+    binaryOut(os, data->tag);
+    binaryOut(os, data->status);
+    binaryOut(os, data->referenced);
+    binaryOut(os, data->inTest);
+}
+
+void
+CLOCKPro::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    CLOCKProReplData *data =
+        static_cast<CLOCKProReplData*>(replacement_data.get());
+    binaryIn(is, data->tag);
+    binaryIn(is, data->status);
+    binaryIn(is, data->referenced);
+    binaryIn(is, data->inTest);
+}
+
+void
+CLOCKPro::serializeState(std::ostream &os) const
+{
+    binaryOut(os, static_cast<uint32_t>(sets.size()));
+    for (const auto &clock_set : sets) {
+        binaryOut(os, clock_set.capacity);
+        binaryOut(os, clock_set.numHot);
+        binaryOut(os, clock_set.coldTarget);
+        binaryOut(os, clock_set.handHot);
+        binaryOut(os, clock_set.handCold);
+    }
+    ghosts.serialize(os);
+}
+
+void
+CLOCKPro::unserializeState(std::istream &is)
+{
+    const uint32_t num_sets = binaryIn<uint32_t>(is);
+    fatal_if(num_sets != sets.size(), "Checkpointed CLOCK-Pro state has %d "
+             "sets, but the table has %d.", num_sets, sets.size());
+    for (auto &clock_set : sets) {
+        fatal_if(binaryIn<unsigned>(is) != clock_set.capacity,
+                 "Checkpointed CLOCK-Pro set does not match the table.");
+        binaryIn(is, clock_set.numHot);
+        binaryIn(is, clock_set.coldTarget);
+        binaryIn(is, clock_set.handHot);
+        binaryIn(is, clock_set.handCold);
+    }
+    ghosts.unserialize(is);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
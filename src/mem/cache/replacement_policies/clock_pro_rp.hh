@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a CLOCK-Pro replacement policy, as described in "CLOCK-Pro:
+ * An Effective Improvement of the CLOCK Replacement", by Jiang, Chen and
+ * Zhang.
+ *
+ * Entries are either hot, for blocks with a short reuse distance, or cold.
+ * A newly inserted block is cold and starts a test period; if it is
+ * referenced again during that period it becomes hot. The entries of a set
+ * form a clock, in way order, swept by two hands. The cold hand looks for a
+ * victim among the cold entries, and the hot hand demotes hot entries that
+ * have not been referenced when there are too many of them. Cold blocks that
+ * are evicted during their test period are remembered in a ghost directory,
+ * and a miss on one of them both inserts the block as hot and grows the
+ * target number of cold entries of the set. A ghost that expires unused
+ * shrinks that target.
+ *
+ * A hit only sets the reference bit of the entry; all other work is done by
+ * the hands, when a victim is needed. The ghost directory plays the role of
+ * the non-resident pages of the original clock, so it does not need a test
+ * hand.
+ *
+ * Insertions depend on the tag being accessed, so the policy must be driven
+ * through the AccessContext interface.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_CLOCK_PRO_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_CLOCK_PRO_RP_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/ghost_directory.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
+
+namespace gem5
+{
+
+struct CLOCKProRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class CLOCKPro : public Base
+{
+  protected:
+    /** The kind of block held by an entry. */
+    enum class EntryStatus : uint8_t
+    {
+        Invalid,
+        Hot,
+        Cold
+    };
+
+    /** CLOCK-Pro-specific implementation of replacement data. */
+    struct CLOCKProReplData : ReplacementData
+    {
+        /** Tag of the block, used to record it in the ghost directory. */
+        Addr tag;
+
+        /** Set of the entry. */
+        uint32_t set;
+
+        /** Kind of block held. */
+        EntryStatus status;
+
+        /** Whether the block was referenced since a hand last passed. */
+        bool referenced;
+
+        /** Whether a cold block is in its test period. */
+        bool inTest;
+
+        /**
+         * Default constructor. Invalidate data.
+         */
+        CLOCKProReplData(uint32_t _set)
+          : tag(0), set(_set), status(EntryStatus::Invalid),
+            referenced(false), inTest(false)
+        {}
+    };
+
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<CLOCKProReplData> replDataArena;
+
+    /** Per-set CLOCK-Pro state. */
+    struct CLOCKProSet
+    {
+        /** Number of entries in the set. */
+        unsigned capacity = 0;
+
+        /** Number of hot entries. */
+        unsigned numHot = 0;
+
+        /** Target number of cold entries (mc in the paper). */
+        unsigned coldTarget = 1;
+
+        /** Positions of the hands, as candidate indices. */
+        unsigned handHot = 0;
+        unsigned handCold = 0;
+    };
+
+    /**
+     * CLOCK-Pro state of every set, indexed by set number. The replacement
+     * interface is const, but victim searches move the hands.
+     */
+    mutable std::vector<CLOCKProSet> sets;
+
+    /** Cold blocks evicted during their test period. */
+    GhostDirectory ghosts;
+
+    struct CLOCKProStats : public statistics::Group
+    {
+        CLOCKProStats(CLOCKPro &clock_pro);
+
+        /** Insertions whose tag was in the ghost directory. */
+        statistics::Value ghostHits;
+
+        /** Insertions whose tag was not in the ghost directory. */
+        statistics::Value ghostMisses;
+    } stats;
+
+    /**
+     * Move the hot hand until it demotes a hot entry that has not been
+     * referenced since it last passed.
+     *
+     * @param candidates The entries of the set.
+     * @param clock_set The state of the set.
+     */
+    void runHandHot(const ReplacementCandidates& candidates,
+                    CLOCKProSet &clock_set) const;
+
+  public:
+    typedef CLOCKProRPParams Params;
+    CLOCKPro(const Params &p);
+    ~CLOCKPro() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Remembers the tag of cold blocks that are in their test period.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Sets its reference bit.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Inserts the block as hot if it is a ghost, or as a cold block in its
+     * test period otherwise.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param ctx The access that caused the insertion.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim by sweeping the hands. Invalid entries are
+     * chosen first.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its tag, its kind and its reference and test bits.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
+    /**
+     * Write the hands, the cold target and the ghosts of every set.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeState(std::ostream &os) const override;
+
+    /**
+     * Restore the state written by serializeState().
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeState(std::istream &is) override;
+
+    /**
+     * Instantiate a replacement data entry, growing the state of its set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry(uint32_t set,
+        uint32_t way) override;
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_CLOCK_PRO_RP_HH__
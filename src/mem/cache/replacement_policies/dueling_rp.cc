@@ -56,14 +56,24 @@ Dueling::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
     replPolicyB->invalidate(casted_replacement_data->replDataB);
 }
 
+void
+Dueling::invalidate(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    std::shared_ptr<DuelerReplData> casted_replacement_data =
+        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    replPolicyA->invalidate(casted_replacement_data->replDataA, ctx);
+    replPolicyB->invalidate(casted_replacement_data->replDataB, ctx);
+}
+
 void
 Dueling::touch(const std::shared_ptr<ReplacementData>& replacement_data,
-    const PacketPtr pkt)
+    const AccessContext &ctx)
 {
     std::shared_ptr<DuelerReplData> casted_replacement_data =
         std::static_pointer_cast<DuelerReplData>(replacement_data);
-    replPolicyA->touch(casted_replacement_data->replDataA, pkt);
-    replPolicyB->touch(casted_replacement_data->replDataB, pkt);
+    replPolicyA->touch(casted_replacement_data->replDataA, ctx);
+    replPolicyB->touch(casted_replacement_data->replDataB, ctx);
 }
 
 void
@@ -77,12 +87,12 @@ Dueling::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 
 void
 Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data,
-    const PacketPtr pkt)
+    const AccessContext &ctx)
 {
     std::shared_ptr<DuelerReplData> casted_replacement_data =
         std::static_pointer_cast<DuelerReplData>(replacement_data);
-    replPolicyA->reset(casted_replacement_data->replDataA, pkt);
-    replPolicyB->reset(casted_replacement_data->replDataB, pkt);
+    replPolicyA->reset(casted_replacement_data->replDataA, ctx);
+    replPolicyB->reset(casted_replacement_data->replDataB, ctx);
 
     // A miss in a set is a sample to the duel. A call to this function
     // implies in the replacement of an entry, which was either caused by
@@ -106,8 +116,22 @@ Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
     duelingMonitor.sample(static_cast<Dueler*>(casted_replacement_data.get()));
 }
 
+ReplaceableEntry*
+Dueling::getVictim(const ReplacementCandidates& candidates,
+    const AccessContext &ctx)
+{
+    return selectVictim(candidates, &ctx);
+}
+
 ReplaceableEntry*
 Dueling::getVictim(const ReplacementCandidates& candidates) const
+{
+    return selectVictim(candidates, nullptr);
+}
+
+ReplaceableEntry*
+Dueling::selectVictim(const ReplacementCandidates& candidates,
+    const AccessContext *ctx) const
 {
     // This function assumes that all candidates are either part of the same
     // sampled set, or are not samples.
@@ -162,8 +186,9 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     }
 
     // Use the selected replacement policy to find the victim
-    ReplaceableEntry* victim = team_a ? replPolicyA->getVictim(candidates) :
-        replPolicyB->getVictim(candidates);
+    Base* const policy = team_a ? replPolicyA : replPolicyB;
+    ReplaceableEntry* victim = ctx ? policy->getVictim(candidates, *ctx) :
+        policy->getVictim(candidates);
 
     // Search for entry within the original candidates and clean-up duplicates
     for (int i = 0; i < candidates.size(); i++) {
@@ -173,6 +198,16 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+std::shared_ptr<ReplacementData>
+Dueling::instantiateEntry(uint32_t set, uint32_t way)
+{
+    DuelerReplData* replacement_data = new DuelerReplData(
+        replPolicyA->instantiateEntry(set, way),
+        replPolicyB->instantiateEntry(set, way));
+    duelingMonitor.initEntry(static_cast<Dueler*>(replacement_data));
+    return std::shared_ptr<DuelerReplData>(replacement_data);
+}
+
 std::shared_ptr<ReplacementData>
 Dueling::instantiateEntry()
 {
@@ -93,24 +93,48 @@ class Dueling : public Base
         statistics::Scalar selectedB;
     } duelingStats;
 
+    /**
+     * Pick the sub-policy that decides this victimization and let it choose
+     * the victim.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param ctx The access that needs a victim, if known.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* selectVictim(const ReplacementCandidates& candidates,
+        const AccessContext *ctx) const;
+
   public:
     PARAMS(DuelingRP);
     Dueling(const Params &p);
     ~Dueling() = default;
 
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
     void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
                                                                     override;
     void touch(const std::shared_ptr<ReplacementData>& replacement_data,
-        const PacketPtr pkt) override;
+        const AccessContext &ctx) override;
     void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
     void reset(const std::shared_ptr<ReplacementData>& replacement_data,
-        const PacketPtr pkt) override;
+        const AccessContext &ctx) override;
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates,
+        const AccessContext &ctx) override;
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
+    std::shared_ptr<ReplacementData> instantiateEntry(uint32_t set,
+        uint32_t way) override;
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    bool
+    usesGlobalRandom() const override
+    {
+        return replPolicyA->usesGlobalRandom() ||
+            replPolicyB->usesGlobalRandom();
+    }
 };
 
 } // namespace replacement_policy
@@ -31,6 +31,8 @@
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
 #include "params/FIFORP.hh"
 #include "sim/cur_tick.hh"
 
@@ -50,8 +52,8 @@ void
 FIFO::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = Tick(0);
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = Tick(0);
 }
 
 void
@@ -64,8 +66,8 @@ void
 FIFO::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = curTick();
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = curTick();
 }
 
 ReplaceableEntry*
@@ -74,19 +76,12 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
-        // Update victim entry if necessary
-        if (std::static_pointer_cast<FIFOReplData>(
-                    candidate->replacementData)->tickInserted <
-                std::static_pointer_cast<FIFOReplData>(
-                    victim->replacementData)->tickInserted) {
-            victim = candidate;
-        }
-    }
-
-    return victim;
+    // Gather the insertion ticks and pick the oldest
+    return candidates[victim_search::minIndexOf(candidates.size(),
+        [&candidates](std::size_t i) -> uint64_t {
+            return static_cast<const FIFOReplData*>(
+                candidates[i]->replacementData.get())->tickInserted;
+        })];
 }
 
 std::shared_ptr<ReplacementData>
@@ -95,5 +90,22 @@ FIFO::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new FIFOReplData());
 }
 
+void
+FIFO::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                     std::ostream &os) const
+{
+    binaryOut(os, static_cast<const FIFOReplData*>(
+        replacement_data.get())->tickInserted);
+}
+
+void
+FIFO::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    binaryIn(is, static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
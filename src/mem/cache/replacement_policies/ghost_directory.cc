@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/ghost_directory.hh"
+
+#include <cassert>
+
+#include "base/binary_io.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+void
+GhostDirectory::setCapacity(uint32_t set, unsigned capacity)
+{
+    fatal_if(capacity > MaxCapacity, "A ghost directory set cannot hold "
+             "more than %d tags.", MaxCapacity);
+    if (set >= sets.size()) {
+        sets.resize(set + 1);
+    }
+    GhostSet &ghost_set = sets[set];
+    assert(ghost_set.size == 0);
+
+    // Keep the load factor at or below one half so that probe sequences
+    // stay short
+    ghost_set.slots.resize(capacity);
+    ghost_set.buckets.assign(capacity ? 2 * alignToPowerOfTwo(capacity) : 0,
+                             Bucket{0, Null});
+
+    for (uint16_t slot = 0; slot < capacity; slot++) {
+        ghost_set.slots[slot].next = slot + 1 < capacity ? slot + 1 : Null;
+    }
+    ghost_set.freeHead = capacity ? 0 : Null;
+    ghost_set.head = Null;
+    ghost_set.tail = Null;
+}
+
+uint32_t
+GhostDirectory::findBucket(const GhostSet &ghost_set, Addr tag) const
+{
+    if (ghost_set.size == 0) {
+        return NoBucket;
+    }
+
+    const uint64_t h = hash(tag);
+    const uint16_t fingerprint = h >> 48;
+    const uint32_t mask = ghost_set.buckets.size() - 1;
+    for (uint32_t bucket = (h >> 32) & mask;
+         ghost_set.buckets[bucket].slot != Null;
+         bucket = (bucket + 1) & mask) {
+        const Bucket &entry = ghost_set.buckets[bucket];
+        if (entry.fingerprint == fingerprint &&
+            ghost_set.slots[entry.slot].tag == tag) {
+            return bucket;
+        }
+    }
+    return NoBucket;
+}
+
+void
+GhostDirectory::eraseBucket(GhostSet &ghost_set, uint32_t bucket)
+{
+    // Backward-shift deletion: move every displaced entry of the probe
+    // sequence that follows the hole into it, so no tombstones are needed
+    std::vector<Bucket> &buckets = ghost_set.buckets;
+    const uint32_t mask = buckets.size() - 1;
+    uint32_t hole = bucket;
+    buckets[hole].slot = Null;
+    for (uint32_t next = (hole + 1) & mask; buckets[next].slot != Null;
+         next = (next + 1) & mask) {
+        const uint32_t home =
+            (hash(ghost_set.slots[buckets[next].slot].tag) >> 32) & mask;
+        const bool home_in_range = (hole <= next) ?
+            (hole < home && home <= next) : (hole < home || home <= next);
+        if (!home_in_range) {
+            buckets[hole] = buckets[next];
+            buckets[next].slot = Null;
+            hole = next;
+        }
+    }
+}
+
+void
+GhostDirectory::releaseSlot(GhostSet &ghost_set, uint16_t slot)
+{
+    Slot &entry = ghost_set.slots[slot];
+    if (entry.prev != Null) {
+        ghost_set.slots[entry.prev].next = entry.next;
+    } else {
+        ghost_set.head = entry.next;
+    }
+    if (entry.next != Null) {
+        ghost_set.slots[entry.next].prev = entry.prev;
+    } else {
+        ghost_set.tail = entry.prev;
+    }
+
+    entry.next = ghost_set.freeHead;
+    ghost_set.freeHead = slot;
+    ghost_set.size--;
+}
+
+bool
+GhostDirectory::probe(uint32_t set, Addr tag)
+{
+    if (contains(set, tag)) {
+        _hits++;
+        return true;
+    }
+    _misses++;
+    return false;
+}
+
+bool
+GhostDirectory::insert(uint32_t set, Addr tag)
+{
+    GhostSet &ghost_set = sets[set];
+    assert(findBucket(ghost_set, tag) == NoBucket);
+
+    bool evicted = false;
+    if (ghost_set.freeHead == Null) {
+        evicted = evictLRU(set);
+        if (ghost_set.freeHead == Null) {
+            // Zero-capacity set
+            return false;
+        }
+    }
+
+    const uint16_t slot = ghost_set.freeHead;
+    ghost_set.freeHead = ghost_set.slots[slot].next;
+    ghost_set.slots[slot] = {tag, Null, ghost_set.head};
+    if (ghost_set.head != Null) {
+        ghost_set.slots[ghost_set.head].prev = slot;
+    } else {
+        ghost_set.tail = slot;
+    }
+    ghost_set.head = slot;
+
+    const uint64_t h = hash(tag);
+    const uint32_t mask = ghost_set.buckets.size() - 1;
+    uint32_t bucket = (h >> 32) & mask;
+    while (ghost_set.buckets[bucket].slot != Null) {
+        bucket = (bucket + 1) & mask;
+    }
+    ghost_set.buckets[bucket] = {uint16_t(h >> 48), slot};
+    ghost_set.size++;
+    return evicted;
+}
+
+bool
+GhostDirectory::erase(uint32_t set, Addr tag)
+{
+    GhostSet &ghost_set = sets[set];
+    const uint32_t bucket = findBucket(ghost_set, tag);
+    if (bucket == NoBucket) {
+        return false;
+    }
+
+    const uint16_t slot = ghost_set.buckets[bucket].slot;
+    eraseBucket(ghost_set, bucket);
+    releaseSlot(ghost_set, slot);
+    return true;
+}
+
+bool
+GhostDirectory::evictLRU(uint32_t set)
+{
+    const GhostSet &ghost_set = sets[set];
+    if (ghost_set.tail == Null) {
+        return false;
+    }
+    return erase(set, ghost_set.slots[ghost_set.tail].tag);
+}
+
+Addr
+GhostDirectory::lru(uint32_t set) const
+{
+    const GhostSet &ghost_set = sets[set];
+    assert(ghost_set.tail != Null);
+    return ghost_set.slots[ghost_set.tail].tag;
+}
+
+void
+GhostDirectory::serialize(std::ostream &os) const
+{
+    binaryOut(os, uint32_t(sets.size()));
+    for (const GhostSet &ghost_set : sets) {
+        binaryOut(os, ghost_set.size);
+        for (uint16_t slot = ghost_set.tail; slot != Null;
+             slot = ghost_set.slots[slot].prev) {
+            binaryOut(os, ghost_set.slots[slot].tag);
+        }
+    }
+}
+
+void
+GhostDirectory::unserialize(std::istream &is)
+{
+    const uint32_t num_sets = binaryIn<uint32_t>(is);
+    fatal_if(num_sets != sets.size(), "Restoring %d sets of ghosts into a "
+             "directory of %d sets.", num_sets, sets.size());
+
+    for (uint32_t set = 0; set < num_sets; set++) {
+        while (evictLRU(set));
+
+        const uint16_t size = binaryIn<uint16_t>(is);
+        fatal_if(size > capacity(set), "Restoring %d ghosts into a set that "
+                 "can only hold %d.", size, capacity(set));
+
+        // Ghosts were written from LRU to MRU, and every insertion
+        // happens at the MRU position
+        for (uint16_t i = 0; i < size; i++) {
+            insert(set, binaryIn<Addr>(is));
+        }
+    }
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A bounded, per-set directory of the tags of recently evicted blocks, for
+ * replacement policies that learn from the blocks they should have kept.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_GHOST_DIRECTORY_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_GHOST_DIRECTORY_HH__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Remembers, for every set of a table, the tags of up to a given number of
+ * blocks that are no longer resident (ghost tags), in LRU order. When a set
+ * is full, inserting a tag drops its LRU ghost.
+ *
+ * Each set has an open-addressing hash table whose buckets hold a 16-bit
+ * fingerprint of the tag and the index of the slot holding the full tag.
+ * Probes compare fingerprints first, so they rarely touch the slots, and the
+ * LRU order is a doubly-linked list over the slots. Probing, inserting,
+ * erasing and evicting a tag are all constant time, and nothing is allocated
+ * once the capacities are set.
+ *
+ * The directory counts the hits and misses of the probes, so that policies
+ * can report how useful their ghosts are.
+ */
+class GhostDirectory
+{
+  public:
+    /** Largest number of ghost tags a set can hold. */
+    static constexpr unsigned MaxCapacity = 0x7FFF;
+
+  private:
+    /** Marker for an empty bucket or a missing link. */
+    static constexpr uint16_t Null = UINT16_MAX;
+
+    /** Marker for a tag that is not in the hash table. */
+    static constexpr uint32_t NoBucket = UINT32_MAX;
+
+    /** Storage for a ghost tag. */
+    struct Slot
+    {
+        Addr tag;
+        uint16_t prev;
+        uint16_t next;
+    };
+
+    /** A hash bucket. */
+    struct Bucket
+    {
+        uint16_t fingerprint;
+        uint16_t slot;
+    };
+
+    /** The ghosts of a set. */
+    struct GhostSet
+    {
+        /** Tag storage; its size is the capacity of the set. */
+        std::vector<Slot> slots;
+
+        /** Hash buckets; twice as many as slots, rounded to a power of 2. */
+        std::vector<Bucket> buckets;
+
+        /** Slots not currently in use, linked through Slot::next. */
+        uint16_t freeHead = Null;
+
+        /** MRU and LRU slots. */
+        uint16_t head = Null;
+        uint16_t tail = Null;
+
+        /** Number of ghosts currently stored. */
+        uint16_t size = 0;
+    };
+
+    /** Ghosts of every set, indexed by set number. */
+    std::vector<GhostSet> sets;
+
+    /** Probe statistics. */
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+
+    /**
+     * Hash a tag. The home bucket is taken from the middle bits of the
+     * hash, and the fingerprint from its 16 most significant bits.
+     */
+    static uint64_t hash(Addr tag) { return tag * 0x9E3779B97F4A7C15ULL; }
+
+    /**
+     * Find the bucket pointing to a tag.
+     *
+     * @return The index of the bucket, or NoBucket if the tag is absent.
+     */
+    uint32_t findBucket(const GhostSet &ghost_set, Addr tag) const;
+
+    /** Empty a bucket, moving back the buckets displaced by it. */
+    void eraseBucket(GhostSet &ghost_set, uint32_t bucket);
+
+    /** Remove a slot from the LRU list and free it. */
+    void releaseSlot(GhostSet &ghost_set, uint16_t slot);
+
+  public:
+    GhostDirectory() = default;
+
+    /**
+     * Set the number of ghosts a set can hold, creating the set if needed.
+     * The set must be empty.
+     *
+     * @param set The set to be resized.
+     * @param capacity Maximum number of ghost tags held in the set.
+     */
+    void setCapacity(uint32_t set, unsigned capacity);
+
+    /** Number of sets. */
+    uint32_t numSets() const { return sets.size(); }
+
+    /** Maximum number of ghosts held in a set. */
+    unsigned capacity(uint32_t set) const { return sets[set].slots.size(); }
+
+    /** Number of ghosts currently held in a set. */
+    unsigned size(uint32_t set) const { return sets[set].size; }
+
+    /**
+     * Check whether a tag is a ghost of a set, without counting the lookup
+     * in the statistics.
+     */
+    bool
+    contains(uint32_t set, Addr tag) const
+    {
+        return findBucket(sets[set], tag) != NoBucket;
+    }
+
+    /**
+     * Look a tag up and count the result as a hit or a miss.
+     *
+     * @return Whether the tag is a ghost of the set.
+     */
+    bool probe(uint32_t set, Addr tag);
+
+    /**
+     * Add a tag at the MRU position of a set, evicting its LRU ghost if the
+     * set is full. The tag must not be a ghost of the set already.
+     *
+     * @param set The set of the tag.
+     * @param tag The tag of the evicted block.
+     * @return Whether another ghost had to be evicted.
+     */
+    bool insert(uint32_t set, Addr tag);
+
+    /**
+     * Remove a tag from a set, if present.
+     *
+     * @return Whether the tag was a ghost of the set.
+     */
+    bool erase(uint32_t set, Addr tag);
+
+    /**
+     * Drop the LRU ghost of a set, if any.
+     *
+     * @return Whether there was a ghost to drop.
+     */
+    bool evictLRU(uint32_t set);
+
+    /** Tag of the LRU ghost of a set, which must not be empty. */
+    Addr lru(uint32_t set) const;
+
+    /**
+     * Write the ghosts of every set to a binary stream, from LRU to MRU.
+     *
+     * @param os The stream to write to.
+     */
+    void serialize(std::ostream &os) const;
+
+    /**
+     * Replace the ghosts of every set by the ones read from a binary
+     * stream. The sets and their capacities must be the ones the ghosts
+     * were written from. The probe statistics are not affected.
+     *
+     * @param is The stream to read from.
+     */
+    void unserialize(std::istream &is);
+
+    /** Number of probes that found their tag. */
+    uint64_t hits() const { return _hits; }
+
+    /** Number of probes that did not find their tag. */
+    uint64_t misses() const { return _misses; }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_GHOST_DIRECTORY_HH__
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <sstream>
+
+#include "mem/cache/replacement_policies/ghost_directory.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+/** Inserted tags are found in their own set only. */
+TEST(GhostDirectoryTest, InsertAndProbe)
+{
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, 4);
+    ghosts.setCapacity(1, 4);
+    ASSERT_EQ(ghosts.numSets(), 2);
+
+    ASSERT_FALSE(ghosts.insert(0, 0x10));
+    ASSERT_FALSE(ghosts.insert(0, 0x20));
+    ASSERT_EQ(ghosts.size(0), 2);
+    ASSERT_EQ(ghosts.size(1), 0);
+
+    ASSERT_TRUE(ghosts.probe(0, 0x10));
+    ASSERT_TRUE(ghosts.probe(0, 0x20));
+    ASSERT_FALSE(ghosts.probe(0, 0x30));
+    ASSERT_FALSE(ghosts.probe(1, 0x10));
+    ASSERT_EQ(ghosts.hits(), 2);
+    ASSERT_EQ(ghosts.misses(), 2);
+
+    // Lookups through contains() are not counted
+    ASSERT_TRUE(ghosts.contains(0, 0x10));
+    ASSERT_EQ(ghosts.hits(), 2);
+}
+
+/** Inserting in a full set evicts its LRU ghost. */
+TEST(GhostDirectoryTest, EvictsLRUWhenFull)
+{
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, 3);
+
+    for (Addr tag = 1; tag <= 3; tag++) {
+        ASSERT_FALSE(ghosts.insert(0, tag));
+    }
+    ASSERT_EQ(ghosts.lru(0), 1);
+
+    ASSERT_TRUE(ghosts.insert(0, 4));
+    ASSERT_EQ(ghosts.size(0), 3);
+    ASSERT_FALSE(ghosts.contains(0, 1));
+    ASSERT_EQ(ghosts.lru(0), 2);
+
+    ASSERT_TRUE(ghosts.evictLRU(0));
+    ASSERT_FALSE(ghosts.contains(0, 2));
+    ASSERT_EQ(ghosts.lru(0), 3);
+}
+
+/** Erasing a ghost from the middle keeps the LRU order of the rest. */
+TEST(GhostDirectoryTest, Erase)
+{
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, 4);
+    for (Addr tag = 1; tag <= 4; tag++) {
+        ghosts.insert(0, tag);
+    }
+
+    ASSERT_TRUE(ghosts.erase(0, 2));
+    ASSERT_FALSE(ghosts.erase(0, 2));
+    ASSERT_EQ(ghosts.size(0), 3);
+
+    ASSERT_TRUE(ghosts.erase(0, 1));
+    ASSERT_EQ(ghosts.lru(0), 3);
+
+    // The freed slots are reused
+    ghosts.insert(0, 5);
+    ghosts.insert(0, 6);
+    ASSERT_EQ(ghosts.size(0), 4);
+    ASSERT_EQ(ghosts.lru(0), 3);
+}
+
+/** A set without capacity never holds a ghost. */
+TEST(GhostDirectoryTest, ZeroCapacity)
+{
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, 0);
+    ASSERT_FALSE(ghosts.insert(0, 1));
+    ASSERT_EQ(ghosts.size(0), 0);
+    ASSERT_FALSE(ghosts.probe(0, 1));
+    ASSERT_FALSE(ghosts.evictLRU(0));
+}
+
+/** Random operations behave as on a plain bounded LRU list. */
+TEST(GhostDirectoryTest, MatchesReferenceList)
+{
+    const unsigned capacity = 13;
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, capacity);
+    std::list<Addr> reference;
+
+    std::mt19937_64 rng(0);
+    for (int i = 0; i < 100000; i++) {
+        // Tags that only differ in their high bits stress the hash
+        const Addr tag = (rng() % 40) << (rng() % 2 ? 0 : 40);
+        const bool present =
+            std::find(reference.begin(), reference.end(), tag) !=
+            reference.end();
+        ASSERT_EQ(ghosts.contains(0, tag), present);
+
+        if (rng() % 3 == 0) {
+            ASSERT_EQ(ghosts.erase(0, tag), present);
+            reference.remove(tag);
+        } else if (!present) {
+            ASSERT_EQ(ghosts.insert(0, tag), reference.size() == capacity);
+            if (reference.size() == capacity) {
+                reference.pop_back();
+            }
+            reference.push_front(tag);
+        }
+
+        ASSERT_EQ(ghosts.size(0), reference.size());
+        if (!reference.empty()) {
+            ASSERT_EQ(ghosts.lru(0), reference.back());
+        }
+    }
+}
+
+/** Restoring the ghosts replaces the contents and keeps the LRU order. */
+TEST(GhostDirectoryTest, SerializeRoundTrip)
+{
+    GhostDirectory ghosts;
+    ghosts.setCapacity(0, 4);
+    ghosts.setCapacity(1, 2);
+    for (Addr tag = 1; tag <= 6; tag++) {
+        ghosts.insert(0, tag);
+    }
+    ghosts.insert(1, 0x100);
+
+    std::ostringstream os;
+    ghosts.serialize(os);
+
+    GhostDirectory restored;
+    restored.setCapacity(0, 4);
+    restored.setCapacity(1, 2);
+    restored.insert(0, 0x42);
+    restored.insert(1, 0x43);
+    restored.insert(1, 0x44);
+
+    std::istringstream is(os.str());
+    restored.unserialize(is);
+    ASSERT_EQ(is.peek(), std::istringstream::traits_type::eof());
+
+    ASSERT_EQ(restored.size(0), 4);
+    ASSERT_EQ(restored.size(1), 1);
+    ASSERT_FALSE(restored.contains(0, 0x42));
+    ASSERT_FALSE(restored.contains(1, 0x43));
+    ASSERT_TRUE(restored.contains(1, 0x100));
+
+    // The ghosts leave in the same order as in the original directory
+    for (Addr tag = 3; tag <= 6; tag++) {
+        ASSERT_EQ(restored.lru(0), tag);
+        restored.evictLRU(0);
+    }
+}
@@ -31,6 +31,8 @@
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
 #include "params/LFURP.hh"
 
 namespace gem5
@@ -49,21 +51,21 @@ void
 LFU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 0;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount = 0;
 }
 
 void
 LFU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount++;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount++;
 }
 
 void
 LFU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 1;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount = 1;
 }
 
 ReplaceableEntry*
@@ -72,25 +74,35 @@ LFU::getVictim(const ReplacementCandidates& candidates) const
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
-        // Update victim entry if necessary
-        if (std::static_pointer_cast<LFUReplData>(
-                    candidate->replacementData)->refCount <
-                std::static_pointer_cast<LFUReplData>(
-                    victim->replacementData)->refCount) {
-            victim = candidate;
-        }
-    }
-
-    return victim;
+    // Gather the reference counts and pick the least referenced
+    return candidates[victim_search::minIndexOf(candidates.size(),
+        [&candidates](std::size_t i) -> uint64_t {
+            return static_cast<const LFUReplData*>(
+                candidates[i]->replacementData.get())->refCount;
+        })];
 }
 
 std::shared_ptr<ReplacementData>
 LFU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LFUReplData());
+    return replDataArena.allocate();
+}
+
+void
+LFU::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    std::ostream &os) const
+{
+    binaryOut(os, static_cast<const LFUReplData*>(
+        replacement_data.get())->refCount);
+}
+
+void
+LFU::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    binaryIn(is, static_cast<LFUReplData*>(
+        replacement_data.get())->refCount);
 }
 
 } // namespace replacement_policy
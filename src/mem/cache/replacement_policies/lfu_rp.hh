@@ -38,6 +38,7 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_LFU_RP_HH__
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -63,6 +64,9 @@ class LFU : public Base
         LFUReplData() : refCount(0) {}
     };
 
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<LFUReplData> replDataArena;
+
   public:
     typedef LFURPParams Params;
     LFU(const Params &p);
@@ -104,6 +108,29 @@ class LFU : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its reference count.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry.
      *
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/lirs_rp.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+#include "base/binary_io.hh"
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
+#include "params/LIRSRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+LIRS::LIRSStats::LIRSStats(LIRS &lirs)
+  : statistics::Group(&lirs),
+    ADD_STAT(ghostHits, statistics::units::Count::get(),
+             "Number of insertions whose tag was a ghost"),
+    ADD_STAT(ghostMisses, statistics::units::Count::get(),
+             "Number of insertions whose tag was not a ghost")
+{
+    ghostHits.functor([&lirs]() { return lirs.ghosts.hits(); });
+    ghostMisses.functor([&lirs]() { return lirs.ghosts.misses(); });
+}
+
+LIRS::LIRS(const Params &p)
+  : Base(p), hirFraction(p.hir_fraction), stats(*this)
+{
+    fatal_if(hirFraction < 0 || hirFraction >= 1,
+             "The fraction of HIR entries must be in [0, 1).");
+}
+
+void
+LIRS::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    LIRSReplData *data = static_cast<LIRSReplData*>(replacement_data.get());
+    LIRSSet &lirs_set = sets[data->set];
+
+    if (data->status == EntryStatus::LIR) {
+        assert(lirs_set.numLIR > 0);
+        lirs_set.numLIR--;
+    } else if (data->status == EntryStatus::HIR &&
+               data->lastAccess > lirs_set.stackBottom) {
+        // The block is still in the LIRS stack, so remember it as a
+        // non-resident HIR block
+        ghosts.insert(data->set, data->tag);
+    }
+
+    data->status = EntryStatus::Invalid;
+}
+
+void
+LIRS::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    LIRSReplData *data = static_cast<LIRSReplData*>(replacement_data.get());
+    LIRSSet &lirs_set = sets[data->set];
+
+    // A HIR block referenced again while in the stack has a lower IRR than
+    // the LIR block at the bottom of the stack. The extra LIR block is
+    // demoted when the next victim is chosen
+    if (data->status == EntryStatus::HIR &&
+        data->lastAccess > lirs_set.stackBottom) {
+        data->status = EntryStatus::LIR;
+        lirs_set.numLIR++;
+    }
+    data->lastAccess = ++lirs_set.accesses;
+}
+
+void
+LIRS::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    LIRSReplData *data = static_cast<LIRSReplData*>(replacement_data.get());
+    LIRSSet &lirs_set = sets[data->set];
+
+    if (data->status == EntryStatus::LIR) {
+        lirs_set.numLIR--;
+    }
+    data->tag = ctx.tag;
+    data->lastAccess = ++lirs_set.accesses;
+
+    // The block is resident again, so it can no longer be a ghost, however
+    // it is inserted
+    const bool ghost = ghosts.probe(data->set, ctx.tag);
+    if (ghost) {
+        ghosts.erase(data->set, ctx.tag);
+    }
+
+    // Blocks are LIR until the set holds enough of them. A non-resident
+    // HIR block referenced again while in the stack is LIR as well
+    if (lirs_set.numLIR < lirs_set.lirCapacity || ghost) {
+        data->status = EntryStatus::LIR;
+        lirs_set.numLIR++;
+    } else {
+        data->status = EntryStatus::HIR;
+    }
+}
+
+void
+LIRS::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("LIRS cannot insert an entry without access information.");
+}
+
+std::size_t
+LIRS::leastRecent(const ReplacementCandidates& candidates,
+                  EntryStatus status) const
+{
+    const std::size_t num_candidates = candidates.size();
+    auto key = [&candidates, status](std::size_t i) -> uint64_t {
+        const LIRSReplData *data = static_cast<LIRSReplData*>(
+            candidates[i]->replacementData.get());
+        return data->status == status ? data->lastAccess : UINT64_MAX;
+    };
+
+    const std::size_t index = victim_search::minIndexOf(num_candidates, key);
+    return key(index) == UINT64_MAX ? num_candidates : index;
+}
+
+ReplaceableEntry*
+LIRS::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+    const std::size_t num_candidates = candidates.size();
+    LIRSSet &lirs_set = sets[static_cast<LIRSReplData*>(
+        candidates[0]->replacementData.get())->set];
+
+    // Use an invalid entry if there is one
+    for (const auto& candidate : candidates) {
+        if (static_cast<LIRSReplData*>(
+                candidate->replacementData.get())->status ==
+            EntryStatus::Invalid) {
+            return candidate;
+        }
+    }
+
+    // Hits since the last miss may have promoted too many blocks; demote
+    // the least recent LIR blocks, and find the new bottom of the stack
+    std::size_t bottom = leastRecent(candidates, EntryStatus::LIR);
+    while (lirs_set.numLIR > lirs_set.lirCapacity &&
+           bottom < num_candidates) {
+        static_cast<LIRSReplData*>(
+            candidates[bottom]->replacementData.get())->status =
+            EntryStatus::HIR;
+        lirs_set.numLIR--;
+        bottom = leastRecent(candidates, EntryStatus::LIR);
+    }
+    lirs_set.stackBottom = bottom < num_candidates ?
+        static_cast<LIRSReplData*>(
+            candidates[bottom]->replacementData.get())->lastAccess :
+        lirs_set.accesses;
+
+    // The victim is the least recent resident HIR block, which is the
+    // front of the HIR queue
+    const std::size_t victim = leastRecent(candidates, EntryStatus::HIR);
+    if (victim < num_candidates) {
+        return candidates[victim];
+    }
+
+    // Every block is LIR, so fall back to the bottom of the stack
+    assert(bottom < num_candidates);
+    return candidates[bottom];
+}
+
+std::shared_ptr<ReplacementData>
+LIRS::instantiateEntry(uint32_t set, uint32_t way)
+{
+    if (set >= sets.size()) {
+        sets.resize(set + 1);
+    }
+
+    // At least one entry of every set holds HIR blocks. The ghost directory
+    // remembers as many non-resident HIR blocks as the set holds blocks
+    LIRSSet &lirs_set = sets[set];
+    lirs_set.capacity++;
+    const unsigned hir_capacity = std::max(1u,
+        static_cast<unsigned>(lirs_set.capacity * hirFraction));
+    lirs_set.lirCapacity = lirs_set.capacity > hir_capacity ?
+        lirs_set.capacity - hir_capacity : 0;
+    ghosts.setCapacity(set, lirs_set.capacity);
+
+    return replDataArena.allocate(set);
+}
+
+std::shared_ptr<ReplacementData>
+LIRS::instantiateEntry()
+{
+    panic("LIRS needs to know the position of its entries.");
+}
+
+void
+LIRS::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                     std::ostream &os) const
+{
+    const LIRSReplData *data =
+        static_cast<const LIRSReplData*>(replacement_data.get());
+    binaryOut(os, data->tag);
+    binaryOut(os, data->lastAccess);
+    binaryOut(os, data->status);
+}
+
+void
+LIRS::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    LIRSReplData *data = static_cast<LIRSReplData*>(replacement_data.get());
+    binaryIn(is, data->tag);
+    binaryIn(is, data->lastAccess);
+    binaryIn(is, data->status);
+}
+
+void
+LIRS::serializeState(std::ostream &os) const
+{
+    binaryOut(os, static_cast<uint32_t>(sets.size()));
+    for (const auto &lirs_set : sets) {
+        binaryOut(os, lirs_set.capacity);
+        binaryOut(os, lirs_set.numLIR);
+        binaryOut(os, lirs_set.accesses);
+        binaryOut(os, lirs_set.stackBottom);
+    }
+    ghosts.serialize(os);
+}
+
+void
+LIRS::unserializeState(std::istream &is)
+{
+    const uint32_t num_sets = binaryIn<uint32_t>(is);
+    fatal_if(num_sets != sets.size(), "Checkpointed LIRS state has %d sets, "
+             "but the table has %d.", num_sets, sets.size());
+    for (auto &lirs_set : sets) {
+        fatal_if(binaryIn<unsigned>(is) != lirs_set.capacity,
+                 "Checkpointed LIRS set does not match the table.");
+        binaryIn(is, lirs_set.numLIR);
+        binaryIn(is, lirs_set.accesses);
+        binaryIn(is, lirs_set.stackBottom);
+    }
+    ghosts.unserialize(is);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a Low Inter-reference Recency Set (LIRS) replacement
+ * policy, as described in "LIRS: An Efficient Low Inter-reference Recency
+ * Set Replacement Policy to Improve Buffer Cache Performance", by Jiang and
+ * Zhang.
+ *
+ * Blocks are classified by their inter-reference recency (IRR): most of the
+ * entries of a set hold LIR blocks, which were re-referenced recently, and
+ * the rest hold HIR blocks, which are the only ones that can be evicted.
+ * A HIR block becomes LIR if it is referenced again while it is more recent
+ * than the least recent LIR block (the bottom of the LIRS stack), which is
+ * then demoted to HIR. Evicted HIR blocks are remembered in a ghost
+ * directory, and a miss on one of them inserts the block as LIR.
+ *
+ * Instead of moving entries in the LIRS stack and HIR queue on every hit,
+ * each entry keeps the time of its last access to its set, and the stack
+ * bottom is recomputed when a victim is needed. A hit is thus a timestamp
+ * update plus a comparison, at the cost of using a slightly stale stack
+ * bottom between misses.
+ *
+ * Insertions depend on the tag being accessed, so the policy must be driven
+ * through the AccessContext interface.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_LIRS_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_LIRS_RP_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/ghost_directory.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
+
+namespace gem5
+{
+
+struct LIRSRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class LIRS : public Base
+{
+  protected:
+    /** The kind of block held by an entry. */
+    enum class EntryStatus : uint8_t
+    {
+        Invalid,
+        LIR,
+        HIR
+    };
+
+    /** LIRS-specific implementation of replacement data. */
+    struct LIRSReplData : ReplacementData
+    {
+        /** Tag of the block, used to record it in the ghost directory. */
+        Addr tag;
+
+        /** Access count of the set when the block was last accessed. */
+        uint64_t lastAccess;
+
+        /** Set of the entry. */
+        uint32_t set;
+
+        /** Kind of block held. */
+        EntryStatus status;
+
+        /**
+         * Default constructor. Invalidate data.
+         */
+        LIRSReplData(uint32_t _set)
+          : tag(0), lastAccess(0), set(_set), status(EntryStatus::Invalid)
+        {}
+    };
+
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<LIRSReplData> replDataArena;
+
+    /** Per-set LIRS state. */
+    struct LIRSSet
+    {
+        /** Number of entries in the set. */
+        unsigned capacity = 0;
+
+        /** Maximum number of LIR entries. */
+        unsigned lirCapacity = 0;
+
+        /** Number of LIR entries. */
+        unsigned numLIR = 0;
+
+        /** Number of accesses to the set, used as its clock. */
+        uint64_t accesses = 0;
+
+        /** Last access of the least recent LIR block, as last computed. */
+        uint64_t stackBottom = 0;
+    };
+
+    /**
+     * LIRS state of every set, indexed by set number. The replacement
+     * interface is const, but every access advances the clock of its set.
+     */
+    mutable std::vector<LIRSSet> sets;
+
+    /** Evicted HIR blocks. */
+    GhostDirectory ghosts;
+
+    /** Fraction of the entries of a set that hold HIR blocks. */
+    const double hirFraction;
+
+    struct LIRSStats : public statistics::Group
+    {
+        LIRSStats(LIRS &lirs);
+
+        /** Insertions whose tag was in the ghost directory. */
+        statistics::Value ghostHits;
+
+        /** Insertions whose tag was not in the ghost directory. */
+        statistics::Value ghostMisses;
+    } stats;
+
+    /**
+     * Find the LIR or HIR candidate accessed least recently.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @param status The kind of block looked for.
+     * @return The index of the candidate, or candidates.size() if no
+     *         candidate holds that kind of block.
+     */
+    std::size_t leastRecent(const ReplacementCandidates& candidates,
+                            EntryStatus status) const;
+
+  public:
+    typedef LIRSRPParams Params;
+    LIRS(const Params &p);
+    ~LIRS() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Remembers the tag of HIR blocks that are still in the LIRS stack.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Promotes HIR blocks that are still in the LIRS stack, and updates the
+     * time of the last access.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Inserts the block as LIR if the set has room for it or it is a ghost,
+     * or as HIR otherwise. Its ghost, if any, is dropped either way.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param ctx The access that caused the insertion.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim. Invalid entries are chosen first; otherwise
+     * extra LIR blocks are demoted, and the least recent HIR block is
+     * chosen.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its tag, its kind and its last access.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
+    /**
+     * Write the access counters and the ghosts of every set.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeState(std::ostream &os) const override;
+
+    /**
+     * Restore the state written by serializeState().
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeState(std::istream &is) override;
+
+    /**
+     * Instantiate a replacement data entry, growing the state of its set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry(uint32_t set,
+        uint32_t way) override;
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_LIRS_RP_HH__
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "mem/cache/replacement_policies/lirs_rp.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "params/LIRSRP.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+/** A LIRS policy whose ghost directory can be inspected. */
+class InspectableLIRS : public LIRS
+{
+  public:
+    using LIRS::LIRS;
+
+    bool
+    isGhost(uint32_t set, Addr tag) const
+    {
+        return ghosts.contains(set, tag);
+    }
+};
+
+/** A single set of a LIRS-managed table. */
+class LIRSTest : public testing::Test
+{
+  protected:
+    static constexpr unsigned Assoc = 4;
+
+    LIRSRPParams params;
+    std::unique_ptr<InspectableLIRS> lirs;
+    std::array<ReplaceableEntry, Assoc> entries;
+    ReplacementCandidates candidates;
+
+    void
+    SetUp() override
+    {
+        params.name = "lirs";
+        params.eventq_index = 0;
+        // One HIR entry and three LIR entries
+        params.hir_fraction = 0.25;
+        lirs.reset(new InspectableLIRS(params));
+        for (unsigned way = 0; way < Assoc; way++) {
+            entries[way].replacementData = lirs->instantiateEntry(0, way);
+            candidates.push_back(&entries[way]);
+        }
+    }
+
+    void
+    insert(unsigned way, Addr tag)
+    {
+        lirs->reset(entries[way].replacementData,
+                    AccessContext(tag << 6, tag, 0));
+    }
+
+    void touch(unsigned way) { lirs->touch(entries[way].replacementData); }
+
+    void
+    invalidate(unsigned way)
+    {
+        lirs->invalidate(entries[way].replacementData);
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * A block that becomes resident again is no longer a ghost, even when it
+ * is inserted as LIR because the set has room for LIR blocks.
+ */
+TEST_F(LIRSTest, ReinsertionDropsTheGhost)
+{
+    const Addr tag = 3;
+    insert(0, 0);
+    insert(1, 1);
+    insert(2, 2);
+    insert(3, tag);
+
+    // The HIR block is evicted while in the stack, and LIR room is freed
+    invalidate(3);
+    ASSERT_TRUE(lirs->isGhost(0, tag));
+    invalidate(0);
+
+    insert(0, tag);
+    EXPECT_FALSE(lirs->isGhost(0, tag));
+
+    // Demote the block, reference it again and evict it while it is back
+    // in the stack, so that it becomes a ghost once more
+    touch(1);
+    touch(2);
+    insert(3, 5);
+    touch(3);
+    ASSERT_EQ(lirs->getVictim(candidates), &entries[0]);
+    touch(0);
+    invalidate(0);
+    ASSERT_TRUE(lirs->isGhost(0, tag));
+
+    // Its only ghost is consumed when it is inserted again
+    insert(0, tag);
+    EXPECT_FALSE(lirs->isGhost(0, tag));
+}
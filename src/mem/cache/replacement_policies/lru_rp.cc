@@ -31,6 +31,8 @@
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
 #include "params/LRURP.hh"
 #include "sim/cur_tick.hh"
 
@@ -50,24 +52,24 @@ void
 LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = Tick(0);
 }
 
 void
 LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 void
 LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 ReplaceableEntry*
@@ -76,25 +78,35 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
-        // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
-                    candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
-            victim = candidate;
-        }
-    }
-
-    return victim;
+    // Gather the last touch timestamps and pick the oldest
+    return candidates[victim_search::minIndexOf(candidates.size(),
+        [&candidates](std::size_t i) -> uint64_t {
+            return static_cast<const LRUReplData*>(
+                candidates[i]->replacementData.get())->lastTouchTick;
+        })];
 }
 
 std::shared_ptr<ReplacementData>
 LRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LRUReplData());
+    return replDataArena.allocate();
+}
+
+void
+LRU::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    std::ostream &os) const
+{
+    binaryOut(os, static_cast<const LRUReplData*>(
+        replacement_data.get())->lastTouchTick);
+}
+
+void
+LRU::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    binaryIn(is, static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick);
 }
 
 } // namespace replacement_policy
@@ -36,6 +36,7 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -61,6 +62,9 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<LRUReplData> replDataArena;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -102,6 +106,29 @@ class LRU : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its last touch tick.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry.
      *
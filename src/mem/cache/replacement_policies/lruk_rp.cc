@@ -29,129 +29,163 @@
 #include "mem/cache/replacement_policies/lruk_rp.hh"
 
 #include <cassert>
+#include <iterator>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
 #include "params/LRUKRP.hh"
 #include "sim/cur_tick.hh"
 
 namespace gem5
 {
 
-    GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
-    namespace replacement_policy
-    {
-
-        LRUK::LRUK(const Params &p)
-            : Base(p)
-        {
-        }
-
-        void
-        LRUK::invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
-        {
-            // Reset last touch timestamp
-            std::static_pointer_cast<LRUKReplData>(
-                replacement_data)
-                ->lastTouchTick = Tick(0);
-
-            std::static_pointer_cast<LRUKReplData>(
-                replacement_data)
-                ->history.assign(k, 0);
-        }
-
-        void
-        LRUK::touch(const std::shared_ptr<ReplacementData> &replacement_data) const
-        {
-            // Update last touch timestamp
-            Tick cur_tick = curTick();
-            if (cur_tick > std::static_pointer_cast<LRUKReplData>(replacement_data)->lastTouchTick + CPR)
-            {
-                std::vector<Tick> history = std::static_pointer_cast<LRUKReplData>(replacement_data)->history;
-                assert(std::static_pointer_cast<LRUKReplData>(replacement_data)->lastTouchTick >= history[0]);
-                Tick correl_period = std::static_pointer_cast<LRUKReplData>(replacement_data)->lastTouchTick - history[0];
-
-                for (int i = 1; i < history.size(); i++)
-                {
-                    history[i] = history[i - 1] + correl_period;
-                }
-
-                history[0] = cur_tick;
-                std::static_pointer_cast<LRUKReplData>(replacement_data)->history = history;
-            }
-            std::static_pointer_cast<LRUKReplData>(replacement_data)->lastTouchTick = cur_tick;
-        }
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
 
-        void
-        LRUK::reset(const std::shared_ptr<ReplacementData> &replacement_data) const
-        {
-            // Set last touch timestamp
-            std::static_pointer_cast<LRUKReplData>(
-                replacement_data)
-                ->lastTouchTick = curTick();
+LRUK::LRUK(const Params &p)
+  : Base(p), k(p.k), correlatedReferencePeriod(p.correlated_reference_period)
+{
+    fatal_if(k < 2 || k > 4, "LRU-K only supports K from 2 to 4, not %d.",
+             k);
+}
 
-            std::vector<Tick> history(k, Tick(0));
-            history[0] = curTick();
+void
+LRUK::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    // Forget all references
+    visit(replacement_data.get(), [](auto *data) { data->clear(Tick(0)); });
+}
 
-            std::static_pointer_cast<LRUKReplData>(
-                replacement_data)
-                ->history = history;
+void
+LRUK::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    const Tick cur_tick = curTick();
+    visit(replacement_data.get(), [&](auto *data) {
+        if (cur_tick > data->lastTouchTick + correlatedReferencePeriod) {
+            // A new, uncorrelated reference
+            assert(data->lastTouchTick >= data->at(0));
+            data->push(cur_tick);
+        } else {
+            // Part of the same burst of references
+            data->lastTouchTick = cur_tick;
         }
+    });
+}
 
-        ReplaceableEntry *
-        LRUK::getVictim(const ReplacementCandidates &candidates) const
-        {
-            // There must be at least one replacement candidate
-            assert(candidates.size() > 0);
-
-            // Visit all candidates to find victim
-            Tick cur_tick = curTick();
-            ReplaceableEntry *victim = NULL;
-            for (const auto &candidate : candidates)
-            {
-                // Update victim entry if necessary
-                Tick last_tick = std::static_pointer_cast<LRUKReplData>(
-                                     candidate->replacementData)
-                                     ->lastTouchTick;
-                std::vector<Tick> history = std::static_pointer_cast<LRUKReplData>(
-                                                candidate->replacementData)
-                                                ->history;
-                assert(cur_tick >= last_tick);        
-                if (cur_tick - last_tick > CPR)
-                {
-                    if (victim == NULL)
-                    {
-                        victim = candidate;
-                    }
-                    else
-                    {
-                        if (history[k-1] < std::static_pointer_cast<LRUKReplData>(
-                                                victim->replacementData)
-                                                ->history[k-1])
-                        {
-                            victim = candidate;
-                        }
-                        else if (history[k-1] == std::static_pointer_cast<LRUKReplData>(
-                                                victim->replacementData)
-                                                ->history[k-1])
-                        {
-                            if (last_tick < std::static_pointer_cast<LRUKReplData>(
-                                                victim->replacementData)
-                                                ->lastTouchTick)
-                                victim = candidate;
-                        }
-                        
-                    }
-                }
+void
+LRUK::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // Start a history with the insertion as the only reference
+    const Tick cur_tick = curTick();
+    visit(replacement_data.get(),
+          [cur_tick](auto *data) { data->clear(cur_tick); });
+}
+
+template <unsigned K>
+ReplaceableEntry*
+LRUK::findVictim(const ReplacementCandidates& candidates) const
+{
+    // Gather the K-th most recent reference of every candidate that is out
+    // of its correlated reference period. The others cannot be victimized,
+    // so they are given the largest possible key.
+    const Tick cur_tick = curTick();
+    const std::size_t num_candidates = candidates.size();
+    auto key = [&](std::size_t i) -> uint64_t {
+        const LRUKReplData<K> *data = static_cast<LRUKReplData<K>*>(
+            candidates[i]->replacementData.get());
+        assert(cur_tick >= data->lastTouchTick);
+        return cur_tick - data->lastTouchTick > correlatedReferencePeriod ?
+            data->at(K - 1) : MaxTick;
+    };
+
+    // Pick the oldest K-th reference
+    std::size_t first = victim_search::minIndexOf(num_candidates, key);
+    if (key(first) == MaxTick) {
+        // Every candidate is within its correlated reference period, so
+        // fall back to plain LRU
+        return candidates[victim_search::minIndexOf(num_candidates,
+            [&candidates](std::size_t i) -> uint64_t {
+                return static_cast<LRUKReplData<K>*>(
+                    candidates[i]->replacementData.get())->lastTouchTick;
+            })];
+    }
+
+    // Break ties by the last touch tick
+    const Tick victim_key = key(first);
+    ReplaceableEntry *victim = candidates[first];
+    Tick victim_tick = static_cast<LRUKReplData<K>*>(
+        victim->replacementData.get())->lastTouchTick;
+    for (std::size_t i = first + 1; i < num_candidates; i++) {
+        if (key(i) == victim_key) {
+            const Tick tick = static_cast<LRUKReplData<K>*>(
+                candidates[i]->replacementData.get())->lastTouchTick;
+            if (tick < victim_tick) {
+                victim = candidates[i];
+                victim_tick = tick;
             }
-
-            return victim;
         }
+    }
 
-        std::shared_ptr<ReplacementData>
-        LRUK::instantiateEntry()
-        {
-            return std::shared_ptr<ReplacementData>(new LRUKReplData(k));
-        }
+    return victim;
+}
 
-    } // namespace replacement_policy
+ReplaceableEntry*
+LRUK::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    switch (k) {
+      case 2:
+        return findVictim<2>(candidates);
+      case 3:
+        return findVictim<3>(candidates);
+      case 4:
+        return findVictim<4>(candidates);
+      default:
+        panic("Unsupported LRU-K depth %d.", k);
+    }
+}
+
+std::shared_ptr<ReplacementData>
+LRUK::instantiateEntry()
+{
+    switch (k) {
+      case 2:
+        return replDataArena2.allocate();
+      case 3:
+        return replDataArena3.allocate();
+      case 4:
+        return replDataArena4.allocate();
+      default:
+        panic("Unsupported LRU-K depth %d.", k);
+    }
+}
+
+void
+LRUK::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                     std::ostream &os) const
+{
+    visit(replacement_data.get(), [&os](auto *data) {
+        binaryOut(os, data->lastTouchTick);
+        binaryOut(os, data->history, std::size(data->history));
+        binaryOut(os, data->head);
+    });
+}
+
+void
+LRUK::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    visit(replacement_data.get(), [&is](auto *data) {
+        binaryIn(is, data->lastTouchTick);
+        binaryIn(is, data->history, std::size(data->history));
+        binaryIn(is, data->head);
+    });
+}
+
+} // namespace replacement_policy
 } // namespace gem5
@@ -28,92 +28,247 @@
 
 /**
  * @file
- * Declaration of a Least Recently Used replacement policy.
- * The victim is chosen using the last touch timestamp.
+ * Declaration of an LRU-K replacement policy, as described in "The LRU-K
+ * page replacement algorithm for database disk buffering", by O'Neil,
+ * O'Neil and Weikum.
+ *
+ * Every entry remembers the times of its last K uncorrelated references.
+ * References that happen within a correlated reference period of the
+ * previous one are considered part of the same burst, and only update the
+ * time of the last reference. The victim is the entry whose K-th most recent
+ * reference is the oldest, among the entries that are not within their
+ * correlated reference period.
+ *
+ * The history is kept in a fixed-size ring inside the replacement data,
+ * whose size is a template parameter, so that the access path does not
+ * allocate or copy memory.
  */
 
-#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
-#define __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_LRUK_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_LRUK_RP_HH__
 
+#include "base/logging.hh"
+#include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
-#include <unordered_map>
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
 
-    struct LRUKRPParams;
+struct LRUKRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
 
-    GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
-    namespace replacement_policy
+class LRUK : public Base
+{
+  protected:
+    /**
+     * LRUK-specific implementation of replacement data.
+     *
+     * @tparam K Number of references remembered.
+     */
+    template <unsigned K>
+    struct LRUKReplData : ReplacementData
     {
+        static_assert(K >= 2 && K <= 4, "Unsupported LRU-K depth");
+
+        /** Tick on which the entry was last touched. */
+        Tick lastTouchTick;
+
+        /**
+         * Ticks of the last K uncorrelated references, as a ring whose
+         * most recent element is at head.
+         */
+        Tick history[K];
+
+        /** Position of the most recent reference in the history. */
+        uint8_t head;
 
-        class LRUK : public Base
+        /**
+         * Default constructor. Invalidate data.
+         */
+        LRUKReplData() { clear(0); }
+
+        /**
+         * Get the time of a past reference.
+         *
+         * @param i Age of the reference; 0 is the most recent one.
+         * @return The tick of the reference.
+         */
+        Tick&
+        at(unsigned i)
+        {
+            const unsigned pos = head + i;
+            return history[pos >= K ? pos - K : pos];
+        }
+
+        Tick
+        at(unsigned i) const
+        {
+            const unsigned pos = head + i;
+            return history[pos >= K ? pos - K : pos];
+        }
+
+        /** Forget all references but one, made at the given tick. */
+        void
+        clear(Tick tick)
+        {
+            for (unsigned i = 0; i < K; i++) {
+                history[i] = 0;
+            }
+            head = 0;
+            history[0] = tick;
+            lastTouchTick = tick;
+        }
+
+        /**
+         * Record a new uncorrelated reference. The older references are
+         * shifted back in the history, and moved forward in time by the
+         * correlated period of the previous reference, so that a burst of
+         * correlated references counts as a single one.
+         *
+         * @param tick The tick of the new reference.
+         */
+        void
+        push(Tick tick)
         {
-        protected:
-            /** LRUK-specific implementation of replacement data. */
-            struct LRUKReplData : ReplacementData
-            {
-                /** Tick on which the entry was last touched. */
-                Tick lastTouchTick;
-                std::vector<Tick> history;
-                /**
-                 * Default constructor. Invalidate data.
-                 */
-                LRUKReplData(int size) : lastTouchTick(0) {history.assign(size, 0);}
-            };
-
-            int k = 2;
-            int CPR = 10; // correlated reference period 
-        public:
-            typedef LRUKRPParams Params;
-            LRUK(const Params &p);
-            ~LRUK() = default;
-
-            /**
-             * Invalidate replacement data to set it as the next probable victim.
-             * Sets its last touch tick as the starting tick.
-             *
-             * @param replacement_data Replacement data to be invalidated.
-             */
-            void invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
-                override;
-
-            /**
-             * Touch an entry to update its replacement data.
-             * Sets its last touch tick as the current tick.
-             *
-             * @param replacement_data Replacement data to be touched.
-             */
-            void touch(const std::shared_ptr<ReplacementData> &replacement_data) const
-                override;
-
-            /**
-             * Reset replacement data. Used when an entry is inserted.
-             * Sets its last touch tick as the current tick.
-             *
-             * @param replacement_data Replacement data to be reset.
-             */
-            void reset(const std::shared_ptr<ReplacementData> &replacement_data) const
-                override;
-
-            /**
-             * Find replacement victim using LRUK timestamps.
-             *
-             * @param candidates Replacement candidates, selected by indexing policy.
-             * @return Replacement entry to be replaced.
-             */
-            ReplaceableEntry *getVictim(const ReplacementCandidates &candidates) const
-                override;
-
-            /**
-             * Instantiate a replacement data entry.
-             *
-             * @return A shared pointer to the new replacement data.
-             */
-            std::shared_ptr<ReplacementData> instantiateEntry() override;
-        };
-
-    } // namespace replacement_policy
+            const Tick correl_period = lastTouchTick - at(0);
+            for (unsigned i = 0; i < K - 1; i++) {
+                at(i) += correl_period;
+            }
+            head = head == 0 ? K - 1 : head - 1;
+            history[head] = tick;
+            lastTouchTick = tick;
+        }
+    };
+
+    /** Number of references remembered per entry (K). */
+    const unsigned k;
+
+    /** Correlated reference period, in ticks. */
+    const Tick correlatedReferencePeriod;
+
+    /** Storage for the replacement data of all entries, one per depth. */
+    ReplacementDataArena<LRUKReplData<2>> replDataArena2;
+    ReplacementDataArena<LRUKReplData<3>> replDataArena3;
+    ReplacementDataArena<LRUKReplData<4>> replDataArena4;
+
+    /**
+     * Cast replacement data to the type used for the configured K, and call
+     * a function on it.
+     *
+     * @param replacement_data The replacement data.
+     * @param visitor Function called with the cast replacement data.
+     * @return What the function returned.
+     */
+    template <class Visitor>
+    auto
+    visit(ReplacementData *replacement_data, Visitor &&visitor) const
+    {
+        switch (k) {
+          case 2:
+            return visitor(
+                static_cast<LRUKReplData<2>*>(replacement_data));
+          case 3:
+            return visitor(
+                static_cast<LRUKReplData<3>*>(replacement_data));
+          case 4:
+            return visitor(
+                static_cast<LRUKReplData<4>*>(replacement_data));
+          default:
+            panic("Unsupported LRU-K depth %d.", k);
+        }
+    }
+
+    /**
+     * Find replacement victim using the history of the candidates.
+     *
+     * @tparam K Number of references remembered.
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    template <unsigned K>
+    ReplaceableEntry*
+    findVictim(const ReplacementCandidates& candidates) const;
+
+  public:
+    typedef LRUKRPParams Params;
+    LRUK(const Params &p);
+    ~LRUK() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Clears its history.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Records a reference in its history if it is not correlated with the
+     * previous one, and updates its last touch tick.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Starts a history with a single reference at the current tick.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim using the LRU-K history. If every candidate
+     * is within its correlated reference period, the least recently used
+     * candidate is chosen instead.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its last touch tick and reference history.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
 } // namespace gem5
 
-#endif // __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_LRUK_RP_HH__
@@ -31,6 +31,8 @@
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
 #include "params/MRURP.hh"
 #include "sim/cur_tick.hh"
 
@@ -50,24 +52,24 @@ void
 MRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<MRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
+    static_cast<MRUReplData*>(
+        replacement_data.get())->lastTouchTick = Tick(0);
 }
 
 void
 MRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<MRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<MRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 void
 MRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<MRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<MRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 ReplaceableEntry*
@@ -76,24 +78,16 @@ MRU::getVictim(const ReplacementCandidates& candidates) const
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
-    // Visit all candidates to find victim
-    ReplaceableEntry* victim = candidates[0];
-    for (const auto& candidate : candidates) {
-        std::shared_ptr<MRUReplData> candidate_replacement_data =
-            std::static_pointer_cast<MRUReplData>(candidate->replacementData);
-
-        // Stop searching entry if a cache line that doesn't warm up is found.
-        if (candidate_replacement_data->lastTouchTick == 0) {
-            victim = candidate;
-            break;
-        } else if (candidate_replacement_data->lastTouchTick >
-                std::static_pointer_cast<MRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
-            victim = candidate;
-        }
-    }
-
-    return victim;
+    // Gather the last touch timestamps and pick the most recent. Entries
+    // that have never been touched are chosen first, so they are given the
+    // largest possible key; only the first of them can be picked, as in a
+    // search that stops on the first untouched entry.
+    return candidates[victim_search::maxIndexOf(candidates.size(),
+        [&candidates](std::size_t i) -> uint64_t {
+            const Tick tick = static_cast<const MRUReplData*>(
+                candidates[i]->replacementData.get())->lastTouchTick;
+            return tick == 0 ? MaxTick : tick;
+        })];
 }
 
 std::shared_ptr<ReplacementData>
@@ -102,5 +96,22 @@ MRU::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new MRUReplData());
 }
 
+void
+MRU::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    std::ostream &os) const
+{
+    binaryOut(os, static_cast<const MRUReplData*>(
+        replacement_data.get())->lastTouchTick);
+}
+
+void
+MRU::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    binaryIn(is, static_cast<MRUReplData*>(
+        replacement_data.get())->lastTouchTick);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
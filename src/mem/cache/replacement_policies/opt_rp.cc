@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/opt_rp.hh"
+
+#include <cassert>
+#include <memory>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/victim_search.hh"
+#include "params/OPTRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+OPT::OPTStats::OPTStats(OPT &opt)
+  : statistics::Group(&opt),
+    ADD_STAT(matchedAccesses, statistics::units::Count::get(),
+             "Number of accesses matched with the trace"),
+    ADD_STAT(unmatchedAccesses, statistics::units::Count::get(),
+             "Number of accesses that could not be found in the trace"),
+    ADD_STAT(skippedAccesses, statistics::units::Count::get(),
+             "Number of accesses of the trace skipped to match an access")
+{
+}
+
+OPT::OPT(const Params &p)
+  : Base(p), trace(p.trace_file, p.block_size), blockSize(p.block_size),
+    resyncDistance(p.resync_distance), window(p.window),
+    windowMask(p.window - 1), position(0), numRead(0), traceDone(false),
+    stats(*this)
+{
+    fatal_if(!isPowerOf2(p.window), "The trace window of OPT must be a "
+             "power of 2.");
+    fatal_if(resyncDistance >= p.window, "The resynchronization distance "
+             "of OPT must be smaller than its trace window.");
+
+    lastAccess.reserve(p.window);
+    fillWindow();
+}
+
+void
+OPT::fillWindow()
+{
+    while (!traceDone && numRead < position + window.size()) {
+        Addr block;
+        Tick tick;
+        if (!trace.next(block, tick)) {
+            traceDone = true;
+            break;
+        }
+
+        const uint64_t pos = numRead++;
+        window[pos & windowMask] = TraceAccess{block, NotReused};
+
+        auto it = lastAccess.find(block);
+        if (it != lastAccess.end()) {
+            // Link the previous access of the window to this one
+            window[it->second & windowMask].nextAccess = pos;
+            it->second = pos;
+        } else {
+            lastAccess.emplace(block, pos);
+
+            // The previous access was before the window, so if the block
+            // is resident its entry is waiting to learn about this one
+            auto waiting = awaitingReuse.find(block);
+            if (waiting != awaitingReuse.end()) {
+                waiting->second->nextAccess = pos;
+                awaitingReuse.erase(waiting);
+            }
+        }
+    }
+}
+
+uint64_t
+OPT::advance(Addr block)
+{
+    // Look for the access, usually at the expected position
+    uint64_t pos = position;
+    const uint64_t end = std::min(numRead, position + resyncDistance + 1);
+    while (pos < end && window[pos & windowMask].block != block) {
+        pos++;
+    }
+    if (pos == end) {
+        stats.unmatchedAccesses++;
+        return NotReused;
+    }
+    stats.matchedAccesses++;
+    stats.skippedAccesses += pos - position;
+
+    // Move past the access, forgetting the blocks whose last access in the
+    // window is left behind
+    for (; position <= pos; position++) {
+        const Addr past = window[position & windowMask].block;
+        auto it = lastAccess.find(past);
+        if (it->second == position) {
+            lastAccess.erase(it);
+        }
+    }
+    const uint64_t next_access = window[pos & windowMask].nextAccess;
+    fillWindow();
+    return next_access;
+}
+
+void
+OPT::forgetReuse(OPTReplData *data)
+{
+    if (data->nextAccess == NotReused) {
+        auto it = awaitingReuse.find(data->block);
+        if (it != awaitingReuse.end() && it->second == data) {
+            awaitingReuse.erase(it);
+        }
+    }
+}
+
+void
+OPT::access(OPTReplData *data, const AccessContext &ctx)
+{
+    forgetReuse(data);
+
+    data->block = ctx.addr & ~Addr(blockSize - 1);
+    data->nextAccess = advance(data->block);
+    if (data->nextAccess == NotReused) {
+        awaitingReuse[data->block] = data;
+    }
+}
+
+void
+OPT::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    OPTReplData *data = static_cast<OPTReplData*>(replacement_data.get());
+    forgetReuse(data);
+    data->nextAccess = Invalid;
+}
+
+void
+OPT::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    access(static_cast<OPTReplData*>(replacement_data.get()), ctx);
+}
+
+void
+OPT::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("OPT cannot touch an entry without access information.");
+}
+
+void
+OPT::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const AccessContext &ctx)
+{
+    access(static_cast<OPTReplData*>(replacement_data.get()), ctx);
+}
+
+void
+OPT::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("OPT cannot insert an entry without access information.");
+}
+
+ReplaceableEntry*
+OPT::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    return candidates[victim_search::maxIndexOf(candidates.size(),
+        [this, &candidates](std::size_t i) -> uint64_t {
+            const uint64_t next_access = static_cast<OPTReplData*>(
+                candidates[i]->replacementData.get())->nextAccess;
+            // The next access of a block may have been skipped to match
+            // another access, in which case its actual next access is
+            // unknown
+            return next_access < position ? NotReused : next_access;
+        })];
+}
+
+std::shared_ptr<ReplacementData>
+OPT::instantiateEntry()
+{
+    return replDataArena.allocate();
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of an oracle replacement policy implementing Belady's OPT
+ * (MIN) algorithm, as described in "A Study of Replacement Algorithms for
+ * a Virtual-Storage Computer", by Belady.
+ *
+ * The policy evicts the block whose next access is furthest in the future.
+ * The future is read from a packet trace of the accesses to the cache,
+ * recorded by a MemTraceProbe in a previous run of the same workload, so it
+ * is only meaningful as an upper bound on what a realizable policy can
+ * achieve.
+ *
+ * Only a window of the trace is kept in memory: every access of the window
+ * is linked to the next access to the same block, and the last access to
+ * every block of the window is kept in a hash table. Accesses to the cache
+ * are matched with the trace in order; an access that does not match the
+ * next access of the trace is looked for a few accesses ahead, to tolerate
+ * small reorderings between the recorded and the simulated runs. Each entry
+ * keeps the position in the trace of the next access to its block, so a hit
+ * and an insertion take a constant amount of work, and a victim is found
+ * with a vectorized search for the furthest next access of the set.
+ *
+ * The policy must be driven through the AccessContext interface.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/access_trace.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
+
+namespace gem5
+{
+
+struct OPTRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+class OPT : public Base
+{
+  protected:
+    /** Next access of an invalid entry; invalid entries are evicted first. */
+    static constexpr uint64_t Invalid = UINT64_MAX;
+
+    /**
+     * Next access of a block that is not accessed again within the window,
+     * or at all.
+     */
+    static constexpr uint64_t NotReused = UINT64_MAX - 1;
+
+    /** OPT-specific implementation of replacement data. */
+    struct OPTReplData : ReplacementData
+    {
+        /** Address of the block. */
+        Addr block;
+
+        /** Position in the trace of the next access to the block. */
+        uint64_t nextAccess;
+
+        /**
+         * Default constructor. Invalidate data.
+         */
+        OPTReplData() : block(0), nextAccess(Invalid) {}
+    };
+
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<OPTReplData> replDataArena;
+
+    /** An access of the trace. */
+    struct TraceAccess
+    {
+        /** Address of the block accessed. */
+        Addr block;
+
+        /** Position in the trace of the next access to the block. */
+        uint64_t nextAccess;
+    };
+
+    /** The trace of the accesses to the cache. */
+    AccessTraceReader trace;
+
+    /** Block size in bytes. */
+    const unsigned blockSize;
+
+    /**
+     * Number of accesses ahead of the expected one in which an access is
+     * looked for before it is considered to be missing from the trace.
+     */
+    const unsigned resyncDistance;
+
+    /**
+     * Window of the trace, as a ring buffer indexed by position in the
+     * trace. It holds the accesses from the expected one onwards.
+     */
+    std::vector<TraceAccess> window;
+
+    /** Mask that maps a position in the trace to its slot in the window. */
+    const uint64_t windowMask;
+
+    /** Position in the trace of the next expected access. */
+    uint64_t position;
+
+    /** Number of accesses read from the trace. */
+    uint64_t numRead;
+
+    /** Whether the end of the trace was reached. */
+    bool traceDone;
+
+    /**
+     * Position of the last access to every block that is accessed in the
+     * window from the expected access onwards.
+     */
+    std::unordered_map<Addr, uint64_t> lastAccess;
+
+    /**
+     * Resident blocks whose next access was not in the window when they
+     * were accessed. They learn about it when it is read from the trace.
+     */
+    std::unordered_map<Addr, OPTReplData*> awaitingReuse;
+
+    struct OPTStats : public statistics::Group
+    {
+        OPTStats(OPT &opt);
+
+        /** Accesses matched with the trace. */
+        statistics::Scalar matchedAccesses;
+
+        /** Accesses that could not be found in the trace. */
+        statistics::Scalar unmatchedAccesses;
+
+        /** Accesses of the trace skipped to match an access. */
+        statistics::Scalar skippedAccesses;
+    } stats;
+
+    /** Read accesses from the trace until the window is full. */
+    void fillWindow();
+
+    /**
+     * Match an access to the cache with the trace, and move past it.
+     *
+     * @param block Address of the block accessed.
+     * @return Position in the trace of the next access to the block.
+     */
+    uint64_t advance(Addr block);
+
+    /**
+     * Update the replacement data of an entry that was accessed.
+     *
+     * @param data Replacement data of the entry.
+     * @param ctx The access.
+     */
+    void access(OPTReplData *data, const AccessContext &ctx);
+
+    /**
+     * Stop waiting for the next access to the block of an entry.
+     *
+     * @param data Replacement data of the entry.
+     */
+    void forgetReuse(OPTReplData *data);
+
+  public:
+    typedef OPTRPParams Params;
+    OPT(const Params &p);
+    ~OPT() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Records the next access to the block, and moves past the access in
+     * the trace.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param ctx The access that hit on this entry.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Records the next access to the block, and moves past the access in
+     * the trace.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param ctx The access that caused the insertion.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const AccessContext &ctx) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim. Invalid entries are chosen first; otherwise
+     * the block accessed furthest in the future is chosen.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
@@ -31,6 +31,7 @@
 #include <cassert>
 #include <memory>
 
+#include "base/binary_io.hh"
 #include "base/random.hh"
 #include "params/RandomRP.hh"
 
@@ -96,5 +97,23 @@ Random::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new RandomReplData());
 }
 
+void
+Random::serializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::ostream &os) const
+{
+    binaryOut(os, static_cast<const RandomReplData*>(
+        replacement_data.get())->valid);
+}
+
+void
+Random::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    binaryIn(is, static_cast<RandomReplData*>(
+        replacement_data.get())->valid);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Contiguous storage for the replacement data of a replacement policy.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Allocates the replacement data of a policy in large, cache-line aligned
+ * chunks instead of with one heap allocation per entry.
+ *
+ * The tables instantiate their entries set by set, so the replacement data
+ * of a set ends up in consecutive elements of a chunk, and choosing a
+ * victim only walks a few contiguous cache lines. As long as the chunk size
+ * is a multiple of the associativity, which holds for the usual powers of
+ * two, no set is split between chunks.
+ *
+ * The handles returned are regular shared pointers that share ownership of
+ * the whole chunk, so tables keep using them as before, and a chunk is
+ * freed once the last of its entries is released.
+ *
+ * @tparam T The policy-specific replacement data type.
+ */
+template <class T>
+class ReplacementDataArena
+{
+  private:
+    /** Alignment of the chunks, in bytes. */
+    static constexpr std::size_t Alignment = 64;
+
+    /** A block of storage for entries, constructed in order. */
+    class Chunk
+    {
+      private:
+        /** Maximum number of entries. */
+        const std::size_t capacity;
+
+        /** Number of entries constructed so far. */
+        std::size_t used;
+
+        /** Storage for the entries. */
+        T *entries;
+
+      public:
+        Chunk(std::size_t _capacity)
+          : capacity(_capacity), used(0),
+            entries(static_cast<T*>(::operator new(capacity * sizeof(T),
+                std::align_val_t(Alignment))))
+        {
+        }
+
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+
+        ~Chunk()
+        {
+            for (std::size_t i = 0; i < used; i++) {
+                entries[i].~T();
+            }
+            ::operator delete(entries, std::align_val_t(Alignment));
+        }
+
+        bool full() const { return used == capacity; }
+
+        template <class... Args>
+        T*
+        emplace(Args&&... args)
+        {
+            assert(!full());
+            T* entry = new (&entries[used]) T(std::forward<Args>(args)...);
+            used++;
+            return entry;
+        }
+    };
+
+    /** Number of entries per chunk. */
+    const std::size_t chunkSize;
+
+    /** The chunk being filled. */
+    std::shared_ptr<Chunk> current;
+
+  public:
+    /**
+     * @param chunk_size Number of entries allocated at once.
+     */
+    ReplacementDataArena(std::size_t chunk_size = 1024)
+      : chunkSize(chunk_size)
+    {
+        fatal_if(chunkSize == 0, "Replacement data chunks cannot be empty.");
+    }
+
+    /**
+     * Construct a replacement data entry in the next free slot.
+     *
+     * @param args Arguments forwarded to the constructor of the entry.
+     * @return A shared pointer to the new replacement data.
+     */
+    template <class... Args>
+    std::shared_ptr<ReplacementData>
+    allocate(Args&&... args)
+    {
+        if (!current || current->full()) {
+            current = std::make_shared<Chunk>(chunkSize);
+        }
+        T* entry = current->emplace(std::forward<Args>(args)...);
+        return std::shared_ptr<ReplacementData>(current, entry);
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
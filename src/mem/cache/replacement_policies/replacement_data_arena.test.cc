@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+/** Replacement data that counts how many instances are alive. */
+struct CountedReplData : ReplacementData
+{
+    static int alive;
+
+    uint64_t value;
+
+    CountedReplData(uint64_t _value) : value(_value) { alive++; }
+    ~CountedReplData() { alive--; }
+};
+
+int CountedReplData::alive = 0;
+
+} // anonymous namespace
+
+/** Entries allocated in sequence must be adjacent in memory. */
+TEST(ReplacementDataArenaTest, ContiguousEntries)
+{
+    ReplacementDataArena<CountedReplData> arena(8);
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (uint64_t i = 0; i < 8; i++) {
+        entries.push_back(arena.allocate(i));
+    }
+
+    auto first = static_cast<CountedReplData*>(entries[0].get());
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % 64, 0);
+    for (uint64_t i = 0; i < 8; i++) {
+        auto entry = static_cast<CountedReplData*>(entries[i].get());
+        ASSERT_EQ(entry, first + i);
+        ASSERT_EQ(entry->value, i);
+    }
+}
+
+/** A full chunk makes the arena start a new, aligned one. */
+TEST(ReplacementDataArenaTest, NewChunkWhenFull)
+{
+    ReplacementDataArena<CountedReplData> arena(2);
+    auto a = arena.allocate(0);
+    auto b = arena.allocate(1);
+    auto c = arena.allocate(2);
+
+    ASSERT_EQ(static_cast<CountedReplData*>(b.get()),
+              static_cast<CountedReplData*>(a.get()) + 1);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(c.get()) % 64, 0);
+    ASSERT_EQ(static_cast<CountedReplData*>(c.get())->value, 2);
+}
+
+/** A chunk is only destroyed when all of its entries are released. */
+TEST(ReplacementDataArenaTest, SharedOwnership)
+{
+    std::shared_ptr<ReplacementData> kept;
+    {
+        ReplacementDataArena<CountedReplData> arena(4);
+        auto a = arena.allocate(0);
+        kept = arena.allocate(1);
+        ASSERT_EQ(CountedReplData::alive, 2);
+    }
+
+    // The arena and the other handle are gone, but the chunk is alive
+    ASSERT_EQ(CountedReplData::alive, 2);
+    ASSERT_EQ(static_cast<CountedReplData*>(kept.get())->value, 1);
+
+    kept.reset();
+    ASSERT_EQ(CountedReplData::alive, 0);
+}
@@ -30,6 +30,7 @@
 
 #include <cassert>
 
+#include "base/binary_io.hh"
 #include "params/SecondChanceRP.hh"
 
 namespace gem5
@@ -138,5 +139,25 @@ SecondChance::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new SecondChanceReplData());
 }
 
+void
+SecondChance::serializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::ostream &os) const
+{
+    FIFO::serializeEntry(replacement_data, os);
+    binaryOut(os, static_cast<const SecondChanceReplData*>(
+        replacement_data.get())->hasSecondChance);
+}
+
+void
+SecondChance::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    FIFO::unserializeEntry(replacement_data, is);
+    binaryIn(is, static_cast<SecondChanceReplData*>(
+        replacement_data.get())->hasSecondChance);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
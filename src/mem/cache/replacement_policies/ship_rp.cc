@@ -28,6 +28,7 @@
 
 #include "mem/cache/replacement_policies/ship_rp.hh"
 
+#include "base/binary_io.hh"
 #include "base/logging.hh"
 #include "params/SHiPMemRP.hh"
 #include "params/SHiPPCRP.hh"
@@ -78,8 +79,8 @@ SHiP::SHiP(const Params &p)
 void
 SHiP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData* casted_replacement_data =
+        static_cast<SHiPReplData*>(replacement_data.get());
 
     // The predictor is detrained when an entry that has not been re-
     // referenced since insertion is invalidated
@@ -92,14 +93,14 @@ SHiP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 
 void
 SHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data,
-    const PacketPtr pkt)
+    const AccessContext &ctx)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData* casted_replacement_data =
+        static_cast<SHiPReplData*>(replacement_data.get());
 
     // When a hit happens the SHCT entry indexed by the signature is
     // incremented
-    SHCT[getSignature(pkt)]++;
+    SHCT[getSignature(ctx)]++;
     casted_replacement_data->setReReferenced();
 
     // This was a hit; update replacement data accordingly
@@ -115,13 +116,13 @@ SHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data)
 
 void
 SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data,
-    const PacketPtr pkt)
+    const AccessContext &ctx)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData* casted_replacement_data =
+        static_cast<SHiPReplData*>(replacement_data.get());
 
     // Get signature
-    const SignatureType signature = getSignature(pkt);
+    const SignatureType signature = getSignature(ctx);
 
     // Store signature
     casted_replacement_data->setSignature(signature);
@@ -144,26 +145,27 @@ SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
 std::shared_ptr<ReplacementData>
 SHiP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SHiPReplData(numRRPVBits));
+    return shipReplDataArena.allocate(numRRPVBits);
 }
 
 SHiPMem::SHiPMem(const SHiPMemRPParams &p) : SHiP(p) {}
 
 SHiP::SignatureType
-SHiPMem::getSignature(const PacketPtr pkt) const
+SHiPMem::getSignature(const AccessContext &ctx) const
 {
-    return static_cast<SignatureType>(pkt->getAddr() % SHCT.size());
+    panic_if(ctx.addr == MaxAddr, "SHiPMem needs the accessed address.");
+    return static_cast<SignatureType>(ctx.addr % SHCT.size());
 }
 
 SHiPPC::SHiPPC(const SHiPPCRPParams &p) : SHiP(p) {}
 
 SHiP::SignatureType
-SHiPPC::getSignature(const PacketPtr pkt) const
+SHiPPC::getSignature(const AccessContext &ctx) const
 {
     SignatureType signature;
 
-    if (pkt->req->hasPC()) {
-        signature = static_cast<SignatureType>(pkt->req->getPC());
+    if (ctx.pc != MaxAddr) {
+        signature = static_cast<SignatureType>(ctx.pc);
     } else {
         signature = NO_PC_SIGNATURE;
     }
@@ -171,5 +173,51 @@ SHiPPC::getSignature(const PacketPtr pkt) const
     return signature % SHCT.size();
 }
 
+void
+SHiP::serializeEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                     std::ostream &os) const
+{
+    BRRIP::serializeEntry(replacement_data, os);
+    const SHiPReplData* casted_replacement_data =
+        static_cast<const SHiPReplData*>(replacement_data.get());
+    binaryOut(os, static_cast<uint64_t>(
+        casted_replacement_data->getSignature()));
+    binaryOut(os, casted_replacement_data->wasReReferenced());
+}
+
+void
+SHiP::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    BRRIP::unserializeEntry(replacement_data, is);
+    SHiPReplData* casted_replacement_data =
+        static_cast<SHiPReplData*>(replacement_data.get());
+    casted_replacement_data->setSignature(binaryIn<uint64_t>(is));
+    if (binaryIn<bool>(is)) {
+        casted_replacement_data->setReReferenced();
+    }
+}
+
+void
+SHiP::serializeState(std::ostream &os) const
+{
+    binaryOut(os, static_cast<uint64_t>(SHCT.size()));
+    for (const auto &counter : SHCT) {
+        binaryOut(os, static_cast<uint8_t>(counter));
+    }
+}
+
+void
+SHiP::unserializeState(std::istream &is)
+{
+    const uint64_t size = binaryIn<uint64_t>(is);
+    fatal_if(size != SHCT.size(), "Checkpointed SHCT has %d entries, but "
+             "the table has %d.", size, SHCT.size());
+    for (auto &counter : SHCT) {
+        counter.set(binaryIn<uint8_t>(is));
+    }
+}
+
 } // namespace replacement_policy
 } // namespace gem5
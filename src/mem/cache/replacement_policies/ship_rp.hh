@@ -42,6 +42,7 @@
 #include "base/compiler.hh"
 #include "base/sat_counter.hh"
 #include "mem/cache/replacement_policies/brrip_rp.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -94,6 +95,9 @@ class SHiP : public BRRIP
         bool wasReReferenced() const;
     };
 
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<SHiPReplData> shipReplDataArena;
+
     /**
      * Saturation percentage at which an entry starts being inserted as
      * intermediate re-reference.
@@ -108,12 +112,12 @@ class SHiP : public BRRIP
     std::vector<SatCounter8> SHCT;
 
     /**
-     * Extract signature from packet.
+     * Extract signature from an access.
      *
-     * @param pkt The packet to extract a signature from.
+     * @param ctx The access to extract a signature from.
      * @return The signature extracted.
      */
-    virtual SignatureType getSignature(const PacketPtr pkt) const = 0;
+    virtual SignatureType getSignature(const AccessContext &ctx) const = 0;
 
   public:
     typedef SHiPRPParams Params;
@@ -134,10 +138,10 @@ class SHiP : public BRRIP
      * Updates predictor and assigns RRPV values of Table 3.
      *
      * @param replacement_data Replacement data to be touched.
-     * @param pkt Packet that generated this hit.
+     * @param ctx The access that generated this hit.
      */
     void touch(const std::shared_ptr<ReplacementData>& replacement_data,
-        const PacketPtr pkt) override;
+        const AccessContext &ctx) override;
     void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
         override;
 
@@ -146,13 +150,48 @@ class SHiP : public BRRIP
      * Updates predictor and assigns RRPV values of Table 3.
      *
      * @param replacement_data Replacement data to be reset.
-     * @param pkt Packet that generated this miss.
+     * @param ctx The access that generated this miss.
      */
     void reset(const std::shared_ptr<ReplacementData>& replacement_data,
-        const PacketPtr pkt) override;
+        const AccessContext &ctx) override;
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         override;
 
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its RRPV, valid flag, signature and outcome.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
+    /**
+     * Write the signature history counter table.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeState(std::ostream &os) const override;
+
+    /**
+     * Restore the state written by serializeState().
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeState(std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry.
      *
@@ -165,7 +204,7 @@ class SHiP : public BRRIP
 class SHiPMem : public SHiP
 {
   protected:
-    SignatureType getSignature(const PacketPtr pkt) const override;
+    SignatureType getSignature(const AccessContext &ctx) const override;
 
   public:
     SHiPMem(const SHiPMemRPParams &p);
@@ -180,7 +219,7 @@ class SHiPPC : public SHiP
     const SignatureType NO_PC_SIGNATURE = 0;
 
   protected:
-    SignatureType getSignature(const PacketPtr pkt) const override;
+    SignatureType getSignature(const AccessContext &ctx) const override;
 
   public:
     SHiPPC(const SHiPPCRPParams &p);
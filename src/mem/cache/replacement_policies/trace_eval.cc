@@ -0,0 +1,589 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Offline evaluation of replacement policies against a recorded trace of
+ * the accesses to a cache, in the packet.proto format of MemTraceProbe.
+ *
+ * The trace is replayed against every combination of the given replacement
+ * policies, cache sizes and associativities, using the same policy and
+ * indexing policy code as the simulator, and the miss ratio of each
+ * configuration is reported. Configurations are simulated in parallel.
+ *
+ * Usage:
+ *   repl_trace_eval [options] <trace file>
+ *
+ *   --policies=P1,P2,...  Policies to evaluate, by SimObject name. Policy
+ *                         parameters are given as LRUKRP:k=3;btp=50.
+ *                         OPTRP reads its future accesses from the trace
+ *                         being evaluated.
+ *   --sizes=S1,S2,...     Cache sizes, such as 32KiB,1MiB.
+ *   --assocs=A1,A2,...    Associativities.
+ *   --block-size=N        Block size in bytes (64).
+ *   --warmup=N            Number of accesses not counted (0).
+ *   --threads=N           Number of worker threads.
+ *   --csv                 Print the results as CSV.
+ */
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/str.hh"
+#include "base/types.hh"
+#include "config/have_protobuf.hh"
+#include "mem/cache/replacement_policies/arc_rp.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/bip_rp.hh"
+#include "mem/cache/replacement_policies/brrip_rp.hh"
+#include "mem/cache/replacement_policies/clock_pro_rp.hh"
+#include "mem/cache/replacement_policies/fifo_rp.hh"
+#include "mem/cache/replacement_policies/lfu_rp.hh"
+#include "mem/cache/replacement_policies/lirs_rp.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/replacement_policies/lruk_rp.hh"
+#include "mem/cache/replacement_policies/mru_rp.hh"
+#include "mem/cache/replacement_policies/random_rp.hh"
+#include "mem/cache/replacement_policies/second_chance_rp.hh"
+#include "mem/cache/replacement_policies/tree_plru_rp.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/tag_only_array.hh"
+#include "params/ARCRP.hh"
+#include "params/BIPRP.hh"
+#include "params/BRRIPRP.hh"
+#include "params/CLOCKProRP.hh"
+#include "params/FIFORP.hh"
+#include "params/LFURP.hh"
+#include "params/LIRSRP.hh"
+#include "params/LRUKRP.hh"
+#include "params/LRURP.hh"
+#include "params/MRURP.hh"
+#include "params/RandomRP.hh"
+#include "params/SecondChanceRP.hh"
+#include "params/SetAssociative.hh"
+#include "params/TreePLRURP.hh"
+
+#if HAVE_PROTOBUF
+#include "mem/cache/replacement_policies/access_trace.hh"
+#include "mem/cache/replacement_policies/opt_rp.hh"
+#include "params/OPTRP.hh"
+#endif
+
+using namespace gem5;
+
+namespace
+{
+
+/** Parameters of a policy, as given on the command line. */
+typedef std::map<std::string, std::string> PolicyArgs;
+
+/** A policy together with the parameters it refers to. */
+struct PolicyInstance
+{
+    std::shared_ptr<SimObjectParams> params;
+    std::unique_ptr<replacement_policy::Base> policy;
+};
+
+/** How to build a policy for a cache of a given associativity. */
+struct PolicyFactory
+{
+    /**
+     * Whether the policy draws from the global random number generator,
+     * which is not thread safe.
+     */
+    bool usesGlobalRandom;
+
+    std::function<PolicyInstance(const PolicyArgs &args, unsigned assoc)>
+        create;
+};
+
+/** Get a numeric policy parameter, or its default value. */
+template <class T>
+T
+getArg(const PolicyArgs &args, const std::string &key, T default_value)
+{
+    auto it = args.find(key);
+    if (it == args.end()) {
+        return default_value;
+    }
+    T value;
+    if (!to_number(it->second, value)) {
+        fprintf(stderr, "Invalid value '%s' for parameter '%s'.\n",
+                it->second.c_str(), key.c_str());
+        std::exit(1);
+    }
+    return value;
+}
+
+/**
+ * Build a factory for a policy whose parameters are set by a function.
+ *
+ * @tparam Policy The policy class.
+ * @tparam Params Its parameter class.
+ */
+template <class Policy, class Params>
+PolicyFactory
+factory(bool uses_global_random,
+        std::function<void(Params&, const PolicyArgs&, unsigned)> setup =
+        nullptr)
+{
+    return PolicyFactory{uses_global_random,
+        [setup](const PolicyArgs &args, unsigned assoc) {
+            auto params = std::make_shared<Params>();
+            params->name = "replacement_policy";
+            params->eventq_index = 0;
+            if (setup) {
+                setup(*params, args, assoc);
+            }
+            PolicyInstance instance;
+            instance.policy.reset(new Policy(*params));
+            instance.params = std::move(params);
+            return instance;
+        }};
+}
+
+/**
+ * The policies that can be evaluated. Parameters that are not given take
+ * the default values of the SimObjects.
+ */
+const std::map<std::string, PolicyFactory> &
+policyFactories()
+{
+    using namespace replacement_policy;
+
+    auto btp = [](int default_btp) {
+        return [default_btp](BIPRPParams &p, const PolicyArgs &args,
+                             unsigned) {
+            p.btp = getArg(args, "btp", default_btp);
+        };
+    };
+    auto rrip = [](int default_bits, int default_btp) {
+        return [default_bits, default_btp](BRRIPRPParams &p,
+                                           const PolicyArgs &args,
+                                           unsigned) {
+            p.num_bits = getArg(args, "num_bits", default_bits);
+            p.hit_priority = getArg(args, "hit_priority", 0) != 0;
+            p.btp = getArg(args, "btp", default_btp);
+        };
+    };
+
+    static const std::map<std::string, PolicyFactory> factories = {
+        {"ARCRP", factory<ARC, ARCRPParams>(false)},
+        {"BIPRP", factory<BIP, BIPRPParams>(true, btp(3))},
+        {"BRRIPRP", factory<BRRIP, BRRIPRPParams>(true, rrip(2, 3))},
+        {"CLOCKProRP", factory<CLOCKPro, CLOCKProRPParams>(false)},
+        {"FIFORP", factory<FIFO, FIFORPParams>(false)},
+        {"LFURP", factory<LFU, LFURPParams>(false)},
+        {"LIPRP", factory<BIP, BIPRPParams>(true, btp(0))},
+        {"LIRSRP", factory<LIRS, LIRSRPParams>(false,
+            [](LIRSRPParams &p, const PolicyArgs &args, unsigned) {
+                p.hir_fraction = getArg(args, "hir_fraction", 0.01);
+            })},
+        {"LRUKRP", factory<LRUK, LRUKRPParams>(false,
+            [](LRUKRPParams &p, const PolicyArgs &args, unsigned) {
+                p.k = getArg(args, "k", 2u);
+                p.correlated_reference_period =
+                    getArg(args, "correlated_reference_period", Tick(10));
+            })},
+        {"LRURP", factory<LRU, LRURPParams>(false)},
+        {"MRURP", factory<MRU, MRURPParams>(false)},
+        {"NRURP", factory<BRRIP, BRRIPRPParams>(true, rrip(1, 100))},
+#if HAVE_PROTOBUF
+        // The trace file and block size default to those being evaluated
+        {"OPTRP", factory<OPT, OPTRPParams>(false,
+            [](OPTRPParams &p, const PolicyArgs &args, unsigned) {
+                p.trace_file = args.at("trace_file");
+                p.block_size = getArg(args, "block_size", 64u);
+                p.window = getArg(args, "window", 1u << 22);
+                p.resync_distance = getArg(args, "resync_distance", 64u);
+            })},
+#endif
+        {"RandomRP", factory<Random, RandomRPParams>(true)},
+        {"RRIPRP", factory<BRRIP, BRRIPRPParams>(true, rrip(2, 100))},
+        {"SecondChanceRP", factory<SecondChance, SecondChanceRPParams>(
+            false)},
+        {"TreePLRURP", factory<TreePLRU, TreePLRURPParams>(false,
+            [](TreePLRURPParams &p, const PolicyArgs &args, unsigned assoc) {
+                p.num_leaves = getArg(args, "num_leaves", int(assoc));
+            })},
+    };
+    return factories;
+}
+
+/** A policy to evaluate, as given on the command line. */
+struct PolicySpec
+{
+    std::string label;
+    std::string type;
+    PolicyArgs args;
+};
+
+/** One cache configuration, and the result of replaying the trace. */
+struct Job
+{
+    const PolicySpec *policy;
+    uint64_t size;
+    unsigned assoc;
+
+    uint64_t accesses = 0;
+    uint64_t misses = 0;
+};
+
+/** Serializes the creation and destruction of SimObjects. */
+std::mutex simObjectMutex;
+
+/**
+ * Replay a trace against a cache configuration.
+ *
+ * @param job The configuration; its results are filled in.
+ * @param addrs Block addresses accessed.
+ * @param ticks Ticks of the accesses.
+ * @param block_size Block size in bytes.
+ * @param warmup Number of accesses that are not counted.
+ */
+void
+runJob(Job &job, const std::vector<Addr> &addrs,
+       const std::vector<Tick> &ticks, unsigned block_size, uint64_t warmup)
+{
+    ReplayClock clock("repl_trace_eval");
+
+    std::shared_ptr<SetAssociativeParams> indexing_params;
+    std::unique_ptr<SetAssociative> indexing;
+    PolicyInstance instance;
+    {
+        std::lock_guard<std::mutex> lock(simObjectMutex);
+        indexing_params = std::make_shared<SetAssociativeParams>();
+        indexing_params->name = "indexing_policy";
+        indexing_params->eventq_index = 0;
+        indexing_params->size = job.size;
+        indexing_params->assoc = job.assoc;
+        indexing_params->entry_size = block_size;
+        indexing.reset(new SetAssociative(*indexing_params));
+        instance = policyFactories().at(job.policy->type).create(
+            job.policy->args, job.assoc);
+    }
+    auto array = std::make_unique<TagOnlyArray>(indexing.get(),
+        instance.policy.get(), job.size / block_size);
+
+    for (std::size_t i = 0; i < addrs.size(); i++) {
+        clock.set(ticks[i]);
+        replacement_policy::AccessContext ctx;
+        ctx.addr = addrs[i];
+        const bool hit = array->access(ctx) == TagOnlyArray::Outcome::Hit;
+        if (i >= warmup) {
+            job.accesses++;
+            if (!hit) {
+                job.misses++;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(simObjectMutex);
+        array.reset();
+        instance.policy.reset();
+        indexing.reset();
+    }
+}
+
+/** Parse a size such as 64KiB or 2MB. */
+uint64_t
+parseSize(const std::string &str)
+{
+    static const std::vector<std::pair<std::string, uint64_t>> suffixes = {
+        {"KiB", 1ULL << 10}, {"MiB", 1ULL << 20}, {"GiB", 1ULL << 30},
+        {"kB", 1ULL << 10}, {"KB", 1ULL << 10}, {"MB", 1ULL << 20},
+        {"GB", 1ULL << 30}, {"k", 1ULL << 10}, {"K", 1ULL << 10},
+        {"M", 1ULL << 20}, {"G", 1ULL << 30}, {"B", 1},
+    };
+
+    std::string digits = str;
+    uint64_t multiplier = 1;
+    for (const auto &suffix : suffixes) {
+        if (digits.size() > suffix.first.size() &&
+            digits.compare(digits.size() - suffix.first.size(),
+                           suffix.first.size(), suffix.first) == 0) {
+            digits.resize(digits.size() - suffix.first.size());
+            multiplier = suffix.second;
+            break;
+        }
+    }
+
+    uint64_t value;
+    if (!to_number(digits, value)) {
+        fprintf(stderr, "Invalid size '%s'.\n", str.c_str());
+        std::exit(1);
+    }
+    return value * multiplier;
+}
+
+/** Parse a policy such as LRUKRP:k=3;correlated_reference_period=0. */
+PolicySpec
+parsePolicy(const std::string &str)
+{
+    PolicySpec spec;
+    spec.label = str;
+    const auto colon = str.find(':');
+    spec.type = str.substr(0, colon);
+    if (!policyFactories().count(spec.type)) {
+        fprintf(stderr, "Unknown replacement policy '%s'. Known policies:",
+                spec.type.c_str());
+        for (const auto &factory : policyFactories()) {
+            fprintf(stderr, " %s", factory.first.c_str());
+        }
+        fprintf(stderr, "\n");
+        std::exit(1);
+    }
+
+    if (colon != std::string::npos) {
+        std::vector<std::string> args;
+        tokenize(args, str.substr(colon + 1), ';');
+        for (const auto &arg : args) {
+            const auto equal = arg.find('=');
+            if (equal == std::string::npos) {
+                fprintf(stderr, "Invalid policy parameter '%s'.\n",
+                        arg.c_str());
+                std::exit(1);
+            }
+            spec.args[arg.substr(0, equal)] = arg.substr(equal + 1);
+        }
+    }
+    return spec;
+}
+
+#if HAVE_PROTOBUF
+/**
+ * Read the block addresses accessed in a trace. Only cacheable reads and
+ * writes are kept, and accesses spanning several blocks are split. Ticks
+ * are made strictly increasing, so that timestamp-based policies can order
+ * every access.
+ */
+void
+readTrace(const std::string &filename, unsigned block_size,
+          std::vector<Addr> &addrs, std::vector<Tick> &ticks)
+{
+    replacement_policy::AccessTraceReader trace(filename, block_size);
+
+    Addr addr;
+    Tick trace_tick;
+    Tick tick = 0;
+    while (trace.next(addr, trace_tick)) {
+        tick = std::max(tick + 1, trace_tick);
+        addrs.push_back(addr);
+        ticks.push_back(tick);
+    }
+}
+#endif
+
+void
+usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <trace file>\n"
+        "  --policies=P1,P2,...  Policies to evaluate (LRURP). Parameters\n"
+        "                        are given as LRUKRP:k=3;"
+        "correlated_reference_period=0\n"
+        "  --sizes=S1,S2,...     Cache sizes (32KiB)\n"
+        "  --assocs=A1,A2,...    Associativities (8)\n"
+        "  --block-size=N        Block size in bytes (64)\n"
+        "  --warmup=N            Number of accesses not counted (0)\n"
+        "  --threads=N           Number of worker threads\n"
+        "  --csv                 Print the results as CSV\n", name);
+    std::exit(1);
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    std::vector<std::string> policy_strs = {"LRURP"};
+    std::vector<std::string> size_strs = {"32KiB"};
+    std::vector<std::string> assoc_strs = {"8"};
+    unsigned block_size = 64;
+    uint64_t warmup = 0;
+    unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+    bool csv = false;
+
+    static const struct option long_options[] = {
+        {"policies", required_argument, nullptr, 'p'},
+        {"sizes", required_argument, nullptr, 's'},
+        {"assocs", required_argument, nullptr, 'a'},
+        {"block-size", required_argument, nullptr, 'b'},
+        {"warmup", required_argument, nullptr, 'w'},
+        {"threads", required_argument, nullptr, 't'},
+        {"csv", no_argument, nullptr, 'c'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", long_options, nullptr)) != -1) {
+        switch (opt) {
+          case 'p':
+            policy_strs.clear();
+            tokenize(policy_strs, optarg, ',');
+            break;
+          case 's':
+            size_strs.clear();
+            tokenize(size_strs, optarg, ',');
+            break;
+          case 'a':
+            assoc_strs.clear();
+            tokenize(assoc_strs, optarg, ',');
+            break;
+          case 'b':
+            if (!to_number(optarg, block_size) || block_size == 0)
+                usage(argv[0]);
+            break;
+          case 'w':
+            if (!to_number(optarg, warmup))
+                usage(argv[0]);
+            break;
+          case 't':
+            if (!to_number(optarg, num_threads) || num_threads == 0)
+                usage(argv[0]);
+            break;
+          case 'c':
+            csv = true;
+            break;
+          default:
+            usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+    }
+
+#if HAVE_PROTOBUF
+    std::vector<PolicySpec> policies;
+    for (const auto &str : policy_strs) {
+        policies.push_back(parsePolicy(str));
+        if (policies.back().type == "OPTRP") {
+            auto &args = policies.back().args;
+            args.emplace("trace_file", argv[optind]);
+            args.emplace("block_size", std::to_string(block_size));
+        }
+    }
+
+    std::vector<Job> jobs;
+    for (const auto &policy : policies) {
+        for (const auto &size_str : size_strs) {
+            for (const auto &assoc_str : assoc_strs) {
+                Job job;
+                job.policy = &policy;
+                job.size = parseSize(size_str);
+                if (!to_number(assoc_str, job.assoc) || job.assoc == 0) {
+                    fprintf(stderr, "Invalid associativity '%s'.\n",
+                            assoc_str.c_str());
+                    return 1;
+                }
+                jobs.push_back(job);
+            }
+        }
+    }
+
+    std::vector<Addr> addrs;
+    std::vector<Tick> ticks;
+    readTrace(argv[optind], block_size, addrs, ticks);
+
+    // Policies that draw from the global random number generator are run
+    // one after the other, on the main thread, after all the others
+    std::vector<Job*> parallel_jobs;
+    std::vector<Job*> serial_jobs;
+    for (auto &job : jobs) {
+        if (policyFactories().at(job.policy->type).usesGlobalRandom) {
+            serial_jobs.push_back(&job);
+        } else {
+            parallel_jobs.push_back(&job);
+        }
+    }
+
+    std::atomic<std::size_t> next_job(0);
+    auto worker = [&]() {
+        for (std::size_t i = next_job++; i < parallel_jobs.size();
+             i = next_job++) {
+            runJob(*parallel_jobs[i], addrs, ticks, block_size, warmup);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < std::min<std::size_t>(num_threads,
+                                                   parallel_jobs.size());
+         i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto job : serial_jobs) {
+        runJob(*job, addrs, ticks, block_size, warmup);
+    }
+
+    int label_width = 6;
+    for (const auto &policy : policies) {
+        label_width = std::max<int>(label_width, policy.label.size());
+    }
+
+    if (csv) {
+        printf("policy,size,assoc,accesses,misses,miss_ratio\n");
+    } else {
+        printf("%-*s %12s %6s %14s %14s %10s\n", label_width, "policy",
+               "size", "assoc", "accesses", "misses", "miss ratio");
+    }
+    for (const auto &job : jobs) {
+        const double ratio = job.accesses ?
+            double(job.misses) / job.accesses : 0.0;
+        if (csv) {
+            printf("%s,%llu,%u,%llu,%llu,%.6f\n", job.policy->label.c_str(),
+                   (unsigned long long)job.size, job.assoc,
+                   (unsigned long long)job.accesses,
+                   (unsigned long long)job.misses, ratio);
+        } else {
+            printf("%-*s %12llu %6u %14llu %14llu %10.6f\n", label_width,
+                   job.policy->label.c_str(), (unsigned long long)job.size,
+                   job.assoc, (unsigned long long)job.accesses,
+                   (unsigned long long)job.misses, ratio);
+        }
+    }
+
+    return 0;
+#else
+    fprintf(stderr, "Reading traces requires protobuf support.\n");
+    return 1;
+#endif
+}
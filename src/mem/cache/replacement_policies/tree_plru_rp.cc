@@ -36,6 +36,7 @@
 
 #include <cmath>
 
+#include "base/binary_io.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "params/TreePLRURP.hh"
@@ -103,7 +104,7 @@ TreePLRU::TreePLRUReplData::TreePLRUReplData(
 }
 
 TreePLRU::TreePLRU(const Params &p)
-  : Base(p), numLeaves(p.num_leaves), count(0), treeInstance(nullptr)
+  : Base(p), numLeaves(p.num_leaves), count(0)
 {
     fatal_if(!isPowerOf2(numLeaves),
              "Number of leaves must be non-zero and a power of 2");
@@ -113,8 +114,8 @@ void
 TreePLRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Cast replacement data
-    std::shared_ptr<TreePLRUReplData> treePLRU_replacement_data =
-        std::static_pointer_cast<TreePLRUReplData>(replacement_data);
+    TreePLRUReplData* treePLRU_replacement_data =
+        static_cast<TreePLRUReplData*>(replacement_data.get());
     PLRUTree* tree = treePLRU_replacement_data->tree.get();
 
     // Index of the tree entry we are currently checking
@@ -139,8 +140,8 @@ TreePLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data)
 const
 {
     // Cast replacement data
-    std::shared_ptr<TreePLRUReplData> treePLRU_replacement_data =
-        std::static_pointer_cast<TreePLRUReplData>(replacement_data);
+    TreePLRUReplData* treePLRU_replacement_data =
+        static_cast<TreePLRUReplData*>(replacement_data.get());
     PLRUTree* tree = treePLRU_replacement_data->tree.get();
 
     // Index of the tree entry we are currently checking
@@ -175,8 +176,8 @@ TreePLRU::getVictim(const ReplacementCandidates& candidates) const
     assert(candidates.size() > 0);
 
     // Get tree
-    const PLRUTree* tree = std::static_pointer_cast<TreePLRUReplData>(
-            candidates[0]->replacementData)->tree.get();
+    const PLRUTree* tree = static_cast<TreePLRUReplData*>(
+            candidates[0]->replacementData.get())->tree.get();
 
     // Index of the tree entry we are currently checking. Start with root.
     uint64_t tree_index = 0;
@@ -201,18 +202,49 @@ TreePLRU::instantiateEntry()
 {
     // Generate a tree instance every numLeaves created
     if (count % numLeaves == 0) {
-        treeInstance = new PLRUTree(numLeaves - 1, false);
+        treeInstance = std::make_shared<PLRUTree>(numLeaves - 1, false);
     }
 
     // Create replacement data using current tree instance
-    TreePLRUReplData* treePLRUReplData = new TreePLRUReplData(
-        (count % numLeaves) + numLeaves - 1,
-        std::shared_ptr<PLRUTree>(treeInstance));
+    std::shared_ptr<ReplacementData> treePLRUReplData =
+        replDataArena.allocate((count % numLeaves) + numLeaves - 1,
+                               treeInstance);
 
     // Update instance counter
     count++;
 
-    return std::shared_ptr<ReplacementData>(treePLRUReplData);
+    return treePLRUReplData;
+}
+
+void
+TreePLRU::serializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::ostream &os) const
+{
+    // The entries of a set are written in order, so the set's tree is
+    // written once, with the entry holding its last leaf
+    const TreePLRUReplData* casted_replacement_data =
+        static_cast<const TreePLRUReplData*>(replacement_data.get());
+    if (casted_replacement_data->index == 2 * numLeaves - 2) {
+        for (const bool node : *casted_replacement_data->tree) {
+            binaryOut(os, node);
+        }
+    }
+}
+
+void
+TreePLRU::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    TreePLRUReplData* casted_replacement_data =
+        static_cast<TreePLRUReplData*>(replacement_data.get());
+    if (casted_replacement_data->index == 2 * numLeaves - 2) {
+        PLRUTree &tree = *casted_replacement_data->tree;
+        for (std::size_t i = 0; i < tree.size(); i++) {
+            tree[i] = binaryIn<bool>(is);
+        }
+    }
 }
 
 } // namespace replacement_policy
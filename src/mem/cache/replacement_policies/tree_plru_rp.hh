@@ -74,6 +74,7 @@
 #include <vector>
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -123,7 +124,7 @@ class TreePLRU : public Base
     /**
      * Holds the latest temporary tree instance created by instantiateEntry().
      */
-    PLRUTree* treeInstance;
+    std::shared_ptr<PLRUTree> treeInstance;
 
   protected:
     /**
@@ -155,6 +156,9 @@ class TreePLRU : public Base
         TreePLRUReplData(const uint64_t index, std::shared_ptr<PLRUTree> tree);
     };
 
+    /** Storage for the replacement data of all entries. */
+    ReplacementDataArena<TreePLRUReplData> replDataArena;
+
   public:
     typedef TreePLRURPParams Params;
     TreePLRU(const Params &p);
@@ -197,6 +201,29 @@ class TreePLRU : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    bool checkpointable() const override { return true; }
+
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * The tree shared by a set is written along with its last leaf.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry. Consecutive calls to this
      * function use the same tree up to numLeaves. When numLeaves replacement
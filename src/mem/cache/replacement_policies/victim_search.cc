@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/victim_search.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/logging.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VICTIM_SEARCH_X86 1
+#include <immintrin.h>
+#else
+#define VICTIM_SEARCH_X86 0
+#endif
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+namespace victim_search
+{
+
+namespace
+{
+
+typedef std::size_t (*Kernel)(const uint64_t *keys, std::size_t n);
+
+std::size_t
+minIndexScalar(const uint64_t *keys, std::size_t n)
+{
+    std::size_t index = 0;
+    for (std::size_t i = 1; i < n; i++) {
+        if (keys[i] < keys[index]) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+std::size_t
+maxIndexScalar(const uint64_t *keys, std::size_t n)
+{
+    std::size_t index = 0;
+    for (std::size_t i = 1; i < n; i++) {
+        if (keys[i] > keys[index]) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+#if VICTIM_SEARCH_X86
+
+/**
+ * The vector kernels work in two passes: the first one reduces the keys
+ * to their extreme value, which is then broadcast to all lanes, and the
+ * second one compares the keys against it, accumulating the matches of up
+ * to 64 keys in a bitmask whose lowest bit is the victim. Neither pass has
+ * data-dependent branches for sets of up to 64 ways.
+ *
+ * Lanes past the last key are filled with a value that cannot be better
+ * than the extreme; they may match it, but only after a real key does.
+ */
+
+/** Load four keys, filling the lanes past the last key. */
+__attribute__((target("avx2")))
+inline __m256i
+loadKeysAVX2(const uint64_t *keys, std::size_t i, std::size_t n,
+             __m256i fill)
+{
+    if (n - i >= 4) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+    }
+    const __m256i valid = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - i),
+                                             _mm256_set_epi64x(3, 2, 1, 0));
+    const __m256i v = _mm256_maskload_epi64(
+        reinterpret_cast<const long long*>(keys + i), valid);
+    return _mm256_blendv_epi8(fill, v, valid);
+}
+
+/**
+ * AVX2 only compares signed 64-bit integers, so the keys are biased by
+ * flipping their sign bit, which maps the unsigned order to the signed one.
+ */
+template <bool Min>
+__attribute__((target("avx2")))
+std::size_t
+extremeIndexAVX2(const uint64_t *keys, std::size_t n)
+{
+    if (n < 8) {
+        return Min ? minIndexScalar(keys, n) : maxIndexScalar(keys, n);
+    }
+
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i fill = _mm256_set1_epi64x(Min ? -1 : 0);
+    __m256i best = _mm256_xor_si256(fill, bias);
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m256i v =
+            _mm256_xor_si256(loadKeysAVX2(keys, i, n, fill), bias);
+        const __m256i better = Min ? _mm256_cmpgt_epi64(best, v) :
+                                     _mm256_cmpgt_epi64(v, best);
+        best = _mm256_blendv_epi8(best, v, better);
+    }
+
+    // Reduce the lanes, leaving the extreme value in all of them
+    __m256i other = _mm256_permute4x64_epi64(best, 0x4e);
+    best = _mm256_blendv_epi8(best, other, Min ?
+        _mm256_cmpgt_epi64(best, other) : _mm256_cmpgt_epi64(other, best));
+    other = _mm256_permute4x64_epi64(best, 0xb1);
+    best = _mm256_blendv_epi8(best, other, Min ?
+        _mm256_cmpgt_epi64(best, other) : _mm256_cmpgt_epi64(other, best));
+    best = _mm256_xor_si256(best, bias);
+
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t end = std::min(n, base + 64);
+        uint64_t found = 0;
+        for (std::size_t i = base; i < end; i += 4) {
+            const __m256i equal = _mm256_cmpeq_epi64(
+                loadKeysAVX2(keys, i, n, fill), best);
+            found |= uint64_t(_mm256_movemask_pd(
+                _mm256_castsi256_pd(equal))) << (i - base);
+        }
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    panic("Extreme key not found in victim search.");
+}
+
+/**
+ * The AVX-512 kernels use the masked forms of the intrinsics, which take
+ * an explicit source vector, to avoid GCC's uninitialized-vector warnings.
+ */
+template <bool Min>
+__attribute__((target("avx512f")))
+std::size_t
+extremeIndexAVX512(const uint64_t *keys, std::size_t n)
+{
+    if (n < 8) {
+        return Min ? minIndexScalar(keys, n) : maxIndexScalar(keys, n);
+    }
+
+    const __m512i fill = _mm512_set1_epi64(Min ? -1 : 0);
+    __m512i best = fill;
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 valid = n - i >= 8 ? 0xff : (1 << (n - i)) - 1;
+        const __m512i v = _mm512_mask_loadu_epi64(fill, valid, keys + i);
+        best = Min ? _mm512_mask_min_epu64(best, 0xff, best, v) :
+                     _mm512_mask_max_epu64(best, 0xff, best, v);
+    }
+
+    // Reduce the lanes, leaving the extreme value in all of them
+    const __m512i swaps[3] = {
+        _mm512_set_epi64(3, 2, 1, 0, 7, 6, 5, 4),
+        _mm512_set_epi64(5, 4, 7, 6, 1, 0, 3, 2),
+        _mm512_set_epi64(6, 7, 4, 5, 2, 3, 0, 1)
+    };
+    for (const __m512i &swap : swaps) {
+        const __m512i other =
+            _mm512_mask_permutexvar_epi64(best, 0xff, swap, best);
+        best = Min ? _mm512_mask_min_epu64(best, 0xff, best, other) :
+                     _mm512_mask_max_epu64(best, 0xff, best, other);
+    }
+
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t end = std::min(n, base + 64);
+        uint64_t found = 0;
+        for (std::size_t i = base; i < end; i += 8) {
+            const __mmask8 valid = n - i >= 8 ? 0xff : (1 << (n - i)) - 1;
+            const __m512i v = _mm512_mask_loadu_epi64(fill, valid, keys + i);
+            found |= uint64_t(_mm512_cmpeq_epu64_mask(v, best)) << (i - base);
+        }
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    panic("Extreme key not found in victim search.");
+}
+
+#endif // VICTIM_SEARCH_X86
+
+Kernel
+minKernel(Isa isa)
+{
+    switch (isa) {
+#if VICTIM_SEARCH_X86
+      case Isa::AVX2:
+        return extremeIndexAVX2<true>;
+      case Isa::AVX512:
+        return extremeIndexAVX512<true>;
+#endif
+      default:
+        return minIndexScalar;
+    }
+}
+
+Kernel
+maxKernel(Isa isa)
+{
+    switch (isa) {
+#if VICTIM_SEARCH_X86
+      case Isa::AVX2:
+        return extremeIndexAVX2<false>;
+      case Isa::AVX512:
+        return extremeIndexAVX512<false>;
+#endif
+      default:
+        return maxIndexScalar;
+    }
+}
+
+/** Kernels of the best instruction set, chosen on first use. */
+struct DefaultKernels
+{
+    const Kernel min;
+    const Kernel max;
+
+    DefaultKernels() : min(minKernel(bestIsa())), max(maxKernel(bestIsa()))
+    {}
+};
+
+const DefaultKernels&
+defaultKernels()
+{
+    static const DefaultKernels kernels;
+    return kernels;
+}
+
+} // anonymous namespace
+
+bool
+isaSupported(Isa isa)
+{
+    switch (isa) {
+      case Isa::Scalar:
+        return true;
+#if VICTIM_SEARCH_X86
+      case Isa::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+      case Isa::AVX512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f");
+#endif
+      default:
+        return false;
+    }
+}
+
+Isa
+bestIsa()
+{
+    if (isaSupported(Isa::AVX512)) {
+        return Isa::AVX512;
+    } else if (isaSupported(Isa::AVX2)) {
+        return Isa::AVX2;
+    }
+    return Isa::Scalar;
+}
+
+std::size_t
+minIndex(const uint64_t *keys, std::size_t n)
+{
+    assert(n > 0);
+    return defaultKernels().min(keys, n);
+}
+
+std::size_t
+maxIndex(const uint64_t *keys, std::size_t n)
+{
+    assert(n > 0);
+    return defaultKernels().max(keys, n);
+}
+
+std::size_t
+minIndex(const uint64_t *keys, std::size_t n, Isa isa)
+{
+    assert(n > 0);
+    panic_if(!isaSupported(isa), "Victim search ISA not supported.");
+    return minKernel(isa)(keys, n);
+}
+
+std::size_t
+maxIndex(const uint64_t *keys, std::size_t n, Isa isa)
+{
+    assert(n > 0);
+    panic_if(!isaSupported(isa), "Victim search ISA not supported.");
+    return maxKernel(isa)(keys, n);
+}
+
+} // namespace victim_search
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Search kernels used by replacement policies that select their victim by
+ * comparing a numeric key (a timestamp or a counter) of every candidate.
+ *
+ * The policies gather the keys of the candidates into a packed array and
+ * search it with the widest vector instructions supported by the host,
+ * which is detected at run time. minIndexOf() and maxIndexOf() do the
+ * gathering in fixed-size chunks on the stack, so that a search keeps no
+ * state in the policy and can run concurrently on different sets. All
+ * implementations return the index of the first extreme key, so that they
+ * choose the same victim as a scalar loop that only replaces its current
+ * victim on a strict improvement.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_SEARCH_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_SEARCH_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+namespace victim_search
+{
+
+/** Instruction set extensions the kernels can be built for. */
+enum class Isa
+{
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/**
+ * Check whether the kernels for an instruction set can run on this host.
+ *
+ * @param isa The instruction set.
+ * @return True if the kernels for the given instruction set can be used.
+ */
+bool isaSupported(Isa isa);
+
+/**
+ * Get the instruction set used by the default kernels.
+ *
+ * @return The widest instruction set supported by the host.
+ */
+Isa bestIsa();
+
+/**
+ * Find the first smallest key.
+ *
+ * @param keys The keys of the candidates.
+ * @param n Number of keys; must be greater than zero.
+ * @return The index of the first smallest key.
+ */
+std::size_t minIndex(const uint64_t *keys, std::size_t n);
+
+/**
+ * Find the first largest key.
+ *
+ * @param keys The keys of the candidates.
+ * @param n Number of keys; must be greater than zero.
+ * @return The index of the first largest key.
+ */
+std::size_t maxIndex(const uint64_t *keys, std::size_t n);
+
+/**
+ * Variants of minIndex() and maxIndex() that use the kernels of a given
+ * instruction set, which must be supported by the host.
+ */
+std::size_t minIndex(const uint64_t *keys, std::size_t n, Isa isa);
+std::size_t maxIndex(const uint64_t *keys, std::size_t n, Isa isa);
+
+/** Number of keys gathered on the stack per call to the kernels. */
+constexpr std::size_t ChunkSize = 64;
+
+/**
+ * Gather the keys of the candidates chunk by chunk and find the first
+ * extreme one.
+ *
+ * @param n Number of candidates; must be greater than zero.
+ * @param key Functor returning the key of the i-th candidate.
+ * @param search Kernel used to search each chunk.
+ * @param better Strict order between keys of different chunks.
+ * @return The index of the first extreme key.
+ */
+template <typename KeyFn, typename Better>
+std::size_t
+chunkedIndex(std::size_t n, KeyFn &&key,
+             std::size_t (*search)(const uint64_t *, std::size_t),
+             Better better)
+{
+    uint64_t keys[ChunkSize];
+    std::size_t best = 0;
+    uint64_t best_key = 0;
+    for (std::size_t base = 0; base < n; base += ChunkSize) {
+        const std::size_t len = std::min(ChunkSize, n - base);
+        for (std::size_t i = 0; i < len; i++) {
+            keys[i] = key(base + i);
+        }
+        const std::size_t index = search(keys, len);
+        if (base == 0 || better(keys[index], best_key)) {
+            best = base + index;
+            best_key = keys[index];
+        }
+    }
+    return best;
+}
+
+/**
+ * Find the first smallest key of a set of candidates.
+ *
+ * @param n Number of candidates; must be greater than zero.
+ * @param key Functor returning the key of the i-th candidate.
+ * @return The index of the first smallest key.
+ */
+template <typename KeyFn>
+std::size_t
+minIndexOf(std::size_t n, KeyFn &&key)
+{
+    return chunkedIndex(n, key,
+        static_cast<std::size_t (*)(const uint64_t *, std::size_t)>(
+            minIndex),
+        [](uint64_t a, uint64_t b) { return a < b; });
+}
+
+/**
+ * Find the first largest key of a set of candidates.
+ *
+ * @param n Number of candidates; must be greater than zero.
+ * @param key Functor returning the key of the i-th candidate.
+ * @return The index of the first largest key.
+ */
+template <typename KeyFn>
+std::size_t
+maxIndexOf(std::size_t n, KeyFn &&key)
+{
+    return chunkedIndex(n, key,
+        static_cast<std::size_t (*)(const uint64_t *, std::size_t)>(
+            maxIndex),
+        [](uint64_t a, uint64_t b) { return a > b; });
+}
+
+} // namespace victim_search
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_SEARCH_HH__
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/cache/replacement_policies/victim_search.hh"
+
+using namespace gem5::replacement_policy::victim_search;
+
+namespace
+{
+
+/** The victim loop used by LRU, LFU and FIFO. */
+std::size_t
+referenceMin(const std::vector<uint64_t> &keys)
+{
+    std::size_t victim = 0;
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        if (keys[i] < keys[victim]) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+/** The victim loop used by MRU, which prefers never-touched entries. */
+std::size_t
+referenceMRU(const std::vector<uint64_t> &keys)
+{
+    std::size_t victim = 0;
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        if (keys[i] == 0) {
+            victim = i;
+            break;
+        } else if (keys[i] > keys[victim]) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+/** All instruction sets the host can run. */
+std::vector<Isa>
+supportedIsas()
+{
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::Scalar, Isa::AVX2, Isa::AVX512}) {
+        if (isaSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/**
+ * Generate keys for a set. A small range of values creates many ties,
+ * which must be broken in favour of the first candidate.
+ */
+std::vector<uint64_t>
+randomKeys(std::mt19937_64 &rng, std::size_t n, uint64_t range)
+{
+    std::vector<uint64_t> keys(n);
+    for (auto &key : keys) {
+        key = range ? rng() % range : rng();
+    }
+    return keys;
+}
+
+} // anonymous namespace
+
+/** The scalar kernels are always available. */
+TEST(VictimSearchTest, ScalarSupported)
+{
+    ASSERT_TRUE(isaSupported(Isa::Scalar));
+    ASSERT_TRUE(isaSupported(bestIsa()));
+}
+
+/** Every kernel picks the same victim as the LRU scalar loop. */
+TEST(VictimSearchTest, MinMatchesScalarLoop)
+{
+    std::mt19937_64 rng(0);
+    for (Isa isa : supportedIsas()) {
+        for (std::size_t n = 1; n <= 67; n++) {
+            for (uint64_t range : {0, 1, 2, 5, 1000}) {
+                const auto keys = randomKeys(rng, n, range);
+                ASSERT_EQ(minIndex(keys.data(), n, isa), referenceMin(keys))
+                    << "isa " << int(isa) << " n " << n;
+            }
+        }
+    }
+}
+
+/** Every kernel picks the same victim as the MRU scalar loop. */
+TEST(VictimSearchTest, MaxMatchesScalarLoop)
+{
+    std::mt19937_64 rng(1);
+    for (Isa isa : supportedIsas()) {
+        for (std::size_t n = 1; n <= 67; n++) {
+            for (uint64_t range : {0, 1, 2, 5, 1000}) {
+                const auto keys = randomKeys(rng, n, range);
+
+                // MRU maps untouched entries to the largest possible key
+                std::vector<uint64_t> mru_keys(keys);
+                for (auto &key : mru_keys) {
+                    key = key ? key : UINT64_MAX;
+                }
+                ASSERT_EQ(maxIndex(mru_keys.data(), n, isa),
+                          referenceMRU(keys))
+                    << "isa " << int(isa) << " n " << n;
+            }
+        }
+    }
+}
+
+/** Keys with the top bit set must be ordered as unsigned values. */
+TEST(VictimSearchTest, UnsignedOrder)
+{
+    std::vector<uint64_t> keys(32, UINT64_MAX - 1);
+    keys[7] = 1;
+    keys[19] = UINT64_MAX;
+    for (Isa isa : supportedIsas()) {
+        ASSERT_EQ(minIndex(keys.data(), keys.size(), isa), 7u);
+        ASSERT_EQ(maxIndex(keys.data(), keys.size(), isa), 19u);
+    }
+}
+
+/** The default kernels agree with the scalar ones. */
+TEST(VictimSearchTest, DefaultKernels)
+{
+    std::mt19937_64 rng(2);
+    for (std::size_t n : {1, 4, 8, 16, 32, 64}) {
+        const auto keys = randomKeys(rng, n, 8);
+        ASSERT_EQ(minIndex(keys.data(), n),
+                  minIndex(keys.data(), n, Isa::Scalar));
+        ASSERT_EQ(maxIndex(keys.data(), n),
+                  maxIndex(keys.data(), n, Isa::Scalar));
+    }
+}
+
+/**
+ * The chunked searches keep the first extreme key across chunk
+ * boundaries, including for sets larger than a chunk.
+ */
+TEST(VictimSearchTest, ChunkedMatchesScalarLoop)
+{
+    std::mt19937_64 rng(3);
+    for (std::size_t n : {1, 63, 64, 65, 128, 130, 1000}) {
+        for (uint64_t range : {0, 1, 2, 5, 1000}) {
+            const auto keys = randomKeys(rng, n, range);
+            auto key = [&keys](std::size_t i) { return keys[i]; };
+            ASSERT_EQ(minIndexOf(n, key), referenceMin(keys)) << "n " << n;
+
+            std::vector<uint64_t> mru_keys(keys);
+            for (auto &key : mru_keys) {
+                key = key ? key : UINT64_MAX;
+            }
+            ASSERT_EQ(maxIndexOf(n,
+                          [&mru_keys](std::size_t i) { return mru_keys[i]; }),
+                      referenceMRU(keys))
+                << "n " << n;
+        }
+    }
+}
@@ -33,6 +33,7 @@
 
 #include <cassert>
 
+#include "base/binary_io.hh"
 #include "params/WeightedLRURP.hh"
 #include "sim/cur_tick.hh"
 
@@ -97,5 +98,25 @@ WeightedLRU::instantiateEntry()
     return std::shared_ptr<ReplacementData>(new WeightedLRUReplData);
 }
 
+void
+WeightedLRU::serializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::ostream &os) const
+{
+    LRU::serializeEntry(replacement_data, os);
+    binaryOut(os, static_cast<const WeightedLRUReplData*>(
+        replacement_data.get())->last_occ_ptr);
+}
+
+void
+WeightedLRU::unserializeEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    std::istream &is)
+{
+    LRU::unserializeEntry(replacement_data, is);
+    binaryIn(is, static_cast<WeightedLRUReplData*>(
+        replacement_data.get())->last_occ_ptr);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
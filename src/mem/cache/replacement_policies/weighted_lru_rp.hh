@@ -69,6 +69,27 @@ class WeightedLRU : public LRU
     void touch(const std::shared_ptr<ReplacementData>& replacement_data,
                                         int occupancy) const;
 
+    /**
+     * Write the replacement data of an entry to a binary stream.
+     * Writes its last touch tick and occupancy.
+     *
+     * @param replacement_data Replacement data to be written.
+     * @param os The stream to write to.
+     */
+    void serializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::ostream &os) const override;
+
+    /**
+     * Restore the replacement data of an entry from a binary stream.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param is The stream to read from.
+     */
+    void unserializeEntry(
+        const std::shared_ptr<ReplacementData>& replacement_data,
+        std::istream &is) override;
+
     /**
      * Instantiate a replacement data entry.
      *
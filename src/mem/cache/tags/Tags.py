@@ -80,6 +80,16 @@ class BaseTags(ClockedObject):
         Parent.cache_line_size, "Indexing entry size in bytes"
     )
 
+    # Only model one set out of every sampled_set_period sets. The other
+    # sets have no blocks nor data. Their lookups hit or miss at the miss
+    # ratio of the modeled sets: hits are served from the levels below with
+    # functional accesses, and misses go down as usual. This is meant for
+    # very large last-level caches, where the modeled sets are enough for a
+    # precise estimate.
+    sampled_set_period = Param.Unsigned(
+        1, "Period of the modeled sets (1 models every set)"
+    )
+
 
 class BaseSetAssoc(BaseTags):
     type = "BaseSetAssoc"
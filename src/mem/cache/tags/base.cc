@@ -45,11 +45,15 @@
 
 #include "mem/cache/tags/base.hh"
 
+#include <algorithm>
 #include <cassert>
 
+#include "base/intmath.hh"
 #include "base/types.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/set_sampling.hh"
 #include "mem/request.hh"
 #include "sim/core.hh"
 #include "sim/sim_exit.hh"
@@ -62,12 +66,80 @@ BaseTags::BaseTags(const Params &p)
     : ClockedObject(p), blkSize(p.block_size), blkMask(blkSize - 1),
       size(p.size), lookupLatency(p.tag_latency),
       system(p.system), indexingPolicy(p.indexing_policy),
-      warmupBound((p.warmup_percentage/100.0) * (p.size / p.block_size)),
-      warmedUp(false), numBlocks(p.size / p.block_size),
-      dataBlks(new uint8_t[p.size]), // Allocate data storage in one big chunk
+      warmupBound((p.warmup_percentage/100.0) *
+                  (p.size / p.block_size / p.sampled_set_period)),
+      warmedUp(false),
+      numBlocks(p.size / p.block_size / p.sampled_set_period),
+      sampledSetPeriod(p.sampled_set_period),
+      // Allocate data storage in one big chunk
+      dataBlks(new uint8_t[p.size / p.sampled_set_period]),
+      recentLookups(0), recentMisses(0), missCredit(0),
       stats(*this)
 {
     registerExitCallback([this]() { cleanupRefs(); });
+
+    fatal_if(!isPowerOf2(sampledSetPeriod),
+             "The set sampling period of %s must be a power of 2.", name());
+    if (sampledSetPeriod > 1) {
+        // The other indexing policies spread the ways of an address over
+        // several sets
+        fatal_if(!dynamic_cast<SetAssociative*>(indexingPolicy),
+                 "Sets can only be sampled with the SetAssociative indexing "
+                 "policy in %s.", name());
+        fatal_if(sampledSetPeriod > indexingPolicy->getNumSets(),
+                 "The set sampling period of %s exceeds its number of sets.",
+                 name());
+        samplingStats = std::make_unique<SamplingStats>(*this,
+            indexingPolicy->getNumSets());
+
+        // Only the modeled sets get entries
+        indexingPolicy->sampleSets(sampledSetPeriod);
+    }
+}
+
+void
+BaseTags::sampleLookup(Addr addr, bool hit)
+{
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(addr);
+    if (entries.empty()) {
+        samplingStats->unsampledAccesses++;
+        return;
+    }
+
+    const uint32_t index = entries[0]->getSet() / sampledSetPeriod;
+    samplingStats->setAccesses[index]++;
+    samplingStats->sampledAccesses++;
+    if (!hit) {
+        samplingStats->setMisses[index]++;
+        samplingStats->sampledMisses++;
+        recentMisses++;
+    }
+    if (++recentLookups == missRatioWindow) {
+        recentLookups /= 2;
+        recentMisses /= 2;
+    }
+}
+
+bool
+BaseTags::isEstimatedHit(Addr addr)
+{
+    if (!samplingStats ||
+        !indexingPolicy->getPossibleEntries(addr).empty()) {
+        return false;
+    }
+
+    // Until the modeled sets have been looked up, every lookup misses
+    missCredit += recentLookups ?
+        static_cast<double>(recentMisses) / recentLookups : 1;
+    if (missCredit >= 1) {
+        missCredit -= 1;
+        return false;
+    }
+
+    samplingStats->unsampledAccesses++;
+    samplingStats->unsampledHits++;
+    return true;
 }
 
 ReplaceableEntry*
@@ -83,7 +155,7 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     Addr tag = extractTag(addr);
 
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
+    const std::vector<ReplaceableEntry*> &entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Search for block
@@ -250,6 +322,47 @@ BaseTags::BaseTagStats::BaseTagStats(BaseTags &_tags)
 {
 }
 
+BaseTags::SamplingStats::SamplingStats(BaseTags &tags, uint32_t num_sets)
+  : statistics::Group(&tags, "sampling"),
+    numSets(num_sets),
+    setAccesses(num_sets / tags.sampledSetPeriod, 0),
+    setMisses(num_sets / tags.sampledSetPeriod, 0),
+    ADD_STAT(sampledAccesses, statistics::units::Count::get(),
+             "Number of lookups to the modeled sets"),
+    ADD_STAT(sampledMisses, statistics::units::Count::get(),
+             "Number of lookups to the modeled sets that missed"),
+    ADD_STAT(unsampledAccesses, statistics::units::Count::get(),
+             "Number of lookups to the sets that are not modeled"),
+    ADD_STAT(unsampledHits, statistics::units::Count::get(),
+             "Number of lookups to the sets that are not modeled "
+             "estimated to hit"),
+    ADD_STAT(missRate, statistics::units::Ratio::get(),
+             "Miss ratio of the modeled sets",
+             sampledMisses / sampledAccesses),
+    ADD_STAT(missRateConfidence, statistics::units::Ratio::get(),
+             "Half width of the 95% confidence interval of the miss ratio"),
+    ADD_STAT(estimatedMisses, statistics::units::Count::get(),
+             "Estimated number of misses of the whole cache",
+             sampledMisses + missRate * unsampledAccesses)
+{
+    missRateConfidence.method(this, &SamplingStats::missRateError);
+}
+
+void
+BaseTags::SamplingStats::resetStats()
+{
+    statistics::Group::resetStats();
+
+    std::fill(setAccesses.begin(), setAccesses.end(), 0);
+    std::fill(setMisses.begin(), setMisses.end(), 0);
+}
+
+double
+BaseTags::SamplingStats::missRateError() const
+{
+    return set_sampling::missRatioError(setAccesses, setMisses, numSets);
+}
+
 void
 BaseTags::BaseTagStats::regStats()
 {
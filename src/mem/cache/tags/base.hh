@@ -49,7 +49,11 @@
 #include <cassert>
 #include <cstdint>
 #include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
@@ -96,12 +100,36 @@ class BaseTags : public ClockedObject
     /** Marked true when the cache is warmed up. */
     bool warmedUp;
 
-    /** the number of blocks in the cache */
+    /** the number of blocks in the modeled sets of the cache */
     const unsigned numBlocks;
 
+    /**
+     * Only one set out of every sampledSetPeriod sets is modeled. It is a
+     * power of 2.
+     */
+    const unsigned sampledSetPeriod;
+
     /** The data blocks, 1 per cache block. */
     std::unique_ptr<uint8_t[]> dataBlks;
 
+    /**
+     * The number of lookups to the modeled sets after which the counts
+     * of recentLookups and recentMisses are halved.
+     */
+    static constexpr uint64_t missRatioWindow = 1 << 16;
+
+    /**
+     * Lookups and misses of the modeled sets, decayed every
+     * missRatioWindow lookups, so that the miss ratio given to the sets
+     * that are not modeled follows the phases of the workload. They are
+     * not statistics, as they must survive a stats reset.
+     */
+    uint64_t recentLookups;
+    uint64_t recentMisses;
+
+    /** Misses owed to the lookups to the sets that are not modeled. */
+    double missCredit;
+
     /**
      * TODO: It would be good if these stats were acquired after warmup.
      */
@@ -157,6 +185,65 @@ class BaseTags : public ClockedObject
         statistics::Scalar dataAccesses;
     } stats;
 
+    /**
+     * Estimation of the miss ratio of a cache that only models some of its
+     * sets. The modeled sets are a cluster sample of the sets, so the
+     * confidence interval is that of a ratio estimator, which accounts for
+     * the variation of the miss ratio across sets.
+     */
+    struct SamplingStats : public statistics::Group
+    {
+        SamplingStats(BaseTags &tags, uint32_t num_sets);
+
+        void resetStats() override;
+
+        /**
+         * Half width of the 95% confidence interval of the estimated miss
+         * ratio.
+         */
+        double missRateError() const;
+
+        /** Number of sets of the cache. */
+        const uint32_t numSets;
+
+        /** Number of lookups and misses of each modeled set. */
+        std::vector<uint64_t> setAccesses;
+        std::vector<uint64_t> setMisses;
+
+        /** Lookups to the modeled sets. */
+        statistics::Scalar sampledAccesses;
+
+        /** Lookups to the modeled sets that missed. */
+        statistics::Scalar sampledMisses;
+
+        /** Lookups to the sets that are not modeled. */
+        statistics::Scalar unsampledAccesses;
+
+        /** Lookups to the sets that are not modeled estimated to hit. */
+        statistics::Scalar unsampledHits;
+
+        /** Miss ratio of the modeled sets. */
+        statistics::Formula missRate;
+
+        /** Half width of the 95% confidence interval of missRate. */
+        statistics::Value missRateConfidence;
+
+        /** Misses the whole cache would have had. */
+        statistics::Formula estimatedMisses;
+    };
+
+    /** Only allocated if some sets are not modeled. */
+    std::unique_ptr<SamplingStats> samplingStats;
+
+    /**
+     * Account for a lookup in the estimation of the miss ratio. It must only
+     * be called if some sets are not modeled.
+     *
+     * @param addr The address looked up.
+     * @param hit Whether the lookup hit.
+     */
+    void sampleLookup(Addr addr, bool hit);
+
   public:
     typedef BaseTagsParams Params;
     BaseTags(const Params &p);
@@ -294,6 +381,37 @@ class BaseTags : public ClockedObject
      */
     virtual CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) = 0;
 
+    /**
+     * Decide whether a lookup to a set that is not modeled hits. The
+     * misses are spread evenly over these lookups, at the recent miss
+     * ratio of the modeled sets, so that the cache keeps its full hit
+     * ratio and the levels below only see the misses it would have had.
+     * A lookup estimated to hit is accounted for here; one estimated to
+     * miss must then be done with accessBlock().
+     *
+     * @param addr The address looked up.
+     * @return True if the address maps to a set that is not modeled and
+     *         the lookup is estimated to hit.
+     */
+    bool isEstimatedHit(Addr addr);
+
+    /**
+     * Whether only some of the sets are modeled.
+     *
+     * @return True if the sets are sampled.
+     */
+    bool samplesSets() const { return samplingStats != nullptr; }
+
+    /**
+     * Update the replacement data of a block as an access to it would,
+     * without counting the access in the stats. This is used when
+     * warming up the tags.
+     *
+     * @param blk The block being accessed.
+     * @param pkt The packet holding the address of the access.
+     */
+    virtual void touchBlock(CacheBlk *blk, const PacketPtr pkt) = 0;
+
     /**
      * Generate the tag from the given address.
      *
@@ -349,6 +467,27 @@ class BaseTags : public ClockedObject
      */
     virtual bool anyBlk(std::function<bool(CacheBlk &)> visitor) = 0;
 
+    /**
+     * Write the replacement state of the tags to a binary stream.
+     *
+     * @param os The stream to write to.
+     */
+    virtual void serializeReplacement(std::ostream &os) = 0;
+
+    /**
+     * Restore the replacement state written by serializeReplacement(). The
+     * valid blocks must have been inserted again beforehand.
+     *
+     * @param is The stream to read from.
+     */
+    virtual void unserializeReplacement(std::istream &is) = 0;
+
+    /**
+     * Whether the replacement state can be restored exactly. Otherwise
+     * it is as if the valid blocks had just been inserted in order.
+     */
+    virtual bool replacementCheckpointable() const { return true; }
+
   private:
     /**
      * Update the reference stats using data from the input block
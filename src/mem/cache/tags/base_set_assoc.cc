@@ -53,7 +53,8 @@ namespace gem5
 {
 
     BaseSetAssoc::BaseSetAssoc(const Params &p)
-        : BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
+        : BaseTags(p), allocAssoc(p.assoc), blks(numBlocks),
+          packedKeys(numBlocks, CacheBlk::InvalidKey),
           sequentialAccess(p.sequential_access),
           replacementPolicy(p.replacement_policy)
     {
@@ -79,29 +80,33 @@ namespace gem5
             // Link block to indexing policy
             indexingPolicy->setEntry(blk, blk_index);
 
+            // Keep a packed copy of the block's tag information
+            blk->setPackedKey(&packedKeys[blk_index]);
+
             // Associate a data chunk to the block
             blk->data = &dataBlks[blkSize * blk_index];
 
             // Associate a replacement data entry to the block
-            replacementPolicy->setCurrentAddr(blk->getTag(), blk->getSet());
-            blk->replacementData = replacementPolicy->instantiateEntry();
+            blk->replacementData = replacementPolicy->instantiateEntry(
+                blk->getSet(), blk->getWay());
         }
     }
 
     void
     BaseSetAssoc::invalidate(CacheBlk *blk)
     {
-        replacementPolicy->setCurrentAddr(blk->getTag(), blk->getSet());
+        // The block loses its tag when invalidated, so the access
+        // information must be gathered first
+        const replacement_policy::AccessContext ctx(regenerateBlkAddr(blk),
+            blk->getTag(), blk->getSet());
+
         BaseTags::invalidate(blk);
 
         // Decrease the number of tags in use
         stats.tagsInUse--;
 
         // Invalidate replacement data
-        // if (typeid(*replacementPolicy).name() == "ARC")
-        // dynamic_cast<replacement_policy::ARC *>(replacementPolicy)->setCurrentAddr(blk->getTag(), blk->getSet());
-        // replacementPolicy->setCurrentAddr(blk->getTag(), blk->getSet());
-        replacementPolicy->invalidate(blk->replacementData);
+        replacementPolicy->invalidate(blk->replacementData, ctx);
     }
 
     void
@@ -112,15 +117,34 @@ namespace gem5
         // Since the blocks were using different replacement data pointers,
         // we must touch the replacement data of the new entry, and invalidate
         // the one that is being moved.
-        // if (typeid(*replacementPolicy).name() == "ARC")
-        // dynamic_cast<replacement_policy::ARC *>(replacementPolicy)->setCurrentAddr(src_blk->getTag(), src_blk->getSet());
-        replacementPolicy->setCurrentAddr(src_blk->getTag(), src_blk->getSet());
-        replacementPolicy->invalidate(src_blk->replacementData);
-
-        // if (typeid(*replacementPolicy).name() == "ARC")
-        // dynamic_cast<replacement_policy::ARC *>(replacementPolicy)->setCurrentAddr(dest_blk->getTag(), dest_blk->getSet());
-        replacementPolicy->setCurrentAddr(dest_blk->getTag(), dest_blk->getSet());
-        replacementPolicy->reset(dest_blk->replacementData);
+        // The moved block's address is now held by the destination
+        const Addr addr = regenerateBlkAddr(dest_blk);
+        replacementPolicy->invalidate(src_blk->replacementData,
+            replacement_policy::AccessContext(addr, dest_blk->getTag(),
+                                              src_blk->getSet()));
+        replacementPolicy->reset(dest_blk->replacementData,
+            replacement_policy::AccessContext(addr, dest_blk->getTag(),
+                                              dest_blk->getSet()));
+    }
+
+    void
+    BaseSetAssoc::serializeReplacement(std::ostream &os)
+    {
+        for (const CacheBlk &blk : blks)
+        {
+            replacementPolicy->serializeEntry(blk.replacementData, os);
+        }
+        replacementPolicy->serializeState(os);
+    }
+
+    void
+    BaseSetAssoc::unserializeReplacement(std::istream &is)
+    {
+        for (CacheBlk &blk : blks)
+        {
+            replacementPolicy->unserializeEntry(blk.replacementData, is);
+        }
+        replacementPolicy->unserializeState(is);
     }
 
 } // namespace gem5
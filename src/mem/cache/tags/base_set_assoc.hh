@@ -82,6 +82,12 @@ namespace gem5
         /** The cache blocks. */
         std::vector<CacheBlk> blks;
 
+        /**
+         * Packed tag information of the cache blocks, indexed like them.
+         * Lookups search these keys instead of dereferencing every block.
+         */
+        std::vector<uint64_t> packedKeys;
+
         /** Whether tags and data are accessed sequentially. */
         const bool sequentialAccess;
 
@@ -115,6 +121,22 @@ namespace gem5
          */
         void invalidate(CacheBlk *blk) override;
 
+        /**
+         * Finds the given address in the cache, without updating any state.
+         * The packed keys of the possible locations of the address are
+         * compared at once, and only the matching block is dereferenced.
+         *
+         * @param addr The address to find.
+         * @param is_secure True if the target memory space is secure.
+         * @return Pointer to the cache block if found.
+         */
+        CacheBlk *findBlock(Addr addr, bool is_secure) const override
+        {
+            return static_cast<CacheBlk *>(indexingPolicy->findEntry(addr,
+                packedKeys.data(),
+                CacheBlk::packKey(extractTag(addr), is_secure)));
+        }
+
         /**
          * Access block and update replacement data. May not succeed, in which case
          * nullptr is returned. This has all the implications of a cache access and
@@ -145,17 +167,18 @@ namespace gem5
                 stats.dataAccesses += allocAssoc;
             }
 
+            if (samplingStats)
+            {
+                sampleLookup(pkt->getAddr(), blk != nullptr);
+            }
+
             // If a cache hit
             if (blk != nullptr)
             {
                 // Update number of references to accessed block
                 blk->increaseRefCount();
 
-                // Update replacement data of accessed block
-                // if (typeid(*replacementPolicy).name() == "ARC")
-                // dynamic_cast<replacement_policy::ARC*>(replacementPolicy)->setCurrentAddr(blk->getTag(), blk->getSet());
-                replacementPolicy->setCurrentAddr(blk->getTag(), blk->getSet());
-                replacementPolicy->touch(blk->replacementData, pkt);
+                touchBlock(blk, pkt);
             }
 
             // The tag lookup latency is the same for a hit or a miss
@@ -164,9 +187,18 @@ namespace gem5
             return blk;
         }
 
+        void touchBlock(CacheBlk *blk, const PacketPtr pkt) override
+        {
+            // Update replacement data of accessed block
+            replacementPolicy->touch(blk->replacementData,
+                replacement_policy::AccessContext(pkt->getAddr(),
+                    blk->getTag(), blk->getSet(), pkt));
+        }
+
         /**
          * Find replacement victim based on address. The list of evicted blocks
-         * only contains the victim.
+         * only contains the victim. There is no victim in the sets that are
+         * not modeled.
          *
          * @param addr Address to find a victim for.
          * @param is_secure True if the target memory space is secure.
@@ -179,19 +211,21 @@ namespace gem5
                              std::vector<CacheBlk *> &evict_blks) override
         {
             // Get possible entries to be victimized
-            const std::vector<ReplaceableEntry *> entries =
+            const std::vector<ReplaceableEntry *> &entries =
                 indexingPolicy->getPossibleEntries(addr);
+            if (entries.empty())
+            {
+                return nullptr;
+            }
+
+            // Describe the access that needs the victim
+            replacement_policy::AccessContext ctx(addr,
+                indexingPolicy->extractTag(addr), entries[0]->getSet());
+            ctx.secure = is_secure;
 
-            // if (typeid(*replacementPolicy).name() == "ARC")
-            // {
-            uint64_t tag = indexingPolicy->extractTag(addr);
-            unsigned int index = entries[0]->getSet();
-            // dynamic_cast<replacement_policy::ARC *>(replacementPolicy)->setCurrentAddr(tag, index);
-            replacementPolicy->setCurrentAddr(tag, index);
-            // }
             // Choose replacement victim from replacement candidates
-            CacheBlk *victim = static_cast<CacheBlk *>(replacementPolicy->getVictim(
-                entries));
+            CacheBlk *victim = static_cast<CacheBlk *>(
+                replacementPolicy->getVictim(entries, ctx));
 
             // There is only one eviction for this replacement
             evict_blks.push_back(victim);
@@ -214,8 +248,9 @@ namespace gem5
             stats.tagsInUse++;
 
             // Update replacement policy
-            replacementPolicy->setCurrentAddr(blk->getTag(), blk->getSet());
-            replacementPolicy->reset(blk->replacementData, pkt);
+            replacementPolicy->reset(blk->replacementData,
+                replacement_policy::AccessContext(pkt->getAddr(),
+                    blk->getTag(), blk->getSet(), pkt));
         }
 
         void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
@@ -269,6 +304,15 @@ namespace gem5
             }
             return false;
         }
+
+        void serializeReplacement(std::ostream &os) override;
+
+        void unserializeReplacement(std::istream &is) override;
+
+        bool replacementCheckpointable() const override
+        {
+            return replacementPolicy->checkpointable();
+        }
     };
 
 } // namespace gem5
@@ -68,8 +68,12 @@ CompressedTags::tagsInit()
         // allocation conditions
         superblock->setBlkSize(blkSize);
 
+        // Link block to indexing policy
+        indexingPolicy->setEntry(superblock, superblock_index);
+
         // Associate a replacement data entry to the block
-        superblock->replacementData = replacementPolicy->instantiateEntry();
+        superblock->replacementData = replacementPolicy->instantiateEntry(
+            superblock->getSet(), superblock->getWay());
 
         // Initialize all blocks in this superblock
         superblock->blks.resize(numBlocksPerSector, nullptr);
@@ -95,9 +99,6 @@ CompressedTags::tagsInit()
             // Update block index
             ++blk_index;
         }
-
-        // Link block to indexing policy
-        indexingPolicy->setEntry(superblock, superblock_index);
     }
 }
 
@@ -107,9 +108,14 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
                            std::vector<CacheBlk*>& evict_blks)
 {
     // Get all possible locations of this superblock
-    const std::vector<ReplaceableEntry*> superblock_entries =
+    const std::vector<ReplaceableEntry*> &superblock_entries =
         indexingPolicy->getPossibleEntries(addr);
 
+    // The sets that are not modeled never hold blocks
+    if (superblock_entries.empty()) {
+        return nullptr;
+    }
+
     // Check if the superblock this address belongs to has been allocated. If
     // so, try co-allocating
     Addr tag = extractTag(addr);
@@ -133,8 +139,11 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
     // superblock must be replaced
     if (victim_superblock == nullptr){
         // Choose replacement victim from replacement candidates
+        replacement_policy::AccessContext ctx(addr, tag,
+            superblock_entries[0]->getSet());
+        ctx.secure = is_secure;
         victim_superblock = static_cast<SuperBlk*>(
-            replacementPolicy->getVictim(superblock_entries));
+            replacementPolicy->getVictim(superblock_entries, ctx));
 
         // The whole superblock must be evicted to make room for the new one
         for (const auto& blk : victim_superblock->blks){
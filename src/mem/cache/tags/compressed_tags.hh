@@ -96,7 +96,8 @@ class CompressedTags : public SectorTags
 
     /**
      * Find replacement victim based on address. Checks if data can be co-
-     * allocated before choosing blocks to be evicted.
+     * allocated before choosing blocks to be evicted. There is no victim in
+     * the sets that are not modeled.
      *
      * @param addr Address to find a victim for.
      * @param is_secure True if the target memory space is secure.
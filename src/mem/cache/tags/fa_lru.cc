@@ -48,7 +48,9 @@
 
 #include <cassert>
 #include <sstream>
+#include <vector>
 
+#include "base/binary_io.hh"
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -148,7 +150,7 @@ FALRU::accessBlock(const PacketPtr pkt, Cycles &lat,
     if (blk && blk->isValid()) {
         mask = blk->inCachesMask;
 
-        moveToHead(blk);
+        touchBlock(blk, pkt);
     }
 
     if (in_caches_mask) {
@@ -163,6 +165,12 @@ FALRU::accessBlock(const PacketPtr pkt, Cycles &lat,
     return blk;
 }
 
+void
+FALRU::touchBlock(CacheBlk *blk, const PacketPtr pkt)
+{
+    moveToHead(static_cast<FALRUBlk*>(blk));
+}
+
 CacheBlk*
 FALRU::findBlock(Addr addr, bool is_secure) const
 {
@@ -256,6 +264,32 @@ FALRU::moveToHead(FALRUBlk *blk)
     }
 }
 
+void
+FALRU::serializeReplacement(std::ostream &os)
+{
+    for (const FALRUBlk *blk = head; blk; blk = blk->next) {
+        binaryOut(os, static_cast<uint32_t>(blk - blks));
+    }
+}
+
+void
+FALRU::unserializeReplacement(std::istream &is)
+{
+    std::vector<FALRUBlk*> order(numBlocks);
+    for (auto &blk : order) {
+        const uint32_t index = binaryIn<uint32_t>(is);
+        fatal_if(index >= numBlocks, "Checkpointed FALRU block %d does not "
+                 "exist.", index);
+        blk = &blks[index];
+    }
+
+    // Moving the blocks to the head from the tail end keeps the cache
+    // tracking consistent
+    for (auto it = order.rbegin(); it != order.rend(); it++) {
+        moveToHead(*it);
+    }
+}
+
 void
 FALRU::moveToTail(FALRUBlk *blk)
 {
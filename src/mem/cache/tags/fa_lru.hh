@@ -189,6 +189,8 @@ class FALRU : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override;
 
+    void touchBlock(CacheBlk *blk, const PacketPtr pkt) override;
+
     /**
      * Find the block in the cache, do not update the replacement data.
      * @param addr The address to look for.
@@ -268,6 +270,20 @@ class FALRU : public BaseTags
         return false;
     }
 
+    /**
+     * Write the order of the LRU list, from head to tail, as block indices.
+     *
+     * @param os The stream to write to.
+     */
+    void serializeReplacement(std::ostream &os) override;
+
+    /**
+     * Restore the order of the LRU list.
+     *
+     * @param is The stream to read from.
+     */
+    void unserializeReplacement(std::istream &is) override;
+
   private:
     /**
      * Mechanism that allows us to simultaneously collect miss
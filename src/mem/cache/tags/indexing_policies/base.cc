@@ -59,7 +59,7 @@ BaseIndexingPolicy::BaseIndexingPolicy(const Params &p)
     : SimObject(p), assoc(p.assoc),
       numSets(p.size / (p.entry_size * assoc)),
       setShift(floorLog2(p.entry_size)), setMask(numSets - 1), sets(numSets),
-      tagShift(setShift + floorLog2(numSets))
+      sampledSetShift(0), tagShift(setShift + floorLog2(numSets))
 {
     fatal_if(!isPowerOf2(numSets), "# of sets must be non-zero and a power " \
              "of 2");
@@ -71,10 +71,22 @@ BaseIndexingPolicy::BaseIndexingPolicy(const Params &p)
     }
 }
 
+void
+BaseIndexingPolicy::sampleSets(const uint32_t period)
+{
+    fatal_if(!isPowerOf2(period) || (period > numSets),
+             "The set sampling period must be a power of 2 no larger than "
+             "the number of sets.");
+
+    sampledSetShift = floorLog2(period);
+    sets.resize(numSets >> sampledSetShift);
+}
+
 ReplaceableEntry*
 BaseIndexingPolicy::getEntry(const uint32_t set, const uint32_t way) const
 {
-    return sets[set][way];
+    assert(isSampledSet(set));
+    return sets[set >> sampledSetShift][way];
 }
 
 void
@@ -82,14 +94,14 @@ BaseIndexingPolicy::setEntry(ReplaceableEntry* entry, const uint64_t index)
 {
     // Calculate set and way from entry index
     const std::lldiv_t div_result = std::div((long long)index, assoc);
-    const uint32_t set = div_result.quot;
+    const uint32_t set = div_result.quot << sampledSetShift;
     const uint32_t way = div_result.rem;
 
     // Sanity check
     assert(set < numSets);
 
     // Assign a free pointer
-    sets[set][way] = entry;
+    sets[div_result.quot][way] = entry;
 
     // Inform the entry its position
     entry->setPosition(set, way);
@@ -47,6 +47,7 @@
 #ifndef __MEM_CACHE_INDEXING_POLICIES_BASE_HH__
 #define __MEM_CACHE_INDEXING_POLICIES_BASE_HH__
 
+#include <cstdint>
 #include <vector>
 
 #include "params/BaseIndexingPolicy.hh"
@@ -87,10 +88,16 @@ class BaseIndexingPolicy : public SimObject
     const unsigned setMask;
 
     /**
-     * The cache sets.
+     * The cache sets. Only the sampled sets have entries (see
+     * sampleSets()), and set s is stored at sets[s >> sampledSetShift].
      */
     std::vector<std::vector<ReplaceableEntry*>> sets;
 
+    /**
+     * Only one set out of every 2^sampledSetShift sets has entries.
+     */
+    unsigned sampledSetShift;
+
     /**
      * The amount to shift the address to get the tag.
      */
@@ -113,7 +120,31 @@ class BaseIndexingPolicy : public SimObject
     ~BaseIndexingPolicy() {};
 
     /**
-     * Associate a pointer to an entry to its physical counterpart.
+     * Only keep entries for one set out of every period sets. The other
+     * sets have no entries, so nothing is ever stored in them, and the
+     * entries of the sampled sets are indexed contiguously by setEntry().
+     * It must be called before any entry is set.
+     *
+     * @param period The sampling period, a power of 2.
+     */
+    void sampleSets(const uint32_t period);
+
+    /**
+     * Whether a set has entries.
+     *
+     * @param set The set.
+     * @return True if the set is sampled (see sampleSets()).
+     */
+    bool
+    isSampledSet(const uint32_t set) const
+    {
+        return (set & ((1 << sampledSetShift) - 1)) == 0;
+    }
+
+    /**
+     * Associate a pointer to an entry to its physical counterpart. The
+     * entries of the sampled sets are indexed contiguously, so entry index
+     * belongs to the (index / assoc)-th sampled set.
      *
      * @param entry The entry pointer.
      * @param index An unique index for the entry.
@@ -122,7 +153,7 @@ class BaseIndexingPolicy : public SimObject
 
     /**
      * Get an entry based on its set and way. All entries must have been set
-     * already before calling this function.
+     * already before calling this function, and the set must be sampled.
      *
      * @param set The set of the desired entry.
      * @param way The way of the desired entry.
@@ -130,6 +161,13 @@ class BaseIndexingPolicy : public SimObject
      */
     ReplaceableEntry* getEntry(const uint32_t set, const uint32_t way) const;
 
+    /**
+     * Get the number of sets.
+     *
+     * @return The number of sets.
+     */
+    uint32_t getNumSets() const { return numSets; }
+
     /**
      * Generate the tag from the given address.
      *
@@ -141,13 +179,29 @@ class BaseIndexingPolicy : public SimObject
     /**
      * Find all possible entries for insertion and replacement of an address.
      * Should be called immediately before ReplacementPolicy's findVictim()
-     * not to break cache resizing.
+     * not to break cache resizing. The entries are not copied, so the
+     * returned reference is only valid until the next call. It is empty
+     * if the address maps to a set that is not sampled.
      *
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
-                                                                    const = 0;
+    virtual const std::vector<ReplaceableEntry*>& getPossibleEntries(
+        const Addr addr) const = 0;
+
+    /**
+     * Find the entry holding a key among the possible entries of an
+     * address, given the packed keys of all entries. The keys are indexed
+     * like the entries in setEntry(), that is, by the index of the sampled
+     * set times assoc, plus the way.
+     *
+     * @param addr The address being looked up.
+     * @param keys The packed keys of all entries.
+     * @param key The key looked for.
+     * @return The entry holding the key, or nullptr if there is none.
+     */
+    virtual ReplaceableEntry* findEntry(const Addr addr,
+        const uint64_t *keys, const uint64_t key) const = 0;
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
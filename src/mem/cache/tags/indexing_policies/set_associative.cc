@@ -47,6 +47,7 @@
 #include "mem/cache/tags/indexing_policies/set_associative.hh"
 
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/cache/tags/tag_search.hh"
 
 namespace gem5
 {
@@ -69,10 +70,27 @@ SetAssociative::regenerateAddr(const Addr tag, const ReplaceableEntry* entry)
     return (tag << tagShift) | (entry->getSet() << setShift);
 }
 
-std::vector<ReplaceableEntry*>
+const std::vector<ReplaceableEntry*>&
 SetAssociative::getPossibleEntries(const Addr addr) const
 {
-    return sets[extractSet(addr)];
+    static const std::vector<ReplaceableEntry*> no_entries;
+
+    const uint32_t set = extractSet(addr);
+    return isSampledSet(set) ? sets[set >> sampledSetShift] : no_entries;
+}
+
+ReplaceableEntry*
+SetAssociative::findEntry(const Addr addr, const uint64_t *keys,
+                          const uint64_t key) const
+{
+    const uint32_t set = extractSet(addr);
+    if (!isSampledSet(set)) {
+        return nullptr;
+    }
+    const uint32_t index = set >> sampledSetShift;
+    const std::size_t way =
+        tag_search::find(keys + index * assoc, assoc, key);
+    return way < assoc ? sets[index][way] : nullptr;
 }
 
 } // namespace gem5
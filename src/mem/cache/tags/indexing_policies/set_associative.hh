@@ -115,8 +115,20 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    const std::vector<ReplaceableEntry*>& getPossibleEntries(
+        const Addr addr) const override;
+
+    /**
+     * Find the entry holding a key. The keys of a set are contiguous, so
+     * they are compared with a single vector search.
+     *
+     * @param addr The address being looked up.
+     * @param keys The packed keys of all entries.
+     * @param key The key looked for.
+     * @return The entry holding the key, or nullptr if there is none.
+     */
+    ReplaceableEntry* findEntry(const Addr addr, const uint64_t *keys,
+                                const uint64_t key) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -37,12 +37,14 @@
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/cache/tags/tag_search.hh"
 
 namespace gem5
 {
 
 SkewedAssociative::SkewedAssociative(const Params &p)
-    : BaseIndexingPolicy(p), msbShift(floorLog2(numSets) - 1)
+    : BaseIndexingPolicy(p), msbShift(floorLog2(numSets) - 1),
+      possibleEntries(assoc), possibleIndices(assoc)
 {
     if (assoc > NUM_SKEWING_FUNCTIONS) {
         warn_once("Associativity higher than number of skewing functions. " \
@@ -206,18 +208,29 @@ SkewedAssociative::regenerateAddr(const Addr tag,
            ((deskew(addr_set, entry->getWay()) & setMask) << setShift);
 }
 
-std::vector<ReplaceableEntry*>
+const std::vector<ReplaceableEntry*>&
 SkewedAssociative::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry*> entries;
-
     // Parse all ways
     for (uint32_t way = 0; way < assoc; ++way) {
         // Apply hash to get set, and get way entry in it
-        entries.push_back(sets[extractSet(addr, way)][way]);
+        possibleEntries[way] = sets[extractSet(addr, way)][way];
+    }
+
+    return possibleEntries;
+}
+
+ReplaceableEntry*
+SkewedAssociative::findEntry(const Addr addr, const uint64_t *keys,
+                             const uint64_t key) const
+{
+    for (uint32_t way = 0; way < assoc; ++way) {
+        possibleIndices[way] = extractSet(addr, way) * assoc + way;
     }
 
-    return entries;
+    const std::size_t way =
+        tag_search::find(keys, possibleIndices.data(), assoc, key);
+    return way < assoc ? sets[possibleIndices[way] / assoc][way] : nullptr;
 }
 
 } // namespace gem5
@@ -34,6 +34,7 @@
 #ifndef __MEM_CACHE_INDEXING_POLICIES_SKEWED_ASSOCIATIVE_HH__
 #define __MEM_CACHE_INDEXING_POLICIES_SKEWED_ASSOCIATIVE_HH__
 
+#include <cstdint>
 #include <vector>
 
 #include "mem/cache/tags/indexing_policies/base.hh"
@@ -85,6 +86,18 @@ class SkewedAssociative : public BaseIndexingPolicy
      */
     const int msbShift;
 
+    /**
+     * The possible entries of the last address looked up. They are kept
+     * here so that they are not allocated on every lookup.
+     */
+    mutable std::vector<ReplaceableEntry*> possibleEntries;
+
+    /**
+     * Index in the packed keys of the possible entries of the last address
+     * looked up, by way.
+     */
+    mutable std::vector<uint32_t> possibleIndices;
+
     /**
      * The hash function itself. Uses the hash function H, as described in
      * "Skewed-Associative Caches", from Seznec et al. (section 3.3): It
@@ -160,8 +173,20 @@ class SkewedAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                   override;
+    const std::vector<ReplaceableEntry*>& getPossibleEntries(
+        const Addr addr) const override;
+
+    /**
+     * Find the entry holding a key. The keys of the possible entries are
+     * gathered from their sets, and compared with a single vector search.
+     *
+     * @param addr The address being looked up.
+     * @param keys The packed keys of all entries.
+     * @param key The key looked for.
+     * @return The entry holding the key, or nullptr if there is none.
+     */
+    ReplaceableEntry* findEntry(const Addr addr, const uint64_t *keys,
+                                const uint64_t key) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
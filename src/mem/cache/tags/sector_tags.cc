@@ -82,8 +82,12 @@ SectorTags::tagsInit()
         // Locate next cache sector
         SectorBlk* sec_blk = &secBlks[sec_blk_index];
 
+        // Link block to indexing policy
+        indexingPolicy->setEntry(sec_blk, sec_blk_index);
+
         // Associate a replacement data entry to the sector
-        sec_blk->replacementData = replacementPolicy->instantiateEntry();
+        sec_blk->replacementData = replacementPolicy->instantiateEntry(
+            sec_blk->getSet(), sec_blk->getWay());
 
         // Initialize all blocks in this sector
         sec_blk->blks.resize(numBlocksPerSector);
@@ -109,21 +113,22 @@ SectorTags::tagsInit()
             // Update block index
             ++blk_index;
         }
-
-        // Link block to indexing policy
-        indexingPolicy->setEntry(sec_blk, sec_blk_index);
     }
 }
 
 void
 SectorTags::invalidate(CacheBlk *blk)
 {
-    BaseTags::invalidate(blk);
-
     // Get block's sector
     SectorSubBlk* sub_blk = static_cast<SectorSubBlk*>(blk);
     const SectorBlk* sector_blk = sub_blk->getSectorBlock();
 
+    // The sector may lose its tag, so describe it before invalidating
+    const replacement_policy::AccessContext ctx =
+        sectorContext(sector_blk, sector_blk->getTag());
+
+    BaseTags::invalidate(blk);
+
     // When a block in a sector is invalidated, it does not make the tag
     // invalid automatically, as there might be other blocks in the sector
     // using it. The tag is invalidated only when there is a single block
@@ -134,7 +139,7 @@ SectorTags::invalidate(CacheBlk *blk)
         assert(stats.tagsInUse.value() >= 0);
 
         // Invalidate replacement data, as we're invalidating the sector
-        replacementPolicy->invalidate(sector_blk->replacementData);
+        replacementPolicy->invalidate(sector_blk->replacementData, ctx);
     }
 }
 
@@ -155,18 +160,16 @@ SectorTags::accessBlock(const PacketPtr pkt, Cycles &lat)
         stats.dataAccesses += allocAssoc*numBlocksPerSector;
     }
 
+    if (samplingStats) {
+        sampleLookup(pkt->getAddr(), blk != nullptr);
+    }
+
     // If a cache hit
     if (blk != nullptr) {
         // Update number of references to accessed block
         blk->increaseRefCount();
 
-        // Get block's sector
-        SectorSubBlk* sub_blk = static_cast<SectorSubBlk*>(blk);
-        const SectorBlk* sector_blk = sub_blk->getSectorBlock();
-
-        // Update replacement data of accessed block, which is shared with
-        // the whole sector it belongs to
-        replacementPolicy->touch(sector_blk->replacementData, pkt);
+        touchBlock(blk, pkt);
     }
 
     // The tag lookup latency is the same for a hit or a miss
@@ -175,6 +178,19 @@ SectorTags::accessBlock(const PacketPtr pkt, Cycles &lat)
     return blk;
 }
 
+void
+SectorTags::touchBlock(CacheBlk *blk, const PacketPtr pkt)
+{
+    // Get block's sector
+    SectorSubBlk* sub_blk = static_cast<SectorSubBlk*>(blk);
+    const SectorBlk* sector_blk = sub_blk->getSectorBlock();
+
+    // Update replacement data of accessed block, which is shared with
+    // the whole sector it belongs to
+    replacementPolicy->touch(sector_blk->replacementData,
+        sectorContext(sector_blk, sector_blk->getTag(), pkt));
+}
+
 void
 SectorTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
 {
@@ -182,18 +198,22 @@ SectorTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     SectorSubBlk* sub_blk = static_cast<SectorSubBlk*>(blk);
     const SectorBlk* sector_blk = sub_blk->getSectorBlock();
 
+    // The sector is not tagged yet if it was not present in the cache
+    const replacement_policy::AccessContext ctx =
+        sectorContext(sector_blk, extractTag(pkt->getAddr()), pkt);
+
     // When a block is inserted, the tag is only a newly used tag if the
     // sector was not previously present in the cache.
     if (sector_blk->isValid()) {
         // An existing entry's replacement data is just updated
-        replacementPolicy->touch(sector_blk->replacementData, pkt);
+        replacementPolicy->touch(sector_blk->replacementData, ctx);
     } else {
         // Increment tag counter
         stats.tagsInUse++;
         assert(stats.tagsInUse.value() <= numSectors);
 
         // A new entry resets the replacement data
-        replacementPolicy->reset(sector_blk->replacementData, pkt);
+        replacementPolicy->reset(sector_blk->replacementData, ctx);
     }
 
     // Do common block insertion functionality
@@ -222,9 +242,11 @@ SectorTags::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
     // invalid automatically, as there might be other blocks in the sector
     // using it. The tag is invalidated only when there is a single block
     // in the sector.
+    const Addr tag = dest_sector_blk->getTag();
     if (!src_sector_blk->isValid()) {
         // Invalidate replacement data, as we're invalidating the sector
-        replacementPolicy->invalidate(src_sector_blk->replacementData);
+        replacementPolicy->invalidate(src_sector_blk->replacementData,
+            sectorContext(src_sector_blk, tag));
 
         if (dest_was_valid) {
             // If destination sector was valid, and the source sector became
@@ -239,10 +261,12 @@ SectorTags::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
         assert(stats.tagsInUse.value() <= numSectors);
     }
 
+    const replacement_policy::AccessContext ctx =
+        sectorContext(dest_sector_blk, tag);
     if (dest_was_valid) {
-        replacementPolicy->touch(dest_sector_blk->replacementData);
+        replacementPolicy->touch(dest_sector_blk->replacementData, ctx);
     } else {
-        replacementPolicy->reset(dest_sector_blk->replacementData);
+        replacementPolicy->reset(dest_sector_blk->replacementData, ctx);
     }
 }
 
@@ -257,7 +281,7 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     const Addr offset = extractSectorOffset(addr);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
+    const std::vector<ReplaceableEntry*> &entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Search for block
@@ -277,9 +301,14 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
                        std::vector<CacheBlk*>& evict_blks)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> sector_entries =
+    const std::vector<ReplaceableEntry*> &sector_entries =
         indexingPolicy->getPossibleEntries(addr);
 
+    // The sets that are not modeled never hold blocks
+    if (sector_entries.empty()) {
+        return nullptr;
+    }
+
     // Check if the sector this address belongs to has been allocated
     Addr tag = extractTag(addr);
     SectorBlk* victim_sector = nullptr;
@@ -294,8 +323,11 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
     // If the sector is not present
     if (victim_sector == nullptr){
         // Choose replacement victim from replacement candidates
+        replacement_policy::AccessContext ctx(addr, tag,
+            sector_entries[0]->getSet());
+        ctx.secure = is_secure;
         victim_sector = static_cast<SectorBlk*>(replacementPolicy->getVictim(
-                                                sector_entries));
+                                                sector_entries, ctx));
     }
 
     // Get the entry of the victim block within the sector
@@ -328,6 +360,15 @@ SectorTags::extractSectorOffset(Addr addr) const
     return (addr >> sectorShift) & sectorMask;
 }
 
+replacement_policy::AccessContext
+SectorTags::sectorContext(const SectorBlk* sector_blk, Addr tag,
+                          const PacketPtr pkt) const
+{
+    return replacement_policy::AccessContext(
+        indexingPolicy->regenerateAddr(tag, sector_blk), tag,
+        sector_blk->getSet(), pkt);
+}
+
 Addr
 SectorTags::regenerateBlkAddr(const CacheBlk* blk) const
 {
@@ -378,4 +419,30 @@ SectorTags::anyBlk(std::function<bool(CacheBlk &)> visitor)
     return false;
 }
 
+void
+SectorTags::serializeReplacement(std::ostream &os)
+{
+    // Visit the blocks through forEachBlk, as the sectors may be owned by
+    // a derived class
+    forEachBlk([this, &os](CacheBlk &blk) {
+        SectorSubBlk &sub_blk = static_cast<SectorSubBlk&>(blk);
+        if (sub_blk.getSectorBlock()->blks.front() == &sub_blk) {
+            replacementPolicy->serializeEntry(blk.replacementData, os);
+        }
+    });
+    replacementPolicy->serializeState(os);
+}
+
+void
+SectorTags::unserializeReplacement(std::istream &is)
+{
+    forEachBlk([this, &is](CacheBlk &blk) {
+        SectorSubBlk &sub_blk = static_cast<SectorSubBlk&>(blk);
+        if (sub_blk.getSectorBlock()->blks.front() == &sub_blk) {
+            replacementPolicy->unserializeEntry(blk.replacementData, is);
+        }
+    });
+    replacementPolicy->unserializeState(is);
+}
+
 } // namespace gem5
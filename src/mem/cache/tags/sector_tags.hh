@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "base/statistics.hh"
+#include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/sector_blk.hh"
 #include "mem/packet.hh"
@@ -106,6 +107,18 @@ class SectorTags : public BaseTags
         statistics::Vector evictionsReplacement;
     } sectorStats;
 
+    /**
+     * Describe an access to a sector for the replacement policy.
+     *
+     * @param sector_blk The sector being accessed.
+     * @param tag The sector tag being accessed.
+     * @param pkt The packet causing the access, if any.
+     * @return The access context of the sector.
+     */
+    replacement_policy::AccessContext sectorContext(
+        const SectorBlk* sector_blk, Addr tag,
+        const PacketPtr pkt = nullptr) const;
+
   public:
     /** Convenience typedef. */
      typedef SectorTagsParams Params;
@@ -145,6 +158,8 @@ class SectorTags : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override;
 
+    void touchBlock(CacheBlk *blk, const PacketPtr pkt) override;
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -166,7 +181,8 @@ class SectorTags : public BaseTags
     CacheBlk* findBlock(Addr addr, bool is_secure) const override;
 
     /**
-     * Find replacement victim based on address.
+     * Find replacement victim based on address. There is no victim in the
+     * sets that are not modeled.
      *
      * @param addr Address to find a victim for.
      * @param is_secure True if the target memory space is secure.
@@ -214,6 +230,19 @@ class SectorTags : public BaseTags
      * @param visitor Visitor to call on each block.
      */
     bool anyBlk(std::function<bool(CacheBlk &)> visitor) override;
+
+    /**
+     * The replacement data is shared by the blocks of a sector, so it is
+     * written once per sector, along with the first block of the sector.
+     */
+    void serializeReplacement(std::ostream &os) override;
+    void unserializeReplacement(std::istream &is) override;
+
+    bool
+    replacementCheckpointable() const override
+    {
+        return replacementPolicy->checkpointable();
+    }
 };
 
 } // namespace gem5
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/set_sampling.hh"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+namespace gem5
+{
+
+namespace set_sampling
+{
+
+double
+missRatioError(const std::vector<uint64_t> &set_accesses,
+               const std::vector<uint64_t> &set_misses, uint32_t num_sets)
+{
+    assert(set_accesses.size() == set_misses.size());
+    assert(set_accesses.size() <= num_sets);
+
+    const double n = set_accesses.size();
+    double accesses = 0;
+    double misses = 0;
+    for (std::size_t i = 0; i < set_accesses.size(); i++) {
+        accesses += set_accesses[i];
+        misses += set_misses[i];
+    }
+    if ((n < 2) || (accesses == 0)) {
+        return 0;
+    }
+
+    // Variance of the ratio estimator of a cluster sample, with the
+    // finite population correction
+    const double ratio = misses / accesses;
+    const double mean_accesses = accesses / n;
+    double residuals = 0;
+    for (std::size_t i = 0; i < set_accesses.size(); i++) {
+        const double residual = set_misses[i] - ratio * set_accesses[i];
+        residuals += residual * residual;
+    }
+    const double variance = (1 - n / num_sets) * residuals /
+        ((n - 1) * n * mean_accesses * mean_accesses);
+
+    return 1.96 * std::sqrt(variance);
+}
+
+} // namespace set_sampling
+} // namespace gem5
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Estimation of the miss ratio of a cache that only models some of its
+ * sets.
+ *
+ * Every modeled set is a cluster of lookups, so the modeled sets are a
+ * cluster sample of the lookups of the cache, and the miss ratio is a
+ * ratio estimator: the misses over the lookups of the modeled sets. Its
+ * variance accounts for the variation of the miss ratio across sets, and
+ * includes the finite population correction, as a large fraction of the
+ * sets may be modeled.
+ */
+
+#ifndef __MEM_CACHE_TAGS_SET_SAMPLING_HH__
+#define __MEM_CACHE_TAGS_SET_SAMPLING_HH__
+
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+namespace set_sampling
+{
+
+/**
+ * Half width of the 95% confidence interval of the miss ratio estimated
+ * from the modeled sets.
+ *
+ * @param set_accesses The number of lookups of every modeled set.
+ * @param set_misses The number of misses of every modeled set.
+ * @param num_sets The number of sets of the cache, modeled or not.
+ * @return The half width, or 0 if there are less than 2 modeled sets or
+ *         no lookups.
+ */
+double missRatioError(const std::vector<uint64_t> &set_accesses,
+                      const std::vector<uint64_t> &set_misses,
+                      uint32_t num_sets);
+
+} // namespace set_sampling
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_SET_SAMPLING_HH__
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/set_sampling.hh"
+
+using namespace gem5;
+using set_sampling::missRatioError;
+
+/** There is no interval without two modeled sets and some lookups. */
+TEST(SetSamplingTest, Degenerate)
+{
+    ASSERT_EQ(missRatioError({}, {}, 16), 0);
+    ASSERT_EQ(missRatioError({10}, {5}, 16), 0);
+    ASSERT_EQ(missRatioError({0, 0, 0}, {0, 0, 0}, 16), 0);
+}
+
+/** Modeling every set leaves no sampling error. */
+TEST(SetSamplingTest, AllSetsModeled)
+{
+    ASSERT_EQ(missRatioError({10, 20, 30, 40}, {1, 8, 3, 30}, 4), 0);
+}
+
+/** Sets with the same miss ratio leave no sampling error. */
+TEST(SetSamplingTest, UniformMissRatio)
+{
+    ASSERT_EQ(missRatioError({10, 20, 40, 80}, {5, 10, 20, 40}, 64), 0);
+}
+
+/** The half width of a sample worked out by hand. */
+TEST(SetSamplingTest, KnownValue)
+{
+    // The ratio is 16 / 40, so the residuals are -3, -1, 1 and 3. The
+    // variance is (1 - 4 / 8) * 20 / (3 * 4 * 10 * 10) = 1 / 120.
+    ASSERT_NEAR(missRatioError({10, 10, 10, 10}, {1, 3, 5, 7}, 8),
+                0.178923, 1e-6);
+}
+
+/**
+ * The interval holds the miss ratio of the whole cache about 95% of the
+ * time, when the sets have different lookup counts and miss ratios.
+ */
+TEST(SetSamplingTest, Coverage)
+{
+    const uint32_t num_sets = 1024;
+    const uint32_t period = 16;
+    const int trials = 2000;
+
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<uint64_t> accesses_dist(50, 500);
+    std::uniform_real_distribution<double> ratio_dist(0.05, 0.6);
+    std::uniform_int_distribution<uint32_t> offset_dist(0, period - 1);
+
+    int covered = 0;
+    for (int trial = 0; trial < trials; trial++) {
+        std::vector<uint64_t> accesses(num_sets);
+        std::vector<uint64_t> misses(num_sets);
+        double total_accesses = 0;
+        double total_misses = 0;
+        for (uint32_t set = 0; set < num_sets; set++) {
+            accesses[set] = accesses_dist(rng);
+            std::binomial_distribution<uint64_t> misses_dist(
+                accesses[set], ratio_dist(rng));
+            misses[set] = misses_dist(rng);
+            total_accesses += accesses[set];
+            total_misses += misses[set];
+        }
+
+        // Model one set out of every period, from a random offset
+        std::vector<uint64_t> set_accesses;
+        std::vector<uint64_t> set_misses;
+        double sampled_accesses = 0;
+        double sampled_misses = 0;
+        for (uint32_t set = offset_dist(rng); set < num_sets;
+             set += period) {
+            set_accesses.push_back(accesses[set]);
+            set_misses.push_back(misses[set]);
+            sampled_accesses += accesses[set];
+            sampled_misses += misses[set];
+        }
+
+        const double error =
+            missRatioError(set_accesses, set_misses, num_sets);
+        ASSERT_GT(error, 0);
+        const double estimate = sampled_misses / sampled_accesses;
+        const double ratio = total_misses / total_accesses;
+        if ((estimate - error <= ratio) && (ratio <= estimate + error)) {
+            covered++;
+        }
+    }
+
+    const double coverage = static_cast<double>(covered) / trials;
+    ASSERT_GT(coverage, 0.92);
+    ASSERT_LT(coverage, 0.98);
+}
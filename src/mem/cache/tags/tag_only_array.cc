@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/tag_only_array.hh"
+
+#include "mem/cache/tags/indexing_policies/base.hh"
+
+namespace gem5
+{
+
+TagOnlyArray::TagOnlyArray(BaseIndexingPolicy *indexing_policy,
+                           replacement_policy::Base *replacement_policy,
+                           std::size_t num_blocks)
+    : indexingPolicy(indexing_policy),
+      replacementPolicy(replacement_policy), blocks(num_blocks)
+{
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+        Block &blk = blocks[i];
+        indexingPolicy->setEntry(&blk, i);
+        blk.replacementData = replacementPolicy->instantiateEntry(
+            blk.getSet(), blk.getWay());
+    }
+}
+
+TagOnlyArray::Outcome
+TagOnlyArray::access(replacement_policy::AccessContext ctx)
+{
+    using replacement_policy::AccessContext;
+
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(ctx.addr);
+    ctx.tag = indexingPolicy->extractTag(ctx.addr);
+    ctx.set = entries[0]->getSet();
+
+    for (auto entry : entries) {
+        Block *blk = static_cast<Block*>(entry);
+        if (blk->valid && blk->tag == ctx.tag && blk->secure == ctx.secure) {
+            replacementPolicy->touch(blk->replacementData, ctx);
+            return Outcome::Hit;
+        }
+    }
+
+    Block *victim =
+        static_cast<Block*>(replacementPolicy->getVictim(entries, ctx));
+    const bool replaced = victim->valid;
+    if (replaced) {
+        AccessContext victim_ctx(
+            indexingPolicy->regenerateAddr(victim->tag, victim),
+            victim->tag, victim->getSet());
+        victim_ctx.secure = victim->secure;
+        replacementPolicy->invalidate(victim->replacementData, victim_ctx);
+    }
+    victim->tag = ctx.tag;
+    victim->secure = ctx.secure;
+    victim->valid = true;
+    replacementPolicy->reset(victim->replacementData, ctx);
+
+    return replaced ? Outcome::Replacement : Outcome::Miss;
+}
+
+ReplayClock::ReplayClock(const std::string &name)
+    : eventq(name)
+{
+    curEventQueue(&eventq);
+}
+
+ReplayClock::~ReplayClock()
+{
+    curEventQueue(nullptr);
+}
+
+} // namespace gem5
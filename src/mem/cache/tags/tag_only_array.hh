@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A tag-only set-associative array, used to evaluate replacement policies
+ * away from a real cache: on the accesses of a cache, as ShadowTagsProbe
+ * does, or on a recorded trace, as repl_trace_eval does.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_ONLY_ARRAY_HH__
+#define __MEM_CACHE_TAGS_TAG_ONLY_ARRAY_HH__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+class BaseIndexingPolicy;
+
+/**
+ * An array of tags laid out as BaseSetAssoc does. It holds no data and no
+ * coherence state: an access either hits on a valid block with the same
+ * tag, or misses and replaces the victim chosen by the replacement policy.
+ */
+class TagOnlyArray
+{
+  public:
+    /** What an access did. */
+    enum class Outcome
+    {
+        /** It hit. */
+        Hit,
+        /** It missed, and filled an invalid block. */
+        Miss,
+        /** It missed, and replaced a valid block. */
+        Replacement
+    };
+
+    /**
+     * Lay the blocks out. The policies must not be shared with any other
+     * array.
+     *
+     * @param indexing_policy The indexing policy.
+     * @param replacement_policy The replacement policy.
+     * @param num_blocks The number of blocks.
+     */
+    TagOnlyArray(BaseIndexingPolicy *indexing_policy,
+                 replacement_policy::Base *replacement_policy,
+                 std::size_t num_blocks);
+
+    /**
+     * Look an access up, and allocate a block for it on a miss.
+     *
+     * @param ctx The access. Its tag and set are filled in by the array.
+     * @return What the access did.
+     */
+    Outcome access(replacement_policy::AccessContext ctx);
+
+  private:
+    /** A block of the array. */
+    class Block : public ReplaceableEntry
+    {
+      public:
+        Addr tag = MaxAddr;
+        bool secure = false;
+        bool valid = false;
+    };
+
+    BaseIndexingPolicy *const indexingPolicy;
+
+    replacement_policy::Base *const replacementPolicy;
+
+    std::vector<Block> blocks;
+};
+
+/**
+ * The current tick of a thread that replays accesses away from the
+ * simulation thread. The replacement policies read the current tick from
+ * the current event queue, which is private to each thread, so the thread
+ * gets an event queue of its own, whose tick is the one of the access
+ * being replayed. It is only installed while the clock exists.
+ */
+class ReplayClock
+{
+  public:
+    ReplayClock(const std::string &name);
+    ~ReplayClock();
+
+    /**
+     * Set the current tick of the thread.
+     *
+     * @param tick The tick of the access about to be replayed.
+     */
+    void set(Tick tick) { eventq.setCurTick(tick); }
+
+  private:
+    EventQueue eventq;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_TAG_ONLY_ARRAY_HH__
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/tag_search.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TAG_SEARCH_X86 1
+#include <immintrin.h>
+#else
+#define TAG_SEARCH_X86 0
+#endif
+
+namespace gem5
+{
+
+namespace tag_search
+{
+
+namespace
+{
+
+typedef std::size_t (*Kernel)(const uint64_t *keys, std::size_t n,
+                              uint64_t key);
+typedef std::size_t (*GatherKernel)(const uint64_t *keys,
+                                    const uint32_t *indices, std::size_t n,
+                                    uint64_t key);
+
+std::size_t
+findScalar(const uint64_t *keys, std::size_t n, uint64_t key)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+std::size_t
+findGatherScalar(const uint64_t *keys, const uint32_t *indices,
+                 std::size_t n, uint64_t key)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        if (keys[indices[i]] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#if TAG_SEARCH_X86
+
+/**
+ * The vector kernels compare the keys of up to 64 ways against the key
+ * looked for, accumulating the matches in a bitmask whose lowest bit is
+ * the way found, so that a lookup has a single data-dependent branch for
+ * sets of up to 64 ways. Larger sets are searched in groups of 64 ways.
+ * Lanes past the last way are not loaded, and are cleared from the bitmask.
+ */
+
+/** Mask of the lowest n bits of a 64-bit word. */
+inline uint64_t
+lowBits(std::size_t n)
+{
+    return n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+}
+
+/** Mask of the lanes of a 4-lane vector that hold one of n ways. */
+__attribute__((target("avx2")))
+inline __m256i
+validLanesAVX2(std::size_t n)
+{
+    return _mm256_cmpgt_epi64(_mm256_set1_epi64x(n),
+                              _mm256_set_epi64x(3, 2, 1, 0));
+}
+
+/** Search up to 64 contiguous keys. */
+__attribute__((target("avx2")))
+uint64_t
+matchAVX2(const uint64_t *keys, std::size_t n, __m256i k)
+{
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m256i v = n - i >= 4 ?
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)) :
+            _mm256_maskload_epi64(reinterpret_cast<const long long*>(
+                keys + i), validLanesAVX2(n - i));
+        const __m256i equal = _mm256_cmpeq_epi64(v, k);
+        found |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) <<
+            i;
+    }
+    return found & lowBits(n);
+}
+
+/** Search the keys of up to 64 ways, given their indices. */
+__attribute__((target("avx2")))
+uint64_t
+matchGatherAVX2(const uint64_t *keys, const uint32_t *indices,
+                std::size_t n, __m256i k)
+{
+    const long long *base = reinterpret_cast<const long long*>(keys);
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i += 4) {
+        __m256i v;
+        if (n - i >= 4) {
+            const __m128i vindex = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(indices + i));
+            v = _mm256_i32gather_epi64(base, vindex, 8);
+        } else {
+            uint32_t tail[4] = {0, 0, 0, 0};
+            std::copy(indices + i, indices + n, tail);
+            const __m128i vindex = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(tail));
+            v = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), base,
+                vindex, validLanesAVX2(n - i), 8);
+        }
+        const __m256i equal = _mm256_cmpeq_epi64(v, k);
+        found |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) <<
+            i;
+    }
+    return found & lowBits(n);
+}
+
+/** Search up to 64 contiguous keys. */
+__attribute__((target("avx512f")))
+uint64_t
+matchAVX512(const uint64_t *keys, std::size_t n, __m512i k)
+{
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 valid = n - i >= 8 ? 0xff : (1 << (n - i)) - 1;
+        const __m512i v = _mm512_maskz_loadu_epi64(valid, keys + i);
+        found |= uint64_t(_mm512_mask_cmpeq_epu64_mask(valid, v, k)) << i;
+    }
+    return found;
+}
+
+/** Search the keys of up to 64 ways, given their indices. */
+__attribute__((target("avx512f")))
+uint64_t
+matchGatherAVX512(const uint64_t *keys, const uint32_t *indices,
+                  std::size_t n, __m512i k)
+{
+    uint64_t found = 0;
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __mmask8 valid = n - i >= 8 ? 0xff : (1 << (n - i)) - 1;
+        uint32_t tail[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        const uint32_t *lane_indices = indices + i;
+        if (n - i < 8) {
+            std::copy(indices + i, indices + n, tail);
+            lane_indices = tail;
+        }
+        const __m256i vindex = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(lane_indices));
+        const __m512i v = _mm512_mask_i32gather_epi64(
+            _mm512_setzero_si512(), valid, vindex, keys, 8);
+        found |= uint64_t(_mm512_mask_cmpeq_epu64_mask(valid, v, k)) << i;
+    }
+    return found;
+}
+
+__attribute__((target("avx2")))
+std::size_t
+findAVX2(const uint64_t *keys, std::size_t n, uint64_t key)
+{
+    const __m256i k = _mm256_set1_epi64x(key);
+    for (std::size_t base = 0; base < n; base += 64) {
+        const uint64_t found =
+            matchAVX2(keys + base, std::min<std::size_t>(n - base, 64), k);
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    return n;
+}
+
+__attribute__((target("avx2")))
+std::size_t
+findGatherAVX2(const uint64_t *keys, const uint32_t *indices, std::size_t n,
+               uint64_t key)
+{
+    const __m256i k = _mm256_set1_epi64x(key);
+    for (std::size_t base = 0; base < n; base += 64) {
+        const uint64_t found = matchGatherAVX2(keys, indices + base,
+            std::min<std::size_t>(n - base, 64), k);
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    return n;
+}
+
+__attribute__((target("avx512f")))
+std::size_t
+findAVX512(const uint64_t *keys, std::size_t n, uint64_t key)
+{
+    const __m512i k = _mm512_set1_epi64(key);
+    for (std::size_t base = 0; base < n; base += 64) {
+        const uint64_t found =
+            matchAVX512(keys + base, std::min<std::size_t>(n - base, 64), k);
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    return n;
+}
+
+__attribute__((target("avx512f")))
+std::size_t
+findGatherAVX512(const uint64_t *keys, const uint32_t *indices,
+                 std::size_t n, uint64_t key)
+{
+    const __m512i k = _mm512_set1_epi64(key);
+    for (std::size_t base = 0; base < n; base += 64) {
+        const uint64_t found = matchGatherAVX512(keys, indices + base,
+            std::min<std::size_t>(n - base, 64), k);
+        if (found) {
+            return base + __builtin_ctzll(found);
+        }
+    }
+    return n;
+}
+
+#endif // TAG_SEARCH_X86
+
+Kernel
+kernel(Isa isa)
+{
+    switch (isa) {
+#if TAG_SEARCH_X86
+      case Isa::AVX2:
+        return findAVX2;
+      case Isa::AVX512:
+        return findAVX512;
+#endif
+      default:
+        return findScalar;
+    }
+}
+
+GatherKernel
+gatherKernel(Isa isa)
+{
+    switch (isa) {
+#if TAG_SEARCH_X86
+      case Isa::AVX2:
+        return findGatherAVX2;
+      case Isa::AVX512:
+        return findGatherAVX512;
+#endif
+      default:
+        return findGatherScalar;
+    }
+}
+
+/** Kernels of the best instruction set, chosen on first use. */
+struct DefaultKernels
+{
+    const Kernel find;
+    const GatherKernel findGather;
+
+    DefaultKernels()
+      : find(kernel(replacement_policy::victim_search::bestIsa())),
+        findGather(gatherKernel(replacement_policy::victim_search::bestIsa()))
+    {}
+};
+
+const DefaultKernels&
+defaultKernels()
+{
+    static const DefaultKernels kernels;
+    return kernels;
+}
+
+} // anonymous namespace
+
+std::size_t
+find(const uint64_t *keys, std::size_t n, uint64_t key)
+{
+    return defaultKernels().find(keys, n, key);
+}
+
+std::size_t
+find(const uint64_t *keys, const uint32_t *indices, std::size_t n,
+     uint64_t key)
+{
+    return defaultKernels().findGather(keys, indices, n, key);
+}
+
+std::size_t
+find(const uint64_t *keys, std::size_t n, uint64_t key, Isa isa)
+{
+    panic_if(!replacement_policy::victim_search::isaSupported(isa),
+             "Tag search ISA not supported.");
+    return kernel(isa)(keys, n, key);
+}
+
+std::size_t
+find(const uint64_t *keys, const uint32_t *indices, std::size_t n,
+     uint64_t key, Isa isa)
+{
+    panic_if(!replacement_policy::victim_search::isaSupported(isa),
+             "Tag search ISA not supported.");
+    return gatherKernel(isa)(keys, indices, n, key);
+}
+
+} // namespace tag_search
+} // namespace gem5
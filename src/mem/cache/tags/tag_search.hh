@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Search kernels used by tag stores to find the way holding a block.
+ *
+ * The tag, valid and secure bits of every entry are packed into a 64-bit
+ * key (see TaggedEntry::packKey()), and the keys are kept in an array
+ * indexed by entry, next to the entries themselves. A lookup compares the
+ * key being looked for against the keys of all the ways at once, using the
+ * widest vector instructions supported by the host. The keys of the ways
+ * are either contiguous, as in set-associative tables, or gathered through
+ * per-way indices, as in skewed-associative tables.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_SEARCH_HH__
+#define __MEM_CACHE_TAGS_TAG_SEARCH_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mem/cache/replacement_policies/victim_search.hh"
+
+namespace gem5
+{
+
+namespace tag_search
+{
+
+/** The search kernels use the instruction sets of the victim search. */
+typedef replacement_policy::victim_search::Isa Isa;
+
+/**
+ * Find the first occurrence of a key in a contiguous array.
+ *
+ * @param keys The keys of the ways.
+ * @param n Number of ways.
+ * @param key The key looked for.
+ * @return The index of the first matching key, or n if there is none.
+ */
+std::size_t find(const uint64_t *keys, std::size_t n, uint64_t key);
+
+/**
+ * Find the first occurrence of a key among the keys at some indices.
+ *
+ * @param keys The keys of all entries.
+ * @param indices Index in keys of the key of every way.
+ * @param n Number of ways.
+ * @param key The key looked for.
+ * @return The way of the first matching key, or n if there is none.
+ */
+std::size_t find(const uint64_t *keys, const uint32_t *indices,
+                 std::size_t n, uint64_t key);
+
+/**
+ * Variants of find() that use the kernels of a given instruction set,
+ * which must be supported by the host.
+ */
+std::size_t find(const uint64_t *keys, std::size_t n, uint64_t key, Isa isa);
+std::size_t find(const uint64_t *keys, const uint32_t *indices,
+                 std::size_t n, uint64_t key, Isa isa);
+
+} // namespace tag_search
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_TAG_SEARCH_HH__
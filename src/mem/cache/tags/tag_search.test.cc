@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/tag_search.hh"
+
+using namespace gem5;
+using replacement_policy::victim_search::isaSupported;
+using tag_search::Isa;
+
+namespace
+{
+
+/** All instruction sets the host can run. */
+std::vector<Isa>
+supportedIsas()
+{
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::Scalar, Isa::AVX2, Isa::AVX512}) {
+        if (isaSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/** The lookup loop of BaseTags::findBlock(). */
+std::size_t
+referenceFind(const std::vector<uint64_t> &keys,
+              const std::vector<uint32_t> &indices, uint64_t key)
+{
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        if (keys[indices[i]] == key) {
+            return i;
+        }
+    }
+    return indices.size();
+}
+
+} // anonymous namespace
+
+/** Every kernel finds the first matching way of a contiguous set. */
+TEST(TagSearchTest, ContiguousMatchesScalarLoop)
+{
+    std::mt19937_64 rng(0);
+    for (Isa isa : supportedIsas()) {
+        for (std::size_t n = 1; n <= 133; n++) {
+            // A small range of keys creates duplicates and misses
+            std::vector<uint64_t> keys(n);
+            std::vector<uint32_t> indices(n);
+            for (std::size_t i = 0; i < n; i++) {
+                keys[i] = rng() % (2 * n);
+                indices[i] = i;
+            }
+            for (uint64_t key = 0; key < 2 * n; key++) {
+                ASSERT_EQ(tag_search::find(keys.data(), n, key, isa),
+                          referenceFind(keys, indices, key))
+                    << "isa " << int(isa) << " n " << n << " key " << key;
+            }
+        }
+    }
+}
+
+/** Every kernel finds the first matching way of a skewed set. */
+TEST(TagSearchTest, GatherMatchesScalarLoop)
+{
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> keys(1024);
+    for (auto &key : keys) {
+        key = rng() % 256;
+    }
+    for (Isa isa : supportedIsas()) {
+        for (std::size_t n = 1; n <= 133; n++) {
+            std::vector<uint32_t> indices(n);
+            for (auto &index : indices) {
+                index = rng() % keys.size();
+            }
+            for (uint64_t key = 0; key < 256; key++) {
+                ASSERT_EQ(tag_search::find(keys.data(), indices.data(), n,
+                                           key, isa),
+                          referenceFind(keys, indices, key))
+                    << "isa " << int(isa) << " n " << n << " key " << key;
+            }
+        }
+    }
+}
+
+/**
+ * Lanes past the last way must not match, even if they would hold the key
+ * looked for.
+ */
+TEST(TagSearchTest, IgnoresLanesPastTheEnd)
+{
+    std::vector<uint64_t> keys(16, 0);
+    std::vector<uint32_t> indices(16, 0);
+    for (std::size_t i = 0; i < 16; i++) {
+        keys[i] = i < 5 ? 100 + i : 0;
+        indices[i] = i;
+    }
+    for (Isa isa : supportedIsas()) {
+        ASSERT_EQ(tag_search::find(keys.data(), 5, 0, isa), 5);
+        ASSERT_EQ(tag_search::find(keys.data(), indices.data(), 5, 0, isa),
+                  5);
+        ASSERT_EQ(tag_search::find(keys.data(), 5, 104, isa), 4);
+    }
+}
+
+/** The default kernels agree with the scalar ones. */
+TEST(TagSearchTest, DefaultKernels)
+{
+    std::vector<uint64_t> keys(64);
+    std::vector<uint32_t> indices(64);
+    for (std::size_t i = 0; i < 64; i++) {
+        keys[i] = i * 3;
+        indices[i] = 63 - i;
+    }
+    for (std::size_t n : {1, 4, 8, 16, 32, 64}) {
+        for (uint64_t key : {0, 3, 21, 189, 190}) {
+            ASSERT_EQ(tag_search::find(keys.data(), n, key),
+                      tag_search::find(keys.data(), n, key, Isa::Scalar));
+            ASSERT_EQ(tag_search::find(keys.data(), indices.data(), n, key),
+                      tag_search::find(keys.data(), indices.data(), n, key,
+                                       Isa::Scalar));
+        }
+    }
+}
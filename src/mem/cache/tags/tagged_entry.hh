@@ -30,6 +30,7 @@
 #define __CACHE_TAGGED_ENTRY_HH__
 
 #include <cassert>
+#include <cstdint>
 
 #include "base/cprintf.hh"
 #include "base/types.hh"
@@ -46,7 +47,9 @@ namespace gem5
 class TaggedEntry : public ReplaceableEntry
 {
   public:
-    TaggedEntry() : _valid(false), _secure(false), _tag(MaxAddr) {}
+    TaggedEntry()
+      : _valid(false), _secure(false), _tag(MaxAddr), _packedKey(nullptr)
+    {}
     ~TaggedEntry() = default;
 
     /**
@@ -70,6 +73,39 @@ class TaggedEntry : public ReplaceableEntry
      */
     virtual Addr getTag() const { return _tag; }
 
+    /** Packed key of invalid entries, which no lookup key can match. */
+    static constexpr uint64_t InvalidKey = ~uint64_t(0);
+
+    /**
+     * Pack tag information into a single key, as kept in the packed key
+     * arrays of tag stores. Tags never use the top bit of an address, so
+     * no valid key can be equal to InvalidKey.
+     *
+     * @param tag The tag value.
+     * @param is_secure Whether secure bit is set.
+     * @return The packed key.
+     */
+    static uint64_t
+    packKey(Addr tag, bool is_secure)
+    {
+        return (uint64_t(tag) << 1) | uint64_t(is_secure);
+    }
+
+    /**
+     * Keep a packed copy of the tag information of this entry, updated on
+     * every change, so that tag stores can search their entries without
+     * dereferencing them. The key is tied to the position of the entry in
+     * the tag store, and must outlive it.
+     *
+     * @param key Where to keep the packed key of this entry.
+     */
+    void
+    setPackedKey(uint64_t *key)
+    {
+        _packedKey = key;
+        updatePackedKey();
+    }
+
     /**
      * Checks if the given tag information corresponds to this entry's.
      *
@@ -105,6 +141,7 @@ class TaggedEntry : public ReplaceableEntry
         _valid = false;
         setTag(MaxAddr);
         clearSecure();
+        updatePackedKey();
     }
 
     std::string
@@ -120,10 +157,20 @@ class TaggedEntry : public ReplaceableEntry
      *
      * @param tag The tag value.
      */
-    virtual void setTag(Addr tag) { _tag = tag; }
+    virtual void
+    setTag(Addr tag)
+    {
+        _tag = tag;
+        updatePackedKey();
+    }
 
     /** Set secure bit. */
-    virtual void setSecure() { _secure = true; }
+    virtual void
+    setSecure()
+    {
+        _secure = true;
+        updatePackedKey();
+    }
 
     /** Set valid bit. The block must be invalid beforehand. */
     virtual void
@@ -131,6 +178,7 @@ class TaggedEntry : public ReplaceableEntry
     {
         assert(!isValid());
         _valid = true;
+        updatePackedKey();
     }
 
   private:
@@ -150,6 +198,18 @@ class TaggedEntry : public ReplaceableEntry
     /** The entry's tag. */
     Addr _tag;
 
+    /** Packed copy of the tag information, if the tag store keeps one. */
+    uint64_t *_packedKey;
+
+    /** Update the packed copy of the tag information, if any. */
+    void
+    updatePackedKey()
+    {
+        if (_packedKey) {
+            *_packedKey = _valid ? packKey(_tag, _secure) : InvalidKey;
+        }
+    }
+
     /** Clear secure bit. Should be only used by the invalidation function. */
     void clearSecure() { _secure = false; }
 };
@@ -57,6 +57,7 @@ namespace gem5
 
 CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
     : BaseXBar(p), system(p.system), snoopFilter(p.snoop_filter),
+      warmingUp(false),
       snoopResponseLatency(p.snoop_response_latency),
       maxOutstandingSnoopCheck(p.max_outstanding_snoops),
       maxRoutingTableSizeCheck(p.max_routing_table_size),
@@ -143,6 +144,29 @@ CoherentXBar::init()
     // its own internal representation
     if (snoopFilter)
         snoopFilter->setCPUSidePorts(cpuSidePorts);
+
+    warmingUp = system->warmsUpCaches();
+}
+
+void
+CoherentXBar::startup()
+{
+    // The caches above may have restored their contents from a
+    // checkpoint, which the snoop filter does not hold
+    if (snoopFilter) {
+        snoopFilter->rebuild();
+    }
+}
+
+void
+CoherentXBar::drainResume()
+{
+    if (warmingUp && !system->warmsUpCaches() && snoopFilter) {
+        DPRINTF(CoherentXBar, "%s: rebuilding the snoop filter after "
+                "the cache warm-up\n", __func__);
+        snoopFilter->rebuild();
+    }
+    warmingUp = system->warmsUpCaches();
 }
 
 bool
@@ -757,7 +781,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
     if (snoop_caches) {
         // forward to all snoopers but the source
         std::pair<MemCmd, Tick> snoop_result;
-        if (snoopFilter) {
+        if (atomicSnoopFilter()) {
             // check with the snoop filter where to forward this packet
             auto sf_res =
                 snoopFilter->lookupRequest(pkt,
@@ -833,7 +857,8 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
 
 
     // if lower levels have replied, tell the snoop filter
-    if (!system->bypassCaches() && snoopFilter && pkt->isResponse()) {
+    if (!system->bypassCaches() && atomicSnoopFilter() &&
+        pkt->isResponse()) {
         snoopFilter->updateResponse(pkt, *cpuSidePorts[cpu_side_port_id]);
     }
 
@@ -899,7 +924,7 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
     // forward to all snoopers
     std::pair<MemCmd, Tick> snoop_result;
     Tick snoop_response_latency = 0;
-    if (snoopFilter) {
+    if (atomicSnoopFilter()) {
         auto sf_res = snoopFilter->lookupSnoop(pkt);
         snoop_response_latency += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
@@ -970,7 +995,7 @@ CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
         snoop_response_cmd = pkt->cmd;
         snoop_response_latency = latency;
 
-        if (snoopFilter) {
+        if (atomicSnoopFilter()) {
             // Handle responses by the snoopers and differentiate between
             // responses to requests from above and snoops from below
             if (source_mem_side_port_id != InvalidPortID) {
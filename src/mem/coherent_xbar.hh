@@ -85,7 +85,8 @@ class CoherentXBar : public BaseXBar
      * be instantiated for each of the mem_side_ports connecting to the
      * crossbar.
      */
-    class CoherentXBarResponsePort : public QueuedResponsePort
+    class CoherentXBarResponsePort : public QueuedResponsePort,
+                                     public TagWarmupResponder
     {
 
       private:
@@ -142,6 +143,20 @@ class CoherentXBar : public BaseXBar
             return xbar.getAddrRanges();
         }
 
+      public:
+
+        void
+        recvWarmupAccess(const PacketPtr pkt) override
+        {
+            xbar.recvWarmupAccess(pkt);
+        }
+
+        void
+        recvWarmupWriteback(const PacketPtr pkt) override
+        {
+            xbar.recvWarmupWriteback(pkt);
+        }
+
     };
 
     /**
@@ -149,7 +164,8 @@ class CoherentXBar : public BaseXBar
      * instantiated for each of the CPU-side-port interfaces connecting to the
      * crossbar.
      */
-    class CoherentXBarRequestPort : public RequestPort
+    class CoherentXBarRequestPort : public RequestPort,
+                                    public HeldLinesReporter
     {
       private:
         /** A reference to the crossbar to which this port belongs. */
@@ -162,6 +178,12 @@ class CoherentXBar : public BaseXBar
             : RequestPort(_name, &_xbar, _id), xbar(_xbar)
         { }
 
+        void
+        forEachHeldLine(const HeldLineVisitor &visitor) override
+        {
+            xbar.forEachHeldLine(visitor);
+        }
+
       protected:
 
         /**
@@ -277,6 +299,20 @@ class CoherentXBar : public BaseXBar
       * broadcast needed for probes.  NULL denotes an absent filter. */
     SnoopFilter *snoopFilter;
 
+    /**
+     * Whether the caches were warming up when the crossbar was last
+     * resumed (see System::warmsUpCaches()).
+     */
+    bool warmingUp;
+
+    /**
+     * Whether the snoop filter tracks the atomic accesses. The tags of
+     * the caches change without any packet while they are warming up,
+     * so the snoop filter is bypassed, and rebuilt from the tags above
+     * when the warm-up ends.
+     */
+    bool atomicSnoopFilter() const { return snoopFilter && !warmingUp; }
+
     /** Cycles of snoop response latency.*/
     const Cycles snoopResponseLatency;
 
@@ -426,6 +462,10 @@ class CoherentXBar : public BaseXBar
 
     virtual void init();
 
+    void startup() override;
+
+    void drainResume() override;
+
     CoherentXBar(const CoherentXBarParams &p);
 
     virtual ~CoherentXBar();
@@ -82,7 +82,8 @@ class NoncoherentXBar : public BaseXBar
      * will be instantiated for each of the memory-side ports connecting to
      * the crossbar.
      */
-    class NoncoherentXBarResponsePort : public QueuedResponsePort
+    class NoncoherentXBarResponsePort : public QueuedResponsePort,
+                                        public TagWarmupResponder
     {
       private:
 
@@ -131,6 +132,20 @@ class NoncoherentXBar : public BaseXBar
         {
             return xbar.getAddrRanges();
         }
+
+      public:
+
+        void
+        recvWarmupAccess(const PacketPtr pkt) override
+        {
+            xbar.recvWarmupAccess(pkt);
+        }
+
+        void
+        recvWarmupWriteback(const PacketPtr pkt) override
+        {
+            xbar.recvWarmupWriteback(pkt);
+        }
     };
 
     /**
@@ -151,6 +151,23 @@ PacketQueue::schedSendTiming(PacketPtr pkt, Tick when)
     schedSendEvent(when);
 }
 
+void
+PacketQueue::deferRefusedPacket(PacketPtr pkt)
+{
+    DPRINTF(PacketQueue, "%s for %s address %x size %d\n", __func__,
+            pkt->cmdString(), pkt->getAddr(), pkt->getSize());
+
+    assert(!waitingOnRetry);
+    transmitList.emplace_front(curTick(), pkt);
+
+    // the peer will send a retry, so hold off until then, as if the
+    // packet had been refused when sent from the queue
+    waitingOnRetry = true;
+    if (sendEvent.scheduled()) {
+        em.deschedule(sendEvent);
+    }
+}
+
 void
 PacketQueue::schedSendEvent(Tick when)
 {
@@ -205,6 +205,16 @@ class PacketQueue : public Drainable
      */
     void schedSendTiming(PacketPtr pkt, Tick when);
 
+    /**
+     * Take over a packet that the owner of the queue tried to send
+     * directly, bypassing the queue, and that was refused. The packet is
+     * put at the front of the transmit list, and the queue waits for the
+     * retry owed by the peer.
+     *
+     * @param pkt Packet that could not be sent
+     */
+    void deferRefusedPacket(PacketPtr pkt);
+
     /**
      * Retry sending a packet from the queue. Note that this is not
      * necessarily the same packet if something has been added with an
@@ -0,0 +1,81 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+from m5.objects.IndexingPolicies import *
+from m5.objects.ReplacementPolicies import *
+
+
+class ShadowTags(SimObject):
+    type = "ShadowTags"
+    cxx_header = "mem/probes/shadow_tags.hh"
+    cxx_class = "gem5::ShadowTags"
+
+    # By default the array has the geometry of the cache it shadows, so
+    # that only the replacement policy differs
+    size = Param.MemorySize(Parent.size, "Capacity in bytes")
+    assoc = Param.Int(Parent.assoc, "Associativity")
+    entry_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+
+    indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(), "Indexing policy"
+    )
+    replacement_policy = Param.BaseReplacementPolicy(
+        "Replacement policy to evaluate"
+    )
+
+
+class ShadowTagsProbe(SimObject):
+    """Replay the accesses seen by a cache on tag-only arrays that use
+    other replacement policies or sizes, to compare their miss ratios in a
+    single run. The shadow arrays never affect the cache: they only see the
+    requests that the cache looks up, and not its snoops or invalidations,
+    so they approximate what the cache would do on its own."""
+
+    type = "ShadowTagsProbe"
+    cxx_header = "mem/probes/shadow_tags.hh"
+    cxx_class = "gem5::ShadowTagsProbe"
+
+    cache = Param.BaseCache(Parent.any, "Cache whose accesses are replayed")
+    arrays = VectorParam.ShadowTags("Shadow arrays to update")
+
+    # The misses per thousand instructions of the arrays are relative to
+    # the instructions of these CPUs, such as the one of a private cache.
+    # A cache shared by every CPU can leave it empty.
+    cpus = VectorParam.BaseCPU(
+        [], "CPUs that access the cache (empty for all of them)"
+    )
+
+    # The arrays are updated by a helper thread, which the simulation
+    # thread feeds through a lock-free queue. Arrays whose policy draws
+    # from the global random number generator are always updated on the
+    # simulation thread, to keep runs reproducible.
+    threaded = Param.Bool(True, "Update the arrays on a helper thread")
+    queue_size = Param.Unsigned(
+        65536, "Number of accesses that can wait for the helper thread"
+    )
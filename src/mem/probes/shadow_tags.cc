@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/shadow_tags.hh"
+
+#include "base/logging.hh"
+#include "cpu/base.hh"
+#include "mem/cache/base.hh"
+#include "mem/cache/replacement_policies/base.hh"
+
+namespace gem5
+{
+
+ShadowTags::ShadowTags(const Params &p)
+    : SimObject(p), probe(nullptr), stats(*this)
+{
+    fatal_if(!p.replacement_policy, "%s needs a replacement policy.",
+             name());
+}
+
+void
+ShadowTags::init()
+{
+    SimObject::init();
+
+    array = std::make_unique<TagOnlyArray>(params().indexing_policy,
+        params().replacement_policy, params().size / params().entry_size);
+}
+
+void
+ShadowTags::setProbe(ShadowTagsProbe *_probe)
+{
+    fatal_if(probe, "%s is fed by both %s and %s.", name(), probe->name(),
+             _probe->name());
+    probe = _probe;
+}
+
+void
+ShadowTags::preDumpStats()
+{
+    if (probe) {
+        probe->flush();
+    }
+    SimObject::preDumpStats();
+}
+
+void
+ShadowTags::resetStats()
+{
+    if (probe) {
+        probe->flush();
+    }
+    SimObject::resetStats();
+}
+
+bool
+ShadowTags::usesGlobalRandom() const
+{
+    return params().replacement_policy->usesGlobalRandom();
+}
+
+void
+ShadowTags::access(const Access &access)
+{
+    replacement_policy::AccessContext ctx;
+    ctx.addr = access.addr;
+    ctx.secure = access.secure;
+    ctx.requestor = access.requestor;
+    ctx.pc = access.pc;
+
+    const TagOnlyArray::Outcome outcome = array->access(ctx);
+
+    if (access.demand) {
+        stats.accesses++;
+        if (outcome != TagOnlyArray::Outcome::Hit) {
+            stats.misses++;
+        }
+    }
+    if (outcome == TagOnlyArray::Outcome::Replacement) {
+        stats.replacements++;
+    }
+}
+
+ShadowTags::ShadowTagsStats::ShadowTagsStats(ShadowTags &_tags)
+  : statistics::Group(&_tags),
+    tags(_tags),
+    instsAtReset(0),
+    ADD_STAT(accesses, statistics::units::Count::get(),
+             "Number of demand accesses"),
+    ADD_STAT(misses, statistics::units::Count::get(),
+             "Number of demand misses"),
+    ADD_STAT(replacements, statistics::units::Count::get(),
+             "Number of valid blocks replaced"),
+    ADD_STAT(missRate, statistics::units::Ratio::get(),
+             "Demand miss ratio", misses / accesses),
+    ADD_STAT(missesPerKiloInst, statistics::units::Rate<
+                 statistics::units::Count, statistics::units::Count>::get(),
+             "Demand misses per thousand instructions of the CPUs that "
+             "access the cache")
+{
+    missesPerKiloInst.method(this, &ShadowTagsStats::mpki);
+}
+
+Counter
+ShadowTags::ShadowTagsStats::numInsts() const
+{
+    return tags.probe ? tags.probe->numInsts() :
+        BaseCPU::numSimulatedInsts();
+}
+
+void
+ShadowTags::ShadowTagsStats::resetStats()
+{
+    statistics::Group::resetStats();
+    instsAtReset = numInsts();
+}
+
+double
+ShadowTags::ShadowTagsStats::mpki() const
+{
+    const Counter insts = numInsts() - instsAtReset;
+    return insts > 0 ? misses.value() * 1000 / insts : 0;
+}
+
+ShadowTagsProbe::ShadowTagsProbe(const Params &p)
+    : SimObject(p), cpus(p.cpus), queue(p.queue_size), pushed(0),
+      replayed(0), stopping(false)
+{
+    for (auto array : p.arrays) {
+        array->setProbe(this);
+        if (!p.threaded || array->usesGlobalRandom()) {
+            syncArrays.push_back(array);
+        } else {
+            asyncArrays.push_back(array);
+        }
+    }
+}
+
+ShadowTagsProbe::~ShadowTagsProbe()
+{
+    stopWorker();
+}
+
+void
+ShadowTagsProbe::regProbeListeners()
+{
+    ProbeManager *const mgr = params().cache->getProbeManager();
+    listeners.emplace_back(new AccessListener(*this, mgr, "Hit"));
+    listeners.emplace_back(new AccessListener(*this, mgr, "Miss"));
+}
+
+void
+ShadowTagsProbe::startup()
+{
+    SimObject::startup();
+
+    if (!asyncArrays.empty()) {
+        worker = std::thread(&ShadowTagsProbe::work, this);
+        registerExitCallback([this]() { stopWorker(); });
+    }
+}
+
+void
+ShadowTagsProbe::handle(const PacketPtr &pkt)
+{
+    // The requests that do not allocate in the cache are not replayed
+    if (pkt->req->isUncacheable() || pkt->isCleanEviction() ||
+        pkt->req->isCacheMaintenance()) {
+        return;
+    }
+
+    ShadowTags::Access access;
+    access.tick = curTick();
+    access.addr = pkt->getAddr();
+    access.pc = pkt->req->hasPC() ? pkt->req->getPC() : MaxAddr;
+    access.requestor = pkt->requestorId();
+    access.secure = pkt->isSecure();
+    access.demand = pkt->isDemand();
+
+    for (auto array : syncArrays) {
+        array->access(access);
+    }
+
+    if (!asyncArrays.empty()) {
+        while (!queue.tryPush(access)) {
+            std::this_thread::yield();
+        }
+        pushed++;
+    }
+}
+
+void
+ShadowTagsProbe::work()
+{
+    ReplayClock clock(name() + ".eventq");
+
+    // Spin for a while before backing off, as a new access is most likely
+    // to arrive soon while the simulation is running
+    constexpr unsigned spin_limit = 1024;
+    unsigned idle = 0;
+    ShadowTags::Access access;
+    while (true) {
+        if (queue.tryPop(access)) {
+            clock.set(access.tick);
+            for (auto array : asyncArrays) {
+                array->access(access);
+            }
+            replayed.fetch_add(1, std::memory_order_release);
+            idle = 0;
+        } else if (stopping.load(std::memory_order_acquire)) {
+            break;
+        } else if (++idle < spin_limit) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+void
+ShadowTagsProbe::flush()
+{
+    while (replayed.load(std::memory_order_acquire) != pushed) {
+        std::this_thread::yield();
+    }
+}
+
+void
+ShadowTagsProbe::stopWorker()
+{
+    if (worker.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        worker.join();
+    }
+}
+
+DrainState
+ShadowTagsProbe::drain()
+{
+    flush();
+    return DrainState::Drained;
+}
+
+Counter
+ShadowTagsProbe::numInsts() const
+{
+    if (cpus.empty()) {
+        return BaseCPU::numSimulatedInsts();
+    }
+
+    Counter insts = 0;
+    for (auto cpu : cpus) {
+        insts += cpu->totalInsts();
+    }
+    return insts;
+}
+
+} // namespace gem5
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Tag-only copies of a cache that replay its accesses with other
+ * replacement policies or sizes, so that several configurations can be
+ * compared in a single simulation.
+ */
+
+#ifndef __MEM_PROBES_SHADOW_TAGS_HH__
+#define __MEM_PROBES_SHADOW_TAGS_HH__
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/spsc_queue.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/tags/tag_only_array.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/ShadowTags.hh"
+#include "params/ShadowTagsProbe.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+class ShadowTagsProbe;
+
+/**
+ * A tag-only copy of a cache (see TagOnlyArray), fed by a ShadowTagsProbe.
+ */
+class ShadowTags : public SimObject
+{
+  public:
+    /** An access of the shadowed cache, as replayed on the arrays. */
+    struct Access
+    {
+        /** Tick of the access. */
+        Tick tick = 0;
+
+        /** Address accessed. */
+        Addr addr = 0;
+
+        /** PC of the instruction that generated the access, or MaxAddr. */
+        Addr pc = MaxAddr;
+
+        /** Requestor that generated the access. */
+        RequestorID requestor = Request::invldRequestorId;
+
+        /** Whether the access is to the secure address space. */
+        bool secure = false;
+
+        /**
+         * Whether the access is counted in the statistics. Accesses that
+         * are not demand accesses, such as writebacks and prefetches from
+         * the upper levels, allocate but are not counted.
+         */
+        bool demand = false;
+    };
+
+    PARAMS(ShadowTags);
+    ShadowTags(const Params &p);
+
+    void init() override;
+
+    /**
+     * The statistics are only read or reset once the probe has replayed
+     * every access it has queued, as they are updated by its helper
+     * thread.
+     */
+    void preDumpStats() override;
+    void resetStats() override;
+
+    /**
+     * Attach the array to the probe that feeds it.
+     *
+     * @param _probe The probe.
+     */
+    void setProbe(ShadowTagsProbe *_probe);
+
+    /**
+     * Look the access up, and allocate a block for it on a miss.
+     *
+     * @param access The access to replay.
+     */
+    void access(const Access &access);
+
+    /**
+     * Whether the array must be updated on the simulation thread, because
+     * its replacement policy draws from the global random number generator.
+     */
+    bool usesGlobalRandom() const;
+
+  private:
+    /** The probe that feeds the array, if any. */
+    ShadowTagsProbe *probe;
+
+    /** The tags, set up in init(). */
+    std::unique_ptr<TagOnlyArray> array;
+
+    struct ShadowTagsStats : public statistics::Group
+    {
+        ShadowTagsStats(ShadowTags &tags);
+
+        void resetStats() override;
+
+        /**
+         * Number of instructions executed by the CPUs whose accesses the
+         * array sees (see ShadowTagsProbe::numInsts()).
+         */
+        Counter numInsts() const;
+
+        ShadowTags &tags;
+
+        /** Demand misses per thousand instructions since the last reset. */
+        double mpki() const;
+
+        /** Number of simulated instructions when the stats were reset. */
+        Counter instsAtReset;
+
+        /** Number of demand accesses replayed. */
+        statistics::Scalar accesses;
+
+        /** Number of demand accesses that missed. */
+        statistics::Scalar misses;
+
+        /** Number of valid blocks that were replaced. */
+        statistics::Scalar replacements;
+
+        /** Demand miss ratio. */
+        statistics::Formula missRate;
+
+        /** Demand misses per thousand instructions. */
+        statistics::Value missesPerKiloInst;
+    } stats;
+};
+
+/**
+ * Replay the accesses of a cache on a set of shadow arrays.
+ *
+ * The probe listens to the hits and misses of the cache. Each access is
+ * reduced to a small record, which is either replayed right away or
+ * pushed to a lock-free queue drained by a helper thread, so that the
+ * cost of the shadow arrays is mostly taken off the simulation thread.
+ * The simulation thread waits for the helper thread to catch up before
+ * the statistics are dumped or reset and before the system is drained,
+ * so the results do not depend on the host scheduling.
+ */
+class ShadowTagsProbe : public SimObject
+{
+  public:
+    PARAMS(ShadowTagsProbe);
+    ShadowTagsProbe(const Params &p);
+    ~ShadowTagsProbe();
+
+    void regProbeListeners() override;
+    void startup() override;
+    DrainState drain() override;
+
+    /** Wait until the helper thread has replayed every queued access. */
+    void flush();
+
+    /**
+     * Number of instructions executed by the CPUs that access the cache:
+     * the given CPUs, or every CPU if none is given.
+     */
+    Counter numInsts() const;
+
+  private:
+    /** Listener of the hit and miss probe points of the cache. */
+    class AccessListener : public ProbeListenerArgBase<PacketPtr>
+    {
+      public:
+        AccessListener(ShadowTagsProbe &_parent, ProbeManager *pm,
+                       const std::string &name)
+            : ProbeListenerArgBase(pm, name), parent(_parent)
+        {}
+
+        void notify(const PacketPtr &pkt) override { parent.handle(pkt); }
+
+      private:
+        ShadowTagsProbe &parent;
+    };
+
+    /** Turn a packet looked up by the cache into an access, and replay it. */
+    void handle(const PacketPtr &pkt);
+
+    /** Body of the helper thread. */
+    void work();
+
+    /** Stop the helper thread, after it has replayed the queued accesses. */
+    void stopWorker();
+
+    std::vector<std::unique_ptr<AccessListener>> listeners;
+
+    /** The CPUs that access the cache, or none for every CPU. */
+    const std::vector<BaseCPU*> cpus;
+
+    /** Arrays updated on the simulation thread. */
+    std::vector<ShadowTags*> syncArrays;
+
+    /** Arrays updated on the helper thread. */
+    std::vector<ShadowTags*> asyncArrays;
+
+    /** Accesses waiting for the helper thread. */
+    SPSCQueue<ShadowTags::Access> queue;
+
+    /** Number of accesses pushed to the queue. */
+    uint64_t pushed;
+
+    /** Number of accesses the helper thread has replayed. */
+    std::atomic<uint64_t> replayed;
+
+    /** Set to ask the helper thread to return once the queue is empty. */
+    std::atomic<bool> stopping;
+
+    std::thread worker;
+};
+
+} // namespace gem5
+
+#endif // __MEM_PROBES_SHADOW_TAGS_HH__
@@ -48,6 +48,7 @@
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -216,6 +217,14 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
+    // A consumer on another event queue runs on another thread
+    assert(m_consumer != NULL);
+    if (inParallelMode &&
+        m_consumer->getObject()->eventQueue() != curEventQueue()) {
+        enqueueRemote(message, current_time, delta);
+        return;
+    }
+
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -250,14 +259,46 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
         }
     }
 
+    enqueueAt(message, current_time, arrival_time);
+}
+
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta)
+{
+    // The producer must not look at anything the consumer updates, so
+    // the buffer has to be unbounded and the arrival time fixed
+    fatal_if(m_max_size != 0,
+             "%s: a buffer between partitions must be unbounded", name());
+    fatal_if(m_randomization == MessageRandomization::enabled ||
+             (m_randomization == MessageRandomization::ruby_system &&
+              RubySystem::getRandomization()),
+             "%s: randomization is not supported between partitions",
+             name());
+    fatal_if(delta < simQuantum,
+             "%s: latency between partitions (%d) is below the lookahead "
+             "(simulation quantum %d)", name(), delta, simQuantum);
+
+    const Tick arrival_time = current_time + delta;
+    auto *event = new OneShotEvent(
+        [this, message, current_time, arrival_time]() {
+            m_msg_counter++;
+            enqueueAt(message, current_time, arrival_time);
+        }, "MessageBuffer.remoteDelivery", Event::Remote_Delivery_Pri);
+    m_consumer->getObject()->eventQueue()->schedule(event, arrival_time);
+}
+
+void
+MessageBuffer::enqueueAt(MsgPtr message, Tick current_time,
+                         Tick arrival_time)
+{
     // Check the arrival time
     assert(arrival_time >= current_time);
     if (m_strict_fifo) {
         if (arrival_time < m_last_arrival_time) {
             panic("FIFO ordering violated: %s name: %s current time: %d "
                   "delta: %d arrival_time: %d last arrival_time: %d\n",
-                  *this, name(), current_time, delta, arrival_time,
-                  m_last_arrival_time);
+                  *this, name(), current_time, arrival_time - current_time,
+                  arrival_time, m_last_arrival_time);
         }
     }
 
@@ -290,7 +331,6 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
@@ -195,6 +195,20 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    /**
+     * Hand a message to a consumer running on another event queue, in
+     * parallel mode. The message is inserted by an event on the
+     * consumer's queue, so the latency must be at least the simulation
+     * quantum.
+     */
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta);
+
+    /**
+     * Insert a message that becomes ready at the given tick and wake
+     * up the consumer.
+     */
+    void enqueueAt(MsgPtr message, Tick current_time, Tick arrival_time);
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
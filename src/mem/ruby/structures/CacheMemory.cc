@@ -105,7 +105,7 @@ CacheMemory::init()
     for (int i = 0; i < m_cache_num_sets; i++) {
         for ( int j = 0; j < m_cache_assoc; j++) {
             replacement_data[i][j] =
-                                m_replacementPolicy_ptr->instantiateEntry();
+                m_replacementPolicy_ptr->instantiateEntry(i, j);
         }
     }
 }
@@ -130,6 +130,13 @@ CacheMemory::addressToCacheSet(Addr address) const
                      m_start_index_bit + m_cache_num_set_bits - 1);
 }
 
+replacement_policy::AccessContext
+CacheMemory::accessContext(Addr address) const
+{
+    return replacement_policy::AccessContext(address, address,
+                                             addressToCacheSet(address));
+}
+
 // Given a cache index: returns the index of the tag in a set.
 // returns -1 if the tag is not found.
 int
@@ -190,7 +197,8 @@ CacheMemory::tryCacheAccess(Addr address, RubyRequestType type,
     AbstractCacheEntry* entry = lookup(address);
     if (entry != nullptr) {
         // Do we even have a tag match?
-        m_replacementPolicy_ptr->touch(entry->replacementData);
+        m_replacementPolicy_ptr->touch(entry->replacementData,
+                                       accessContext(address));
         entry->setLastAccess(curTick());
         data_ptr = &(entry->getDataBlk());
 
@@ -215,7 +223,8 @@ CacheMemory::testCacheAccess(Addr address, RubyRequestType type,
     AbstractCacheEntry* entry = lookup(address);
     if (entry != nullptr) {
         // Do we even have a tag match?
-        m_replacementPolicy_ptr->touch(entry->replacementData);
+        m_replacementPolicy_ptr->touch(entry->replacementData,
+                                       accessContext(address));
         entry->setLastAccess(curTick());
         data_ptr = &(entry->getDataBlk());
 
@@ -298,7 +307,8 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
             // Call reset function here to set initial value for different
             // replacement policies.
-            m_replacementPolicy_ptr->reset(entry->replacementData);
+            m_replacementPolicy_ptr->reset(entry->replacementData,
+                                           accessContext(address));
 
             return entry;
         }
@@ -312,7 +322,8 @@ CacheMemory::deallocate(Addr address)
     DPRINTF(RubyCache, "address: %#x\n", address);
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
-    m_replacementPolicy_ptr->invalidate(entry->replacementData);
+    m_replacementPolicy_ptr->invalidate(entry->replacementData,
+                                        accessContext(address));
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
@@ -334,7 +345,7 @@ CacheMemory::cacheProbe(Addr address) const
                                                        m_cache[cacheSet][i]));
     }
     return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+        getVictim(candidates, accessContext(address))->getWay()]->m_Address;
 }
 
 // looks an address up in the cache
@@ -365,7 +376,8 @@ CacheMemory::setMRU(Addr address)
 {
     AbstractCacheEntry* entry = lookup(makeLineAddress(address));
     if (entry != nullptr) {
-        m_replacementPolicy_ptr->touch(entry->replacementData);
+        m_replacementPolicy_ptr->touch(entry->replacementData,
+                                       accessContext(entry->m_Address));
         entry->setLastAccess(curTick());
     }
 }
@@ -374,7 +386,8 @@ void
 CacheMemory::setMRU(AbstractCacheEntry *entry)
 {
     assert(entry != nullptr);
-    m_replacementPolicy_ptr->touch(entry->replacementData);
+    m_replacementPolicy_ptr->touch(entry->replacementData,
+                                   accessContext(entry->m_Address));
     entry->setLastAccess(curTick());
 }
 
@@ -391,7 +404,8 @@ CacheMemory::setMRU(Addr address, int occupancy)
                 m_replacementPolicy_ptr)->touch(
                 entry->replacementData, occupancy);
         } else {
-            m_replacementPolicy_ptr->touch(entry->replacementData);
+            m_replacementPolicy_ptr->touch(entry->replacementData,
+                                           accessContext(entry->m_Address));
         }
         entry->setLastAccess(curTick());
     }
@@ -110,7 +110,10 @@ class CacheMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
-    // Returns with the physical address of the conflicting cache line
+    // Returns with the physical address of the conflicting cache line.
+    // Protocols probe again every time a blocked request is retried, so
+    // the replacement policy must return the same line each time and
+    // must not be affected by the repeated probes.
     Addr cacheProbe(Addr address) const;
 
     // looks an address up in the cache
@@ -168,6 +171,10 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Describe an access to a line to the replacement policy. Ruby
+    // identifies lines by address, so the line address is used as tag.
+    replacement_policy::AccessContext accessContext(Addr address) const;
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
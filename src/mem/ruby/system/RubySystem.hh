@@ -111,8 +111,7 @@ class RubySystem : public ClockedObject
     bool eventQueueEmpty() { return eventq->empty(); }
     void enqueueRubyEvent(Tick tick)
     {
-        auto e = new EventFunctionWrapper(
-            [this]{ processRubyEvent(); }, "RubyEvent");
+        auto e = new OneShotEvent([this]{ processRubyEvent(); }, "RubyEvent");
         schedule(e, tick);
     }
 
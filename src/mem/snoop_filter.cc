@@ -45,6 +45,7 @@
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
+#include "mem/tag_warmup.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -408,6 +409,36 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "(>1) holders of the requested data.")
 {}
 
+void
+SnoopFilter::rebuild()
+{
+    cachedLocations.clear();
+    reqLookupResult.it = cachedLocations.end();
+
+    for (const auto &port : cpuSidePorts) {
+        auto *above = dynamic_cast<HeldLinesReporter*>(&port->getPeer());
+        if (!above)
+            continue;
+
+        const SnoopMask port_mask = portToMask(*port);
+        above->forEachHeldLine(
+            [this, &port_mask](Addr addr, bool is_secure) {
+                Addr line_addr = addr & ~Addr(linesize - 1);
+                if (is_secure) {
+                    line_addr |= LineSecure;
+                }
+                cachedLocations[line_addr].holder |= port_mask;
+            });
+    }
+
+    panic_if(cachedLocations.size() > maxEntryCount,
+             "snoop filter exceeded capacity of %d cache blocks\n",
+             maxEntryCount);
+
+    DPRINTF(SnoopFilter, "%s: tracking %d lines\n", __func__,
+            cachedLocations.size());
+}
+
 void
 SnoopFilter::regStats()
 {
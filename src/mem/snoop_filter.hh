@@ -200,6 +200,15 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Rebuild the tracking information from the lines held above each
+     * snooping CPU-side port, for when the caches above changed without
+     * the snoop filter seeing it. The CPU-side ports that cannot report
+     * their lines (see HeldLinesReporter) are assumed to hold none.
+     * There must be no request in flight.
+     */
+    void rebuild();
+
     virtual void regStats();
 
   protected:
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_TAG_WARMUP_HH__
+#define __MEM_TAG_WARMUP_HH__
+
+#include <functional>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * @file
+ * Side interfaces of the ports of the classic memory system that let
+ * caches walk each other's tags without going through the regular
+ * packet protocols.
+ *
+ * While the caches are warming up (see System::warmsUpCaches()) the
+ * cache that receives an access from a CPU performs it in memory
+ * directly, and only hands the lines it misses on to the tags below
+ * through TagWarmupResponder. No packet is sent, no latency is
+ * computed and the lower levels do not count the accesses.
+ *
+ * Since the snoop filters see none of that, they are rebuilt from the
+ * tags above them through HeldLinesReporter when the warm-up ends.
+ */
+
+/**
+ * Implemented by the response ports whose owner keeps tags, or routes
+ * to ports that do. Ports that do not implement it, e.g., the ones of
+ * memories, end the walk.
+ */
+class TagWarmupResponder
+{
+  public:
+    virtual ~TagWarmupResponder() = default;
+
+    /**
+     * An upper-level cache missed on a line while warming up.
+     *
+     * @param pkt The original request, which gives the address and the
+     *        context of the access to the tags, replacement policies
+     *        and probes. It is not modified, forwarded or responded to.
+     */
+    virtual void recvWarmupAccess(const PacketPtr pkt) = 0;
+
+    /**
+     * An upper-level cache that writes back clean lines evicted a line
+     * while warming up. Lines are never dirty in that mode.
+     *
+     * @param pkt A WritebackClean describing the line. It holds no data
+     *        and is only used as context for the tags.
+     */
+    virtual void recvWarmupWriteback(const PacketPtr pkt) = 0;
+};
+
+/** Visitor of a cached line, given its address and security. */
+using HeldLineVisitor = std::function<void(Addr addr, bool is_secure)>;
+
+/**
+ * Implemented by the request ports that can report the lines cached
+ * above them, e.g., to rebuild a snoop filter from the tags.
+ */
+class HeldLinesReporter
+{
+  public:
+    virtual ~HeldLinesReporter() = default;
+
+    /**
+     * Visit every line held by the caches above the port. A line may be
+     * visited more than once if several levels hold it.
+     *
+     * @param visitor The visitor to call for every line.
+     */
+    virtual void forEachHeldLine(const HeldLineVisitor &visitor) = 0;
+};
+
+} // namespace gem5
+
+#endif //__MEM_TAG_WARMUP_HH__
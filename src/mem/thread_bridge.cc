@@ -27,6 +27,7 @@
 
 #include "mem/thread_bridge.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/eventq.hh"
 
@@ -34,10 +35,58 @@ namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay_(p.delay), in_queue_(getEventQueue(p.in_eventq_index))
 {
 }
 
+void
+ThreadBridge::startup()
+{
+    fatal_if(in_queue_ != eventQueue() && delay_ < simQuantum,
+             "%s: the delay (%d) must cover the simulation quantum (%d) "
+             "between event queues.", name(), delay_, simQuantum);
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    return in_flight_ == 0 ? DrainState::Drained : DrainState::Draining;
+}
+
+void
+ThreadBridge::sendRequests()
+{
+    while (!req_queue_.empty() && !waiting_req_retry_) {
+        if (out_port_.sendTimingReq(req_queue_.front())) {
+            req_queue_.pop_front();
+            packetDone();
+        } else {
+            waiting_req_retry_ = true;
+        }
+    }
+}
+
+void
+ThreadBridge::sendResponses()
+{
+    while (!resp_queue_.empty() && !waiting_resp_retry_) {
+        if (in_port_.sendTimingResp(resp_queue_.front())) {
+            resp_queue_.pop_front();
+            packetDone();
+        } else {
+            waiting_resp_retry_ = true;
+        }
+    }
+}
+
+void
+ThreadBridge::packetDone()
+{
+    if (--in_flight_ == 0 && drainState() == DrainState::Draining)
+        signalDrainDone();
+}
+
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
                                          ThreadBridge &device)
     : ResponsePort(name, &device), device_(device)
@@ -54,12 +103,18 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    ++device_.in_flight_;
+    device_.deliver(device_.eventQueue(), [this, pkt]() {
+        device_.req_queue_.push_back(pkt);
+        device_.sendRequests();
+    });
+    return true;
 }
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_resp_retry_ = false;
+    device_.sendResponses();
 }
 
 // AtomicResponseProtocol
@@ -67,7 +122,7 @@ Tick
 ThreadBridge::IncomingPort::recvAtomicBackdoor(PacketPtr pkt,
                                                MemBackdoorPtr &backdoor)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    panic("ThreadBridge does not support backdoor access.");
 }
 Tick
 ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
@@ -100,12 +155,18 @@ ThreadBridge::OutgoingPort::recvRangeChange()
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    ++device_.in_flight_;
+    device_.deliver(device_.in_queue_, [this, pkt]() {
+        device_.resp_queue_.push_back(pkt);
+        device_.sendResponses();
+    });
+    return true;
 }
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_req_retry_ = false;
+    device_.sendRequests();
 }
 
 Port &
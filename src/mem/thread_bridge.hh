@@ -28,8 +28,13 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <atomic>
+#include <deque>
+#include <utility>
+
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -43,6 +48,10 @@ class ThreadBridge : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    void startup() override;
+
+    DrainState drain() override;
+
   private:
     class IncomingPort : public ResponsePort
     {
@@ -82,6 +91,48 @@ class ThreadBridge : public SimObject
 
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    /** Delay of timing transactions crossing the bridge. */
+    const Tick delay_;
+
+    /** Queue of the in_port side; the out_port side runs on ours. */
+    EventQueue *const in_queue_;
+
+    /** Requests waiting for the out_port side to accept them. */
+    std::deque<PacketPtr> req_queue_;
+    bool waiting_req_retry_ = false;
+
+    /** Responses waiting for the in_port side to accept them. */
+    std::deque<PacketPtr> resp_queue_;
+    bool waiting_resp_retry_ = false;
+
+    /**
+     * Timing packets accepted by one side and not yet passed on by the
+     * other. Both threads update it.
+     */
+    std::atomic<unsigned> in_flight_{0};
+
+    /**
+     * Run a callback on the given queue after the bridge delay. The
+     * calling thread need not own the queue. In parallel mode the event
+     * is merged into the other queue at the next quantum boundary, in a
+     * deterministic order.
+     */
+    template <typename F>
+    void
+    deliver(EventQueue *eq, F &&callback)
+    {
+        eq->schedule(new OneShotEvent(std::forward<F>(callback),
+                                      "ThreadBridge.deliver",
+                                      Event::Remote_Delivery_Pri),
+                     curTick() + delay_);
+    }
+
+    void sendRequests();
+    void sendResponses();
+
+    /** Account for a packet that has left the bridge. */
+    void packetDone();
 };
 
 }  // namespace gem5
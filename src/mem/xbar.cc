@@ -359,6 +359,39 @@ BaseXBar::findPort(AddrRange addr_range)
           name());
 }
 
+void
+BaseXBar::recvWarmupAccess(const PacketPtr pkt)
+{
+    PortID dest_id = findPort(pkt->getAddrRange());
+    auto *dest = dynamic_cast<TagWarmupResponder*>(
+        &memSidePorts[dest_id]->getPeer());
+    if (dest) {
+        dest->recvWarmupAccess(pkt);
+    }
+}
+
+void
+BaseXBar::recvWarmupWriteback(const PacketPtr pkt)
+{
+    PortID dest_id = findPort(pkt->getAddrRange());
+    auto *dest = dynamic_cast<TagWarmupResponder*>(
+        &memSidePorts[dest_id]->getPeer());
+    if (dest) {
+        dest->recvWarmupWriteback(pkt);
+    }
+}
+
+void
+BaseXBar::forEachHeldLine(const HeldLineVisitor &visitor)
+{
+    for (const auto &p : cpuSidePorts) {
+        auto *above = dynamic_cast<HeldLinesReporter*>(&p->getPeer());
+        if (above) {
+            above->forEachHeldLine(visitor);
+        }
+    }
+}
+
 /** Function called by the port when the crossbar is receiving a range change.*/
 void
 BaseXBar::recvRangeChange(PortID mem_side_port_id)
@@ -52,6 +52,7 @@
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
+#include "mem/tag_warmup.hh"
 #include "params/BaseXBar.hh"
 #include "sim/clocked_object.hh"
 #include "sim/stats.hh"
@@ -348,6 +349,29 @@ class BaseXBar : public ClockedObject
      */
     PortID findPort(AddrRange addr_range);
 
+    /**
+     * Hand a tags-only warm-up access to the tags behind the memory-side
+     * port the line maps to, if any.
+     *
+     * @sa TagWarmupResponder
+     */
+    void recvWarmupAccess(const PacketPtr pkt);
+
+    /**
+     * Hand a tags-only warm-up writeback to the tags behind the
+     * memory-side port the line maps to, if any.
+     *
+     * @sa TagWarmupResponder
+     */
+    void recvWarmupWriteback(const PacketPtr pkt);
+
+    /**
+     * Visit the lines held by the caches above all the CPU-side ports.
+     *
+     * @sa HeldLinesReporter
+     */
+    void forEachHeldLine(const HeldLineVisitor &visitor);
+
     /**
      * Return the address ranges the crossbar is responsible for.
      *
@@ -86,6 +86,28 @@ def create(func, priority=Event.Default_Pri):
     return EventWrapper(func, priority=priority)
 
 
+def setEventQueueBackend(name):
+    """Select the data structure holding the events of the event queues,
+    "list" or "calendar". Already scheduled events are kept."""
+
+    backends = {
+        "list": _m5.event.EventQueueBackend.List,
+        "calendar": _m5.event.EventQueueBackend.Calendar,
+    }
+    if name not in backends:
+        raise ValueError("Unknown event queue backend '%s'" % name)
+    _m5.event.setEventQueueBackend(backends[name])
+
+
+def enableEventProfiler(basename):
+    """Profile the host time spent servicing each kind of event. The
+    report and collapsed stacks are written to basename.txt and
+    basename.folded in the output directory at every stats dump and at
+    exit."""
+
+    _m5.event.enableEventProfiler(basename)
+
+
 __all__ = [
     "Event",
     "EventWrapper",
@@ -93,4 +115,6 @@ __all__ = [
     "SimExit",
     "mainq",
     "create",
+    "setEventQueueBackend",
+    "enableEventProfiler",
 ]
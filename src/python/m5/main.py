@@ -71,6 +71,7 @@ def parse_options():
     group = options.set_group
 
     listener_modes = ("on", "off", "auto")
+    event_queue_backends = ("list", "calendar")
 
     # Help options
     option(
@@ -150,6 +151,23 @@ def parse_options():
         help="Port listeners will accept connections from anywhere (0.0.0.0). "
         "Default is only localhost.",
     )
+    option(
+        "--event-queue",
+        metavar="{list,calendar}",
+        choices=event_queue_backends,
+        default="list",
+        help="Data structure holding the scheduled events. The calendar "
+        "queue is faster with many pending events; both run events in the "
+        "same order [Default: %default]",
+    )
+    option(
+        "--event-profile",
+        metavar="NAME",
+        default=None,
+        help="Profile the host time spent in each kind of event and write "
+        "NAME.txt and NAME.folded (for flame graphs) to the output directory "
+        "at each stats dump and at exit",
+    )
     option(
         "-i",
         "--interactive",
@@ -497,6 +515,10 @@ def main():
     # tell C++ about output directory
     core.setOutputDir(options.outdir)
 
+    event.setEventQueueBackend(options.event_queue)
+    if options.event_profile:
+        event.enableEventProfiler(options.event_profile)
+
     # update the system path with elements from the -p option
     sys.path[0:0] = options.path
 
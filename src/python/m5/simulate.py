@@ -331,7 +331,7 @@ def _changeMemoryMode(system, mode):
         print("System already in target mode. Memory mode unchanged.")
 
 
-def switchCpus(system, cpuList, verbose=True):
+def switchCpus(system, cpuList, verbose=True, warmup_caches=False):
     """Switch CPUs in a system.
 
     Note: This method may switch the memory mode of the system if that
@@ -341,6 +341,10 @@ def switchCpus(system, cpuList, verbose=True):
     Arguments:
       system -- Simulated system.
       cpuList -- (old_cpu, new_cpu) tuples
+      warmup_caches -- Put the caches in warm-up mode. The new CPUs
+                       must use the atomic memory mode, and the caches
+                       will only update their tags, replacement state
+                       and prefetchers until the next switch.
     """
 
     if verbose:
@@ -383,6 +387,13 @@ def switchCpus(system, cpuList, verbose=True):
                 "Old CPU (%s) does not support CPU handover." % (old_cpu,)
             )
 
+    if warmup_caches:
+        if memory_mode_name != "atomic":
+            raise RuntimeError(
+                "Cache warm-up requires CPUs using the atomic memory mode."
+            )
+        memory_mode_name = "atomic_warmup"
+
     MemoryMode = params.allEnums["MemoryMode"]
     try:
         memory_mode = MemoryMode(memory_mode_name).getValue()
@@ -45,6 +45,7 @@
 
 #include "base/logging.hh"
 #include "sim/eventq.hh"
+#include "sim/eventq_profiler.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/simulate.hh"
@@ -117,6 +118,14 @@ pybind_init_event(py::module_ &m_native)
     m.def("getEventQueue", &getEventQueue,
           py::return_value_policy::reference);
 
+    py::enum_<EventQueue::Backend>(m, "EventQueueBackend")
+        .value("List", EventQueue::Backend::List)
+        .value("Calendar", EventQueue::Backend::Calendar)
+        ;
+    m.def("setEventQueueBackend", &EventQueue::setDefaultBackend);
+    m.def("enableEventProfiler", &EventProfiler::enable,
+          py::arg("basename"));
+
     py::class_<EventQueue>(m, "EventQueue")
         .def("name",  [](EventQueue *eq) { return eq->name(); })
         .def("dump", &EventQueue::dump)
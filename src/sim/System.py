@@ -47,7 +47,13 @@ from m5.objects.Workload import StubWorkload
 
 
 class MemoryMode(Enum):
-    vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
+    vals = [
+        "invalid",
+        "atomic",
+        "timing",
+        "atomic_noncaching",
+        "atomic_warmup",
+    ]
 
 
 class System(SimObject):
@@ -30,10 +30,12 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -58,13 +60,22 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+namespace
+{
+
+//! Number of events the running thread scheduled on other queues.
+__thread uint64_t asyncSeq = 0;
+
+} // anonymous namespace
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
-        numMainEventQueues++;
-        mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+        EventQueue *eventq =
+            new EventQueue(csprintf("MainEventQueue-%d", index));
+        eventq->queueIndex = numMainEventQueues++;
+        mainEventQueue.push_back(eventq);
     }
 
     return mainEventQueue[index];
@@ -111,6 +122,13 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    numEvents++;
+
+    if (backend == Backend::Calendar) {
+        head = calendar.insert(event, head);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -169,6 +187,12 @@ EventQueue::remove(Event *event)
         panic("event not found!");
 
     assert(event->queue == this);
+    numEvents--;
+
+    if (backend == Backend::Calendar) {
+        head = calendar.remove(event, head);
+        return;
+    }
 
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
@@ -201,8 +225,11 @@ EventQueue::serviceOne()
     Event *event = head;
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
+    const std::size_t depth = numEvents--;
 
-    if (next) {
+    if (backend == Backend::Calendar) {
+        head = calendar.remove(event, head);
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -220,7 +247,15 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (GEM5_UNLIKELY(EventProfiler::enabled())) {
+            EventProfile::Entry &entry =
+                getProfile().service(event->name(), depth);
+            const uint64_t start = EventProfiler::hostCycles();
+            event->process();
+            entry.hostCycles += EventProfiler::hostCycles() - start;
+        } else {
+            event->process();
+        }
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -295,15 +330,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
-            Event *nextInBin = nextBin;
+        for (Event *bin : sortedBins()) {
+            Event *nextInBin = bin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -318,9 +350,8 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
-        Event *nextInBin = nextBin;
+    for (Event *bin : sortedBins()) {
+        Event *nextInBin = bin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
                 cprintf("time goes backwards!");
@@ -345,21 +376,61 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    if (backend == Backend::Calendar)
+        return calendar.sortedBins();
+
+    std::vector<Event *> bins;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        bins.push_back(bin);
+    return bins;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    numEvents = 0;
+    for (Event *bin = s; bin; bin = bin->nextBin) {
+        for (Event *e = bin; e; e = e->nextInBin)
+            numEvents++;
+    }
+
+    if (backend == Backend::Calendar) {
+        // Hand the events over as the list backend would
+        Event* t = calendar.extract();
+        head = calendar.import(s);
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
 }
 
+void
+EventQueue::setBackend(Backend new_backend)
+{
+    Event *bins = backend == Backend::Calendar ? calendar.extract() : head;
+    backend = new_backend;
+    head = backend == Backend::Calendar ? calendar.import(bins) : bins;
+}
+
+void
+EventQueue::setDefaultBackend(Backend new_backend)
+{
+    defaultBackend = new_backend;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        mainEventQueue[i]->setBackend(new_backend);
+    }
+}
+
 void
 dumpMainQueue()
 {
@@ -415,16 +486,23 @@ Event::dump() const
     }
 }
 
+EventQueue::Backend EventQueue::defaultBackend = EventQueue::Backend::List;
+
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), queueIndex(-1), head(NULL), _curTick(0),
+      backend(defaultBackend), numEvents(0), profile(nullptr)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
+    const EventQueue *source = curEventQueue();
+    const uint32_t source_index = source ? source->queueIndex : -1;
+    const uint64_t seq = asyncSeq++;
+
     async_queue_mutex.lock();
-    async_queue.push_back(event);
+    async_queue.push_back({event, source_index, seq});
     async_queue_mutex.unlock();
 }
 
@@ -434,10 +512,24 @@ EventQueue::handleAsyncInsertions()
     assert(this == curEventQueue());
     async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    // The other threads append in whatever order they happen to run
+    // in. Events in the same bin are serviced in insertion order, so
+    // merge them in an order that only depends on what was scheduled.
+    std::stable_sort(async_queue.begin(), async_queue.end(),
+        [](const AsyncEntry &a, const AsyncEntry &b) {
+            return std::tie(a.source, a.seq) < std::tie(b.source, b.seq);
+        });
+
+    for (const auto &entry : async_queue) {
+        panic_if(entry.event->when() < getCurTick(),
+                 "%s: %s from queue %d scheduled for tick %d, which has "
+                 "passed (now %d). Cross-queue delays must be at least "
+                 "one simulation quantum (%d).", objName,
+                 entry.event->description(), entry.source,
+                 entry.event->when(), getCurTick(), simQuantum);
+        insert(entry.event);
     }
+    async_queue.clear();
 
     async_queue_mutex.unlock();
 }
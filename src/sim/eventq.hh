@@ -38,18 +38,27 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <list>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "base/block_pool.hh"
+#include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/flags.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
 #include "sim/cur_tick.hh"
+#include "sim/eventq_calendar.hh"
+#include "sim/eventq_profiler.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -152,6 +161,16 @@ class EventBase
      */
     static const Priority Debug_Break_Pri =           -100;
 
+    /**
+     * Deliveries from another event queue (e.g., a message crossing
+     * partitions in parallel mode) come before the receiver's own
+     * events at the same tick, so that a consumer woken up at the
+     * arrival tick sees the message just like in a serial run.
+     *
+     * @ingroup api_eventq
+     */
+    static const Priority Remote_Delivery_Pri =        -50;
+
     /**
      * CPU switches schedule the new CPU's tick event for the
      * same cycle (after unscheduling the old CPU's tick event).
@@ -251,6 +270,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -261,7 +281,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion.  With the calendar
+    // backend, the bins are spread over the buckets of an EventCalendar
+    // and 'nextBin' links the bins of a bucket.
     Event *nextBin;
     Event *nextInBin;
 
@@ -618,21 +640,79 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * Local events scheduled on another queue from an event handler take
+ * the same path. handleAsyncInsertions() merges them ordered by the
+ * queue that scheduled them and the order in which it did so, so the
+ * result does not depend on the order in which the threads reached
+ * the queue. As long as every cross-queue delay is at least one
+ * quantum (the lookahead), a parallel run is therefore reproducible.
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure holding the scheduled events. Both service the
+     * events in the same order.
+     */
+    enum class Backend
+    {
+        /** A sorted list of bins, linear insertion. */
+        List,
+        /** A calendar queue of bins, constant amortized insertion. */
+        Calendar
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
+    friend EventQueue *getEventQueue(uint32_t index);
+
+    /** An event scheduled on this queue by another thread. */
+    struct AsyncEntry
+    {
+        Event *event;
+        /** Index of the main event queue that scheduled the event. */
+        uint32_t source;
+        /** Position of the event among those scheduled by its source. */
+        uint64_t seq;
+    };
 
     std::string objName;
+
+    //! Index of this queue in mainEventQueue, or -1 if it is not a
+    //! main event queue.
+    uint32_t queueIndex;
     Event *head;
     Tick _curTick;
 
+    /** Backend used by new event queues. */
+    static Backend defaultBackend;
+
+    /** Backend of this queue. */
+    Backend backend;
+
+    /** Bins of the calendar backend. Unused with the list backend. */
+    EventCalendar calendar;
+
+    /** Number of events in the queue. */
+    std::size_t numEvents;
+
+    /** Profile of this queue, created when it is first needed. */
+    EventProfile *profile;
+
+    EventProfile &
+    getProfile()
+    {
+        if (!profile)
+            profile = EventProfiler::create(objName);
+        return *profile;
+    }
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
     //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    std::vector<AsyncEntry> async_queue;
 
     /**
      * Lock protecting event handling.
@@ -661,6 +741,9 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Get the top of every bin, in the order they will be serviced.
+    std::vector<Event *> sortedBins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -755,6 +838,20 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Change the data structure holding the events of this queue. The
+     * scheduled events are moved to the new one. It must not be called
+     * while an event is being serviced.
+     */
+    void setBackend(Backend new_backend);
+    Backend getBackend() const { return backend; }
+
+    /**
+     * Set the backend of the queues created from now on, and change the
+     * backend of the existing main event queues.
+     */
+    static void setDefaultBackend(Backend new_backend);
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -838,6 +935,9 @@ class EventQueue
 
         if (debug::Event)
             event->trace("rescheduled");
+
+        if (GEM5_UNLIKELY(EventProfiler::enabled()))
+            getProfile().reschedule(event->name());
     }
 
     Tick nextTick() const { return head->when(); }
@@ -908,7 +1008,9 @@ class EventQueue
     bool debugVerify() const;
 
     /**
-     * Function for moving events from the async_queue to the main queue.
+     * Function for moving events from the async_queue to the main
+     * queue. The events are inserted in a deterministic order and must
+     * not be in the past.
      */
     void handleAsyncInsertions();
 
@@ -1155,6 +1257,88 @@ class EventFunctionWrapper : public Event
     const char *description() const { return "EventFunctionWrapped"; }
 };
 
+/**
+ * Base class of events of type T that are allocated with new and
+ * usually deleted by the queue (AutoDelete). Both come from the
+ * BlockPool rather than the heap, which keeps malloc off the
+ * simulation thread for events that are created once per instruction
+ * or message.
+ *
+ * @ingroup api_eventq
+ */
+template <class T>
+class PooledEvent : public Event
+{
+  public:
+    using Event::Event;
+
+    static void *
+    operator new(std::size_t size)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned events cannot be pooled");
+        assert(size == sizeof(T));
+        return BlockPool::allocate(sizeof(T));
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        BlockPool::release(ptr, sizeof(T));
+    }
+};
+
+/**
+ * A pooled event that runs a callback once and then deletes itself.
+ * This replaces a new EventFunctionWrapper with AutoDelete set, but the
+ * callback is stored in the event itself instead of in a
+ * std::function, and the name is not copied, so scheduling one does not
+ * touch the heap.
+ *
+ * @ingroup api_eventq
+ */
+class OneShotEvent : public PooledEvent<OneShotEvent>
+{
+  public:
+    /** Room for the callback: a few pointers and a shared_ptr. */
+    static constexpr std::size_t callbackSize = 48;
+
+  private:
+    alignas(std::max_align_t) unsigned char callback[callbackSize];
+    void (*invoke)(void *);
+    void (*destroy)(void *);
+    const char *_name;
+
+  public:
+    /**
+     * @param cb Function to call, moved into the event.
+     * @param name Name of the event, which must outlive it (a literal).
+     * @param p Priority of the event.
+     */
+    template <typename F>
+    OneShotEvent(F &&cb, const char *name, Priority p = Default_Pri)
+        : PooledEvent<OneShotEvent>(p, AutoDelete), _name(name)
+    {
+        using Callback = std::decay_t<F>;
+        static_assert(sizeof(Callback) <= callbackSize,
+                      "Callback too large for a OneShotEvent");
+        static_assert(alignof(Callback) <= alignof(std::max_align_t),
+                      "Over-aligned callback");
+
+        new (callback) Callback(std::forward<F>(cb));
+        invoke = [](void *c) { (*static_cast<Callback *>(c))(); };
+        destroy = [](void *c) { static_cast<Callback *>(c)->~Callback(); };
+    }
+
+    ~OneShotEvent() { destroy(callback); }
+
+    void process() override { invoke(callback); }
+
+    const std::string name() const override { return _name; }
+
+    const char *description() const override { return "OneShotEvent"; }
+};
+
 /**
  * \def SERIALIZE_EVENT(event)
  *
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An event that records the order in which it is serviced. */
+class RecordingEvent : public Event
+{
+  private:
+    int id;
+    std::vector<int> &log;
+
+  public:
+    RecordingEvent(int _id, std::vector<int> &_log, Priority prio)
+        : Event(prio), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+};
+
+/**
+ * Run the same random sequence of schedules, reschedules, deschedules
+ * and services on a queue, and return the order of the serviced events.
+ * Ticks are drawn from a small range and priorities from a few values, so
+ * that many events share a bin.
+ *
+ * @param backend Backend of the queue.
+ * @param switch_at Operation at which the queue swaps backends, or -1.
+ */
+std::vector<int>
+runSequence(EventQueue::Backend backend, int switch_at = -1)
+{
+    constexpr int num_events = 2000;
+    constexpr int num_ops = 200000;
+
+    EventQueue queue("test_queue");
+    queue.setBackend(backend);
+    EventQueue *const old_queue = curEventQueue();
+    curEventQueue(&queue);
+
+    std::vector<int> log;
+    std::vector<std::unique_ptr<RecordingEvent>> events;
+    for (int i = 0; i < num_events; i++) {
+        const Event::Priority prio = Event::Default_Pri + i % 3 - 1;
+        events.emplace_back(new RecordingEvent(i, log, prio));
+    }
+
+    std::mt19937_64 rng(42);
+    for (int op = 0; op < num_ops; op++) {
+        if (op == switch_at) {
+            queue.setBackend(backend == EventQueue::Backend::List ?
+                EventQueue::Backend::Calendar : EventQueue::Backend::List);
+        }
+        RecordingEvent &event = *events[rng() % num_events];
+        // Mostly near future events, with a few far away ones
+        const Tick delay = rng() % 16 == 0 ? rng() % 1000000 : rng() % 100;
+        const Tick when = queue.getCurTick() + delay;
+        switch (rng() % 4) {
+          case 0:
+            if (!event.scheduled())
+                queue.schedule(&event, when);
+            break;
+          case 1:
+            queue.reschedule(&event, when, true);
+            break;
+          case 2:
+            if (event.scheduled())
+                queue.deschedule(&event);
+            break;
+          default:
+            if (!queue.empty())
+                queue.serviceOne();
+            break;
+        }
+    }
+    while (!queue.empty()) {
+        queue.serviceOne();
+    }
+
+    curEventQueue(old_queue);
+    return log;
+}
+
+/**
+ * Schedule the same events on main queue 0 from queues 1 and 2, with the
+ * two threads' calls interleaved as given, and return the service order.
+ */
+std::vector<int>
+mergeAsync(const std::vector<std::pair<int, uint32_t>> &schedules)
+{
+    EventQueue *const old_queue = curEventQueue();
+    EventQueue *const target = getEventQueue(0);
+    getEventQueue(2);
+
+    std::vector<int> log;
+    std::vector<std::unique_ptr<RecordingEvent>> events;
+    inParallelMode = true;
+    for (const auto &[id, source] : schedules) {
+        events.emplace_back(new RecordingEvent(id, log, Event::Default_Pri));
+        curEventQueue(getEventQueue(source));
+        target->schedule(events.back().get(), target->getCurTick() + 10);
+    }
+
+    curEventQueue(target);
+    target->handleAsyncInsertions();
+    inParallelMode = false;
+    while (!target->empty()) {
+        target->serviceOne();
+    }
+
+    curEventQueue(old_queue);
+    return log;
+}
+
+} // anonymous namespace
+
+/** Both backends service the events in the same order. */
+TEST(EventQueueTest, CalendarOrder)
+{
+    const std::vector<int> list = runSequence(EventQueue::Backend::List);
+    const std::vector<int> calendar =
+        runSequence(EventQueue::Backend::Calendar);
+    ASSERT_FALSE(list.empty());
+    EXPECT_EQ(list, calendar);
+}
+
+/** Changing the backend of a queue keeps its events and their order. */
+TEST(EventQueueTest, SwitchBackend)
+{
+    const std::vector<int> list = runSequence(EventQueue::Backend::List);
+    EXPECT_EQ(list, runSequence(EventQueue::Backend::List, 100000));
+    EXPECT_EQ(list, runSequence(EventQueue::Backend::Calendar, 100000));
+}
+
+/** Events of the same bin are serviced last in, first out. */
+TEST(EventQueueTest, CalendarSameBin)
+{
+    EventQueue queue("test_queue");
+    queue.setBackend(EventQueue::Backend::Calendar);
+    EventQueue *const old_queue = curEventQueue();
+    curEventQueue(&queue);
+
+    std::vector<int> log;
+    RecordingEvent a(0, log, Event::Default_Pri);
+    RecordingEvent b(1, log, Event::Default_Pri);
+    RecordingEvent c(2, log, Event::Default_Pri - 1);
+    queue.schedule(&a, 10);
+    queue.schedule(&b, 10);
+    queue.schedule(&c, 10);
+    while (!queue.empty()) {
+        queue.serviceOne();
+    }
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+
+    curEventQueue(old_queue);
+}
+
+/** Replacing the head hands the events over as a list, and back. */
+TEST(EventQueueTest, CalendarReplaceHead)
+{
+    EventQueue queue("test_queue");
+    queue.setBackend(EventQueue::Backend::Calendar);
+    EventQueue *const old_queue = curEventQueue();
+    curEventQueue(&queue);
+
+    std::vector<int> log;
+    RecordingEvent a(0, log, Event::Default_Pri);
+    RecordingEvent b(1, log, Event::Default_Pri);
+    RecordingEvent c(2, log, Event::Default_Pri);
+    queue.schedule(&a, 30);
+    queue.schedule(&b, 20);
+
+    Event *saved = queue.replaceHead(nullptr);
+    EXPECT_TRUE(queue.empty());
+    queue.schedule(&c, 5);
+    queue.serviceOne();
+
+    queue.replaceHead(saved);
+    while (!queue.empty()) {
+        queue.serviceOne();
+    }
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+
+    curEventQueue(old_queue);
+}
+
+/** Cross-queue events are merged independently of thread timing. */
+TEST(EventQueueTest, AsyncMergeOrder)
+{
+    const auto first = mergeAsync({{0, 2}, {1, 1}, {2, 2}, {3, 1}});
+    const auto second = mergeAsync({{1, 1}, {3, 1}, {0, 2}, {2, 2}});
+    EXPECT_EQ(first, second);
+    // Merged as 1, 3, 0, 2; a bin is serviced last inserted first.
+    EXPECT_EQ(first, std::vector<int>({2, 0, 3, 1}));
+}
+
+/** A one-shot event runs once, drops its captures and is recycled. */
+TEST(EventQueueTest, OneShotEvent)
+{
+    EventQueue queue("test_queue");
+    EventQueue *const old_queue = curEventQueue();
+    curEventQueue(&queue);
+
+    auto token = std::make_shared<int>(0);
+    auto *first = new OneShotEvent([token]() { ++*token; }, "first");
+    EXPECT_EQ(token.use_count(), 2);
+    queue.schedule(first, 10);
+    queue.serviceOne();
+    EXPECT_EQ(*token, 1);
+    EXPECT_EQ(token.use_count(), 1);
+
+    // The block of the first event is the next one handed out
+    auto *second = new OneShotEvent([]() {}, "second");
+    EXPECT_EQ(static_cast<void *>(second), static_cast<void *>(first));
+    queue.schedule(second, 20);
+    queue.serviceOne();
+    EXPECT_TRUE(queue.empty());
+
+    curEventQueue(old_queue);
+}
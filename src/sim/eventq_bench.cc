@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Event queue microbenchmark
+ *
+ * Runs the classic "hold" model on each event queue backend: a fixed
+ * number of events are pending, and every serviced event schedules itself
+ * again a random delay later. It reports the number of events serviced
+ * per second for several numbers of pending events.
+ *
+ *   eventq_bench [pending events ...]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Delays drawn by the events, precomputed to keep them off the clock. */
+std::vector<Tick> delays;
+
+/** An event that schedules itself again when serviced. */
+class HoldEvent : public Event
+{
+  private:
+    EventQueue &queue;
+    std::size_t next;
+
+  public:
+    HoldEvent(EventQueue &_queue, std::size_t seed, Priority prio)
+        : Event(prio), queue(_queue), next(seed)
+    {}
+
+    void
+    process() override
+    {
+        next = (next + 1) % delays.size();
+        queue.schedule(this, queue.getCurTick() + delays[next]);
+    }
+};
+
+/**
+ * Run the hold model on a backend.
+ *
+ * @return Events serviced per second.
+ */
+double
+run(EventQueue::Backend backend, std::size_t pending, uint64_t services)
+{
+    EventQueue queue("bench_queue");
+    queue.setBackend(backend);
+    curEventQueue(&queue);
+
+    std::vector<std::unique_ptr<HoldEvent>> events;
+    for (std::size_t i = 0; i < pending; i++) {
+        // A few priorities, as clocked objects and their helpers use
+        const Event::Priority prio = Event::Default_Pri + i % 4;
+        events.emplace_back(new HoldEvent(queue, i * 7919, prio));
+        queue.schedule(events.back().get(), delays[i % delays.size()]);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < services; i++) {
+        queue.serviceOne();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    while (!queue.empty()) {
+        queue.deschedule(queue.getHead());
+    }
+    curEventQueue(nullptr);
+
+    return services / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; i++) {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 0));
+    }
+    if (sizes.empty()) {
+        sizes = {16, 256, 4096, 65536};
+    }
+
+    // Most delays are short and on a clock edge, as for clocked objects,
+    // with a few long ones, as for timeouts and periodic events
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 1 << 16; i++) {
+        delays.push_back(rng() % 64 == 0 ? 500 * (1 + rng() % 100000) :
+                                           500 * (1 + rng() % 8));
+    }
+
+    constexpr uint64_t services = 2000000;
+    std::printf("%10s %16s %16s\n", "pending", "list (ev/s)",
+                "calendar (ev/s)");
+    for (std::size_t pending : sizes) {
+        if (!pending) {
+            continue;
+        }
+        const double list = run(EventQueue::Backend::List, pending, services);
+        const double calendar =
+            run(EventQueue::Backend::Calendar, pending, services);
+        std::printf("%10zu %16.0f %16.0f\n", pending, list, calendar);
+        std::fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_calendar.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Order the tops of two bins by the time they will be serviced. */
+bool
+binBefore(const Event *l, const Event *r)
+{
+    return *l < *r;
+}
+
+} // anonymous namespace
+
+EventCalendar::EventCalendar()
+    : buckets(minBuckets, nullptr), mask(minBuckets - 1), widthShift(10),
+      numBins(0)
+{
+}
+
+void
+EventCalendar::linkBin(Event *bin)
+{
+    Event **link = &buckets[bucketOf(bin->when())];
+    while (*link && **link < *bin) {
+        link = &(*link)->nextBin;
+    }
+    bin->nextBin = *link;
+    *link = bin;
+}
+
+std::vector<Event *>
+EventCalendar::collectBins() const
+{
+    std::vector<Event *> bins;
+    bins.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin) {
+            bins.push_back(bin);
+        }
+    }
+    return bins;
+}
+
+void
+EventCalendar::resize(std::size_t num_buckets)
+{
+    std::vector<Event *> bins = collectBins();
+
+    // Estimate the width of a bucket from the separation of the earliest
+    // bins, which are the next ones to be serviced. As in Brown's
+    // calendar queue, separations far above the average are ignored and
+    // the width is a few times the average of the remaining ones.
+    const std::size_t samples = std::min(bins.size(), widthSamples);
+    if (samples > 1) {
+        std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                          binBefore);
+        double total = 0;
+        unsigned count = 0;
+        for (std::size_t i = 1; i < samples; i++) {
+            const Tick gap = bins[i]->when() - bins[i - 1]->when();
+            if (gap) {
+                total += gap;
+                count++;
+            }
+        }
+        if (count) {
+            const double limit = 2 * total / count;
+            double kept = 0;
+            unsigned kept_count = 0;
+            for (std::size_t i = 1; i < samples; i++) {
+                const Tick gap = bins[i]->when() - bins[i - 1]->when();
+                if (gap && gap <= limit) {
+                    kept += gap;
+                    kept_count++;
+                }
+            }
+            const double width = 3 * kept / kept_count;
+            widthShift = width < 2 ? 0 :
+                std::min(ceilLog2(static_cast<uint64_t>(width)), 63);
+        }
+    }
+
+    buckets.assign(num_buckets, nullptr);
+    mask = num_buckets - 1;
+    for (Event *bin : bins) {
+        linkBin(bin);
+    }
+}
+
+Event *
+EventCalendar::findMin(Tick from)
+{
+    if (!numBins) {
+        return nullptr;
+    }
+
+    // Look for a bin in the current year of each bucket, starting from
+    // the bucket of the earliest possible time. The first one found is
+    // the earliest, as buckets are sorted.
+    const Tick year = from >> widthShift;
+    for (std::size_t i = 0; i < buckets.size(); i++) {
+        Event *first = buckets[(year + i) & mask];
+        if (first && (first->when() >> widthShift) == year + i) {
+            return first;
+        }
+    }
+
+    // All the bins are at least a year away, which means that the
+    // buckets are too narrow for the current bins. Search directly, and
+    // estimate the width again.
+    Event *min = nullptr;
+    for (Event *first : buckets) {
+        if (first && (!min || *first < *min)) {
+            min = first;
+        }
+    }
+    resize(buckets.size());
+    return min;
+}
+
+Event *
+EventCalendar::insert(Event *event, Event *head)
+{
+    Event *&first = buckets[bucketOf(event->when())];
+    if (!first || *event <= *first) {
+        first = Event::insertBefore(event, first);
+    } else {
+        Event *prev = first;
+        Event *curr = first->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = Event::insertBefore(event, curr);
+    }
+
+    // The event is now the top of its bin; it opened a new bin unless it
+    // was stacked on an existing one
+    if (!event->nextInBin && ++numBins > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+    }
+
+    return !head || *event <= *head ? event : head;
+}
+
+Event *
+EventCalendar::remove(Event *event, Event *head)
+{
+    Event *&first = buckets[bucketOf(event->when())];
+    Event *prev = nullptr;
+    Event *curr = first;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+    }
+
+    if (!curr || *curr != *event)
+        panic("event not found!");
+
+    const bool last_in_bin = event == curr && !event->nextInBin;
+    Event *const top = Event::removeItem(event, curr);
+    if (prev) {
+        prev->nextBin = top;
+    } else {
+        first = top;
+    }
+
+    if (!last_in_bin) {
+        // The bin is still there, possibly with a new top
+        return event == head ? top : head;
+    }
+
+    const bool was_head = event == head;
+    if (--numBins < buckets.size() / 2 && buckets.size() > minBuckets) {
+        resize(buckets.size() / 2);
+    }
+    return was_head ? findMin(event->when()) : head;
+}
+
+Event *
+EventCalendar::extract()
+{
+    std::vector<Event *> bins = collectBins();
+    std::sort(bins.begin(), bins.end(), binBefore);
+
+    Event *next = nullptr;
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        (*it)->nextBin = next;
+        next = *it;
+    }
+
+    std::fill(buckets.begin(), buckets.end(), nullptr);
+    numBins = 0;
+    return next;
+}
+
+Event *
+EventCalendar::import(Event *bins)
+{
+    assert(!numBins);
+
+    Event *const head = bins;
+    while (bins) {
+        Event *const next = bins->nextBin;
+        linkBin(bins);
+        bins = next;
+        if (++numBins > 2 * buckets.size()) {
+            resize(2 * buckets.size());
+        }
+    }
+    return head;
+}
+
+std::vector<Event *>
+EventCalendar::sortedBins() const
+{
+    std::vector<Event *> bins = collectBins();
+    std::sort(bins.begin(), bins.end(), binBefore);
+    return bins;
+}
+
+} // namespace gem5
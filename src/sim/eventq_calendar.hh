@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Calendar queue backend of the event queue
+ */
+
+#ifndef __SIM_EVENTQ_CALENDAR_HH__
+#define __SIM_EVENTQ_CALENDAR_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * A calendar queue of event bins, after R. Brown, "Calendar Queues: A
+ * Fast O(1) Priority Queue Implementation for the Simulation Event Set
+ * Problem", CACM 31(10), 1988.
+ *
+ * The bins are the same as in the list backend of EventQueue: all the
+ * events with the same (when, priority) are kept in a stack linked by
+ * 'nextInBin', whose top represents the bin. Instead of a single list of
+ * bins, the bins are spread over an array of buckets, where bucket i
+ * holds the bins whose time falls in a window of the width of a bucket,
+ * modulo the number of buckets, sorted by 'nextBin' as in the list
+ * backend. Bins are created and stacked by the same code as in the list
+ * backend, so events are serviced in exactly the same order.
+ *
+ * The number of buckets follows the number of bins, and the width of
+ * the buckets is estimated from the separation of the earliest bins
+ * whenever the calendar is resized, so that buckets hold about one bin
+ * and most of the next year's buckets are in use. Inserting and removing
+ * an event then take a constant amortized time.
+ *
+ * The calendar does not know the head of the queue. It is passed the
+ * current head, which is the earliest bin, and returns the new one.
+ */
+class EventCalendar
+{
+  private:
+    /** Smallest number of buckets. */
+    static constexpr std::size_t minBuckets = 16;
+
+    /** Number of bins sampled to estimate the width of a bucket. */
+    static constexpr std::size_t widthSamples = 64;
+
+    /** First bin of each bucket. */
+    std::vector<Event *> buckets;
+
+    /** Number of buckets minus one. */
+    std::size_t mask;
+
+    /** Log2 of the number of ticks covered by a bucket. */
+    unsigned widthShift;
+
+    /** Number of bins in the calendar. */
+    std::size_t numBins;
+
+    std::size_t
+    bucketOf(Tick when) const
+    {
+        return (when >> widthShift) & mask;
+    }
+
+    /**
+     * Link a bin in its bucket. There must not be a bin with the same
+     * time and priority in the calendar.
+     */
+    void linkBin(Event *bin);
+
+    /** Get the top of every bin, in no particular order. */
+    std::vector<Event *> collectBins() const;
+
+    /**
+     * Change the number of buckets, estimate the width of a bucket again,
+     * and spread the bins over the new buckets.
+     */
+    void resize(std::size_t num_buckets);
+
+    /**
+     * Find the earliest bin.
+     *
+     * @param from A time no bin is earlier than.
+     */
+    Event *findMin(Tick from);
+
+  public:
+    EventCalendar();
+
+    /**
+     * Insert an event.
+     *
+     * @param event Event to insert.
+     * @param head Current earliest bin.
+     * @return New earliest bin.
+     */
+    Event *insert(Event *event, Event *head);
+
+    /**
+     * Remove an event.
+     *
+     * @param event Event to remove.
+     * @param head Current earliest bin.
+     * @return New earliest bin, or nullptr if the calendar is empty.
+     */
+    Event *remove(Event *event, Event *head);
+
+    /**
+     * Remove all the bins, and return them as a list sorted by 'nextBin',
+     * the way the list backend keeps them.
+     *
+     * @return The earliest bin, or nullptr if the calendar was empty.
+     */
+    Event *extract();
+
+    /**
+     * Insert a list of bins, sorted by 'nextBin', into an empty calendar.
+     *
+     * @param bins The earliest bin of the list, may be nullptr.
+     * @return New earliest bin.
+     */
+    Event *import(Event *bins);
+
+    /** Get the top of every bin, in the order they will be serviced. */
+    std::vector<Event *> sortedBins() const;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENTQ_CALENDAR_HH__
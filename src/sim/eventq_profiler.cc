@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_profiler.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+std::string outputBasename;
+
+/** Host time when profiling started, to convert host cycles. */
+uint64_t startCycles;
+std::chrono::steady_clock::time_point startTime;
+
+} // anonymous namespace
+
+void
+EventProfiler::enable(const std::string &basename)
+{
+    fatal_if(_enabled, "The event profiler is already enabled");
+
+    outputBasename = basename;
+    startCycles = hostCycles();
+    startTime = std::chrono::steady_clock::now();
+    _enabled = true;
+
+    statistics::registerDumpCallback([]() { dump(); });
+    registerExitCallback([]() { dump(); });
+}
+
+void
+EventProfiler::dump()
+{
+    std::lock_guard<std::mutex> lock(profilesMutex);
+
+    // Merge the queues
+    std::unordered_map<std::string, EventProfile::Entry> merged;
+    std::array<uint64_t, 64> depths{};
+    std::size_t max_depth = 0;
+    EventProfile::Entry total;
+    for (const auto &profile : profiles) {
+        for (const auto &[name, entry] : profile->entries) {
+            EventProfile::Entry &dst = merged[name];
+            dst.calls += entry.calls;
+            dst.hostCycles += entry.hostCycles;
+            dst.reschedules += entry.reschedules;
+            total.calls += entry.calls;
+            total.hostCycles += entry.hostCycles;
+            total.reschedules += entry.reschedules;
+        }
+        for (std::size_t i = 0; i < depths.size(); i++)
+            depths[i] += profile->depths[i];
+        max_depth = std::max(max_depth, profile->maxDepth);
+    }
+
+    // Calibrate the host cycles against the wall clock
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count();
+    const uint64_t elapsed_cycles = hostCycles() - startCycles;
+    const double seconds_per_cycle =
+        elapsed_cycles ? elapsed / elapsed_cycles : 0.0;
+
+    using Item = std::pair<std::string, EventProfile::Entry>;
+    std::vector<Item> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(),
+        [](const Item &a, const Item &b) {
+            return a.second.hostCycles > b.second.hostCycles ||
+                (a.second.hostCycles == b.second.hostCycles &&
+                 a.first < b.first);
+        });
+
+    OutputStream *report = simout.create(outputBasename + ".txt");
+    std::ostream &out = *report->stream();
+    const double total_seconds = total.hostCycles * seconds_per_cycle;
+    ccprintf(out, "# %d events serviced by %d queues, %.6f s of %.6f s "
+             "host time in process()\n", total.calls, profiles.size(),
+             total_seconds, elapsed);
+    ccprintf(out, "%12s %7s %14s %10s %12s  %s\n", "host_s", "host_%",
+             "calls", "ns/call", "reschedules", "name");
+    for (const auto &[name, entry] : sorted) {
+        const double seconds = entry.hostCycles * seconds_per_cycle;
+        ccprintf(out, "%12.6f %6.2f%% %14d %10.1f %12d  %s\n", seconds,
+                 total_seconds > 0 ? 100 * seconds / total_seconds : 0.0,
+                 entry.calls,
+                 entry.calls ? 1e9 * seconds / entry.calls : 0.0,
+                 entry.reschedules, name);
+    }
+
+    ccprintf(out, "\n# Events in the queue when servicing one, max %d\n",
+             max_depth);
+    ccprintf(out, "%21s %14s\n", "depth", "services");
+    for (std::size_t i = 0; i < depths.size(); i++) {
+        if (depths[i]) {
+            const uint64_t low = (uint64_t(1) << i) - 1;
+            ccprintf(out, "%10d-%-10d %14d\n", low, 2 * low, depths[i]);
+        }
+    }
+    simout.close(report);
+
+    // Collapsed stacks, one frame per component of the event name, in
+    // nanoseconds
+    OutputStream *folded = simout.create(outputBasename + ".folded");
+    for (const auto &[name, entry] : sorted) {
+        const uint64_t ns = entry.hostCycles * seconds_per_cycle * 1e9;
+        if (!ns)
+            continue;
+        std::string stack = name;
+        std::replace(stack.begin(), stack.end(), '.', ';');
+        std::replace(stack.begin(), stack.end(), ' ', '_');
+        ccprintf(*folded->stream(), "%s %d\n", stack, ns);
+    }
+    simout.close(folded);
+}
+
+} // namespace gem5
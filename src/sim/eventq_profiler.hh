@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Host-time profiler of the events serviced by the event queues
+ */
+
+#ifndef __SIM_EVENTQ_PROFILER_HH__
+#define __SIM_EVENTQ_PROFILER_HH__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+/**
+ * What one event queue has serviced since profiling was enabled. It is
+ * only updated by the thread servicing the queue.
+ */
+class EventProfile
+{
+  public:
+    /** Totals of all the events sharing a name. */
+    struct Entry
+    {
+        uint64_t calls = 0;
+        /** Host time spent in process(), in EventProfiler::hostCycles(). */
+        uint64_t hostCycles = 0;
+        uint64_t reschedules = 0;
+    };
+
+    /** Name of the queue. */
+    const std::string queueName;
+
+    /** Entries by event name. */
+    std::unordered_map<std::string, Entry> entries;
+
+    /**
+     * Number of events serviced with a queue depth d, in bucket
+     * floor(log2(d + 1)).
+     */
+    std::array<uint64_t, 64> depths{};
+    std::size_t maxDepth = 0;
+
+    EventProfile(const std::string &queue_name) : queueName(queue_name) {}
+
+    /**
+     * Account for an event about to be serviced.
+     *
+     * @param name Name of the event.
+     * @param depth Number of events in the queue, including this one.
+     * @return The entry to add the service time to.
+     */
+    Entry &
+    service(const std::string &name, std::size_t depth)
+    {
+        depths[floorLog2(depth + 1)]++;
+        maxDepth = std::max(maxDepth, depth);
+
+        Entry &entry = entries[name];
+        entry.calls++;
+        return entry;
+    }
+
+    /** Account for an event being rescheduled. */
+    void reschedule(const std::string &name) { entries[name].reschedules++; }
+};
+
+/**
+ * Optional instrumentation of EventQueue::serviceOne(). While enabled,
+ * each queue keeps an EventProfile, and the merged profiles are written
+ * to the output directory at every statistics dump and at exit: a report
+ * of the event names sorted by host time, and the same data as collapsed
+ * stacks (one frame per component of the name) for flame graph tools.
+ * When disabled, the cost is a predictable branch per serviced event.
+ */
+class EventProfiler
+{
+  private:
+    static inline bool _enabled = false;
+
+    static inline std::mutex profilesMutex;
+    static inline std::vector<std::unique_ptr<EventProfile>> profiles;
+
+  public:
+    static bool enabled() { return _enabled; }
+
+    /**
+     * Start profiling all event queues.
+     *
+     * @param basename Output files are basename.txt and basename.folded.
+     */
+    static void enable(const std::string &basename);
+
+    /** Create the profile of a queue; called by the queue itself. */
+    static EventProfile *
+    create(const std::string &queue_name)
+    {
+        std::lock_guard<std::mutex> lock(profilesMutex);
+        profiles.emplace_back(new EventProfile(queue_name));
+        return profiles.back().get();
+    }
+
+    /** Write the output files. Not thread safe. */
+    static void dump();
+
+    /** Cheap, monotonic host time stamp, TSC cycles on x86. */
+    static uint64_t
+    hostCycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENTQ_PROFILER_HH__
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sim/eventq_profiler.hh"
+
+using namespace gem5;
+
+/** Services are counted per name, with the depth in log2 buckets. */
+TEST(EventProfileTest, Service)
+{
+    EventProfile profile("test_queue");
+
+    profile.service("a", 1).hostCycles += 10;
+    profile.service("a", 2).hostCycles += 5;
+    profile.service("b", 7);
+    profile.reschedule("b");
+    profile.reschedule("c");
+
+    EXPECT_EQ(profile.entries.size(), 3u);
+    EXPECT_EQ(profile.entries["a"].calls, 2u);
+    EXPECT_EQ(profile.entries["a"].hostCycles, 15u);
+    EXPECT_EQ(profile.entries["b"].calls, 1u);
+    EXPECT_EQ(profile.entries["b"].reschedules, 1u);
+    EXPECT_EQ(profile.entries["c"].calls, 0u);
+
+    // Depths 1 and 2 fall in [1, 2], depth 7 in [7, 14]
+    EXPECT_EQ(profile.depths[1], 2u);
+    EXPECT_EQ(profile.depths[3], 1u);
+    EXPECT_EQ(profile.maxDepth, 7u);
+}
@@ -251,17 +251,20 @@ class System : public SimObject, public PCEventScope
     /**
      * Is the system in atomic mode?
      *
-     * There are currently two different atomic memory modes:
-     * 'atomic', which supports caches; and 'atomic_noncaching', which
-     * bypasses caches. The latter is used by hardware virtualized
-     * CPUs. SimObjects are expected to use Port::sendAtomic() and
-     * Port::recvAtomic() when accessing memory in this mode.
+     * There are currently three different atomic memory modes:
+     * 'atomic', which supports caches; 'atomic_noncaching', which
+     * bypasses caches; and 'atomic_warmup', which only updates the
+     * cache tags (see warmsUpCaches()). 'atomic_noncaching' is used by
+     * hardware virtualized CPUs. SimObjects are expected to use
+     * Port::sendAtomic() and Port::recvAtomic() when accessing memory
+     * in this mode.
      */
     bool
     isAtomicMode() const
     {
         return memoryMode == enums::atomic ||
-            memoryMode == enums::atomic_noncaching;
+            memoryMode == enums::atomic_noncaching ||
+            memoryMode == enums::atomic_warmup;
     }
 
     /**
@@ -283,6 +286,20 @@ class System : public SimObject, public PCEventScope
     {
         return memoryMode == enums::atomic_noncaching;
     }
+
+    /**
+     * Are caches being warmed up?
+     *
+     * In this atomic mode caches only update their tags, replacement
+     * state and prefetcher training, while the data is read from and
+     * written to memory directly. It is used to cheaply warm up the
+     * caches while fast-forwarding.
+     */
+    bool
+    warmsUpCaches() const
+    {
+        return memoryMode == enums::atomic_warmup;
+    }
     /** @} */
 
     /** @{ */
@@ -291,7 +308,8 @@ class System : public SimObject, public PCEventScope
      *
      * \warn This should only be used by the Python world. The C++
      * world should use one of the query functions above
-     * (isAtomicMode(), isTimingMode(), bypassCaches()).
+     * (isAtomicMode(), isTimingMode(), bypassCaches(),
+     * warmsUpCaches()).
      */
     enums::MemoryMode getMemoryMode() const { return memoryMode; }
 